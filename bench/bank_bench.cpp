@@ -0,0 +1,627 @@
+// File: bank_bench.cpp
+// Purpose: Microbenchmarks for the public Bank operations. For every requested size N
+// the bench builds a bank with N accounts (N/2 customers, each with a savings and a
+// checking account) and N deposits (--ledger to change), then times each operation one
+// call at a time.
+// It reports ns/op, ops/s, latency percentiles and heap bytes and allocations per op,
+// as a table or as JSON. Allocations are counted by replacing the global operator new
+// and delete in this executable; nothing here needs a network or a display.
+//
+// Cheap operations run --ops times. Operations that scan the whole ledger run until
+// they have visited about kScanBudget records, but at least kMinScanIterations times.
+// performTransfer.threads<n> runs the transfer loop on 1, 2, 4, ... --threads threads
+// at once, splitting the calls between them; its ops/s is the bank's throughput.
+// The *.fixedAccount cases read one account that holds kProbePostings of the seed
+// deposits however large the ledger is; "--sizes 100000 --ledger 20000000" shows
+// whether their cost stays flat as the ledger grows past 10M records.
+// The journaled cases come last: each switches the bank to a fresh journal in --out-dir
+// with one JournalSyncMode, and runs at most kJournaledIterations times.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bank.hh"
+#include "BatchOperation.hh"
+#include "Customer.hh"
+#include "Journal.hh"
+#include "LatencyHistogram.hh"
+#include "Logger.hh"
+#include "TransactionQuery.hh"
+
+// --- Allocation Counting ---
+// Every operator new in the process goes through these, including the ones in
+// minibank_core. The counters are per thread, so the difference across a measurement
+// loop only covers the measuring thread: the Logger and Journal background threads
+// (and the workers of parallel operations) allocate too, but are not counted.
+namespace {
+
+thread_local std::uint64_t tAllocatedBytes = 0;
+thread_local std::uint64_t tAllocations = 0;
+
+void* countedAlloc(std::size_t size) {
+    tAllocatedBytes += size;
+    ++tAllocations;
+    return std::malloc(size ? size : 1);
+}
+
+void* countedAlignedAlloc(std::size_t size, std::size_t alignment) {
+    tAllocatedBytes += size;
+    ++tAllocations;
+    // aligned_alloc wants a multiple of the alignment.
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace banking_system {
+namespace bench {
+
+constexpr std::size_t kScanBudget = 10000000; // Records visited per scanning benchmark
+constexpr std::size_t kMinScanIterations = 5;
+constexpr std::size_t kProbePostings = 100;
+constexpr std::size_t kJournaledIterations = 10000; // Per-operation fsyncs are slow
+
+struct Options {
+    std::vector<std::size_t> sizes{1000, 10000, 100000, 1000000};
+    std::size_t ledger = 0; // Seed deposits per bank; 0: one per account
+    std::size_t ops = 100000;
+    std::string filter;
+    std::string jsonPath; // Empty: table only; "-": JSON on stdout, table on stderr
+    std::string outDir;   // Report files; defaults to the system temp directory
+    std::uint64_t seed = 42;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency()); // Most threads swept
+};
+
+struct Result {
+    std::string name;
+    std::size_t size = 0;
+    std::size_t ledger = 0;
+    std::size_t iterations = 0;
+    double wallSeconds = 0.0;
+    LatencyHistogram latency;
+    std::uint64_t bytes = 0;
+    std::uint64_t allocations = 0;
+
+    double nsPerOp() const { return latency.getMean(); }
+    double opsPerSecond() const { return wallSeconds > 0 ? static_cast<double>(iterations) / wallSeconds : 0.0; }
+};
+
+// Keeps results of side-effect-free calls alive so the loop is not optimized away.
+volatile std::uintptr_t gSink = 0;
+
+template <typename T>
+void keep(const T& value) {
+    gSink = gSink + static_cast<std::uintptr_t>(value);
+}
+
+// Cost of the two clock reads around every timed call, for reading small ns/op values.
+double timerOverheadNanos() {
+    constexpr int kSamples = 100000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSamples; ++i) {
+        keep(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kSamples;
+}
+
+// --- Fixture ---
+// A bank of size accounts and ledger deposits, plus the names and IDs the benchmarks
+// draw from. Random choices are made up front so the timed loops only call the Bank.
+class Fixture {
+public:
+    Fixture(std::size_t size, std::size_t ledger, std::uint64_t seed);
+
+    Bank bank;
+    std::vector<std::string> customerNames;
+    std::vector<AccountId> checkingIds;
+    std::vector<AccountId> savingsIds; // Same customer as checkingIds[i]; unfunded until accrueInterest.posting
+    std::vector<AccountId> accountIds; // Savings and checking
+    std::vector<std::uint32_t> picks;  // Uniform random indexes into customerNames
+    AccountId probeId;                 // Holds kProbePostings of the seed deposits
+};
+
+Fixture::Fixture(std::size_t size, std::size_t ledger, std::uint64_t seed) {
+    const std::size_t customers = std::max<std::size_t>(1, size / 2);
+    customerNames.reserve(customers);
+    checkingIds.reserve(customers);
+    savingsIds.reserve(customers);
+    accountIds.reserve(customers * 2);
+    char name[32];
+    for (std::size_t i = 0; i < customers; ++i) {
+        std::snprintf(name, sizeof(name), "customer%09zu", i);
+        customerNames.emplace_back(name);
+    }
+    const std::vector<Customer*> registered = bank.registerCustomers(customerNames);
+    for (std::size_t i = 0; i < customers; ++i) {
+        if (!registered[i]) throw std::runtime_error("Fixture could not register " + customerNames[i] + ".");
+        for (AccountId id : registered[i]->getAccountIds()) {
+            accountIds.push_back(id);
+            (bank.findAccount(id)->getType() == AccountType::CHECKING ? checkingIds : savingsIds).push_back(id);
+        }
+    }
+
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<std::uint32_t> customerDist(0, static_cast<std::uint32_t>(customers - 1));
+    picks.resize(std::max<std::size_t>(size, 1) * 2);
+    for (std::uint32_t& pick : picks) pick = customerDist(random);
+
+    // Large enough that the withdraw and transfer benchmarks never run an account dry.
+    // The probe's deposits are spread evenly over the seeding; the rest go elsewhere.
+    const Money seedAmount = Money::fromCents(1000000);
+    probeId = checkingIds[0];
+    const std::size_t probeStride = std::max<std::size_t>(1, ledger / kProbePostings);
+    const std::size_t others = std::max<std::size_t>(1, checkingIds.size() - 1);
+    std::size_t probePostings = 0;
+    for (std::size_t i = 0; i < ledger; ++i) {
+        const bool probe = (i % probeStride == 0 && probePostings < kProbePostings) || checkingIds.size() == 1;
+        if (probe) ++probePostings;
+        const AccountId id = probe ? probeId : checkingIds[1 + picks[i % picks.size()] % others];
+        bank.performDeposit(id, seedAmount, "seed");
+    }
+}
+
+// --- Measurement ---
+// Calls op(i) for i in [0, iterations), timing each call, after a short untimed
+// warm-up on indexes past the timed range. With several threads each takes an equal
+// run of the indexes; the wall time covers all of them.
+Result measure(const std::string& name, std::size_t size, std::size_t iterations, unsigned threads,
+               const std::function<void(std::size_t)>& op) {
+    const std::size_t warmup = std::min<std::size_t>(iterations / 10, 1000);
+    for (std::size_t i = 0; i < warmup; ++i) op(iterations + i);
+
+    struct Share {
+        LatencyHistogram latency;
+        std::uint64_t bytes = 0;
+        std::uint64_t allocations = 0;
+    };
+    std::vector<Share> shares(threads);
+    auto work = [&](unsigned t) {
+        Share& share = shares[t];
+        const std::uint64_t bytesBefore = tAllocatedBytes;
+        const std::uint64_t allocationsBefore = tAllocations;
+        const std::size_t end = iterations * (t + 1) / threads;
+        for (std::size_t i = iterations * t / threads; i < end; ++i) {
+            const auto begin = std::chrono::steady_clock::now();
+            op(i);
+            const auto finish = std::chrono::steady_clock::now();
+            share.latency.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(finish - begin).count()));
+        }
+        share.bytes = tAllocatedBytes - bytesBefore;
+        share.allocations = tAllocations - allocationsBefore;
+    };
+
+    Result result;
+    result.name = name;
+    result.size = size;
+    result.iterations = iterations;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) workers.emplace_back(work, t);
+    work(0);
+    for (std::thread& worker : workers) worker.join();
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const Share& share : shares) {
+        result.latency.merge(share.latency);
+        result.bytes += share.bytes;
+        result.allocations += share.allocations;
+    }
+    return result;
+}
+
+struct Benchmark {
+    std::string name;
+    bool scansLedger; // Cost grows with the size, so it runs fewer iterations
+    std::function<void(Fixture&, std::size_t)> op;
+    std::size_t batchSize = 1; // Items per call; the call runs --ops / batchSize times
+    std::function<void(Fixture&)> setup; // Untimed, before the warm-up
+    std::size_t maxIterations = 0;       // 0: no limit beyond the above
+    unsigned threads = 1;                // Threads sharing the calls
+};
+
+// In run order: reads first, so they see exactly the fixture's size, then the
+// operations that grow the ledger and the registry, then the journaled ones, which
+// leave the bank journaled.
+std::vector<Benchmark> makeBenchmarks(const std::string& outDir, unsigned maxThreads) {
+    const std::string accountReport = outDir + "/bank_bench_account.txt";
+    const std::string customerReport = outDir + "/bank_bench_customer.txt";
+    const std::string globalReport = outDir + "/bank_bench_global.txt";
+    const std::string journalPath = outDir + "/bank_bench.journal";
+    auto customer = [](Fixture& f, std::size_t i) -> const std::string& {
+        return f.customerNames[f.picks[i % f.picks.size()]];
+    };
+    auto account = [](Fixture& f, std::size_t i) {
+        return f.accountIds[(f.picks[i % f.picks.size()] * 2 + i) % f.accountIds.size()];
+    };
+    auto checking = [](Fixture& f, std::size_t i) {
+        return f.checkingIds[f.picks[i % f.picks.size()] % f.checkingIds.size()];
+    };
+    auto transfer = [=](Fixture& f, std::size_t i) {
+        const AccountId source = checking(f, i);
+        AccountId destination = checking(f, i + 1);
+        if (destination == source) destination = f.checkingIds[0] == source ? f.checkingIds.back() : f.checkingIds[0];
+        keep(f.bank.performTransfer(source, destination, Money::fromCents(1)).has_value());
+    };
+    // 1000 deposits to random checking accounts, shared by the batch cases and the
+    // per-call loop they are compared with.
+    auto legs = std::make_shared<std::vector<BatchOperation>>();
+    auto makeLegs = [=](Fixture& f) {
+        legs->clear();
+        for (std::size_t n = 0; n < 1000; ++n) legs->push_back(BatchOperation::deposit(checking(f, n), Money::fromCents(100)));
+    };
+    auto interest = std::make_shared<const InterestEngine>(
+        InterestSchedule({{Money::zero(), 15000}, {Money::fromCents(1000000), 22500}}));
+    auto journal = [=](JournalSyncMode mode) {
+        return [=](Fixture& f) {
+            std::filesystem::remove(journalPath);
+            JournalOptions options;
+            options.syncMode = mode;
+            f.bank.enableJournal(journalPath, options);
+        };
+    };
+
+    std::vector<Benchmark> benchmarks = {
+        {"findCustomer", false, [=](Fixture& f, std::size_t i) {
+            keep(reinterpret_cast<std::uintptr_t>(f.bank.findCustomer(customer(f, i))));
+        }},
+        {"findAccount", false, [=](Fixture& f, std::size_t i) {
+            keep(reinterpret_cast<std::uintptr_t>(f.bank.findAccount(account(f, i))));
+        }},
+        {"getCustomerAccounts", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.getCustomerAccounts(customer(f, i)).size());
+        }},
+        {"suggestCustomers.prefix", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.suggestCustomers(customer(f, i).substr(0, 14), 10).size());
+        }},
+        {"suggestCustomers.typo", false, [=](Fixture& f, std::size_t i) {
+            std::string text = customer(f, i).substr(0, 14);
+            std::swap(text[10], text[11]);
+            keep(f.bank.suggestCustomers(text, 10).size());
+        }},
+        {"suggestAccounts.prefix", false, [=](Fixture& f, std::size_t i) {
+            char text[AccountId::kTextLength];
+            account(f, i).format(text);
+            keep(f.bank.suggestAccounts(std::string(text, 12), 10).size());
+        }},
+        {"getTotalBalance", false, [](Fixture& f, std::size_t) {
+            keep(f.bank.getTotalBalance().getCents());
+        }},
+        {"getAccountTransactionsChronological", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.getAccountTransactionsChronological(checking(f, i)).size());
+        }},
+        {"getCustomerTransactionsChronological", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.getCustomerTransactionsChronological(customer(f, i)).size());
+        }},
+        {"getAllTransactionsChronological", true, [](Fixture& f, std::size_t) {
+            keep(f.bank.getAllTransactionsChronological().size());
+        }},
+        {"queryTransactions.newestPage", false, [](Fixture& f, std::size_t) {
+            const Transaction* page[50];
+            TransactionCursor cursor = f.bank.queryTransactions(TransactionQuery::all().newestFirst().page(0, 50));
+            keep(cursor.next(page, 50));
+        }},
+        {"queryTransactions.account", false, [=](Fixture& f, std::size_t i) {
+            const Transaction* page[64];
+            TransactionCursor cursor = f.bank.queryTransactions(TransactionQuery::forAccount(checking(f, i)));
+            std::size_t read;
+            while ((read = cursor.next(page, 64)) > 0) keep(read);
+        }},
+        {"getAccountTransactionsChronological.fixedAccount", false, [](Fixture& f, std::size_t) {
+            keep(f.bank.getAccountTransactionsChronological(f.probeId).size());
+        }},
+        {"queryTransactions.fixedAccount", false, [](Fixture& f, std::size_t) {
+            const Transaction* page[64];
+            TransactionCursor cursor = f.bank.queryTransactions(TransactionQuery::forAccount(f.probeId));
+            std::size_t read;
+            while ((read = cursor.next(page, 64)) > 0) keep(read);
+        }},
+        {"generateAccountReport", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.generateAccountReport(checking(f, i), accountReport));
+        }},
+        {"generateCustomerReport", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.generateCustomerReport(customer(f, i), customerReport));
+        }},
+        {"generateGlobalReport", true, [=](Fixture& f, std::size_t) {
+            keep(f.bank.generateGlobalReport(globalReport));
+        }},
+        {"performDeposit", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.performDeposit(checking(f, i), Money::fromCents(100)).has_value());
+        }},
+        {"performWithdraw", false, [=](Fixture& f, std::size_t i) {
+            keep(f.bank.performWithdraw(checking(f, i), Money::fromCents(1)).has_value());
+        }},
+        {"performTransfer", false, transfer},
+    };
+    // Uniform transfers between random checking accounts, so threads rarely share a stripe.
+    for (unsigned threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        benchmarks.push_back({"performTransfer.threads" + std::to_string(threads), false, transfer, 1, {}, 0, threads});
+        if (threads == maxThreads) break;
+    }
+    benchmarks.insert(benchmarks.end(), {
+        {"performDeposit.loop1000", false, [=](Fixture& f, std::size_t) {
+            for (const BatchOperation& leg : *legs) {
+                keep(f.bank.performDeposit(leg.destinationAccountId, leg.amount).has_value());
+            }
+        }, 1000, makeLegs},
+        {"executeBatch.allOrNothing1000", false, [=](Fixture& f, std::size_t) {
+            keep(f.bank.executeBatch(*legs, BatchMode::ALL_OR_NOTHING).size());
+        }, 1000, makeLegs},
+        {"executeBatch.bestEffort1000", false, [=](Fixture& f, std::size_t) {
+            keep(f.bank.executeBatch(*legs, BatchMode::BEST_EFFORT).size());
+        }, 1000, makeLegs},
+        {"accrueInterest", true, [=](Fixture& f, std::size_t) {
+            // The fixture funds only checking accounts, so this times the accrual pass
+            // over the whole balance column; nothing is posted.
+            keep(f.bank.accrueInterest(*interest).accountsCredited);
+        }},
+        {"accrueInterest.posting", true, [=](Fixture& f, std::size_t) {
+            // Every savings account earns interest, so each call posts one record per
+            // customer; the cap keeps the ledger from growing without bound.
+            keep(f.bank.accrueInterest(*interest).accountsCredited);
+        }, 1, [](Fixture& f) {
+            // Deposits only reach checking accounts, so savings are funded by transfer
+            // from the same customer's checking account.
+            const Money amount = Money::fromCents(1000000);
+            for (std::size_t i = 0; i < f.savingsIds.size(); ++i) {
+                f.bank.performDeposit(f.checkingIds[i], amount, "savings");
+                f.bank.performTransfer(f.checkingIds[i], f.savingsIds[i], amount, "savings");
+            }
+        }, kMinScanIterations},
+        {"registerCustomer", false, [](Fixture& f, std::size_t i) {
+            // The name fits std::string's inline buffer, so building it allocates nothing.
+            char name[32];
+            std::snprintf(name, sizeof(name), "new%zu_%zu", f.customerNames.size(), i);
+            keep(reinterpret_cast<std::uintptr_t>(f.bank.registerCustomer(name)));
+        }},
+        {"registerCustomers.batch1000", false, [](Fixture& f, std::size_t i) {
+            // Building the names costs a few percent of registering them.
+            static std::vector<std::string> names(1000);
+            for (std::size_t n = 0; n < names.size(); ++n) {
+                names[n] = "bulk" + std::to_string(i) + "_" + std::to_string(n);
+            }
+            keep(f.bank.registerCustomers(names).size());
+        }, 1000},
+        {"performTransfer.journal.perOperation", false, transfer, 1,
+         journal(JournalSyncMode::PER_OPERATION), kJournaledIterations},
+        {"performTransfer.journal.group", false, transfer, 1,
+         journal(JournalSyncMode::GROUP), kJournaledIterations},
+        {"performTransfer.journal.async", false, transfer, 1,
+         journal(JournalSyncMode::ASYNC), kJournaledIterations},
+    });
+    return benchmarks;
+}
+
+// --- Output ---
+void printTableHeader(std::FILE* out) {
+    std::fprintf(out, "%-50s %9s %9s %9s %11s %12s %9s %9s %9s %10s %10s %9s\n", "benchmark", "size", "ledger", "iters",
+                 "ns/op", "ops/s", "p50 ns", "p99 ns", "p99.9 ns", "max ns", "bytes/op", "allocs/op");
+}
+
+void printTableRow(std::FILE* out, const Result& r) {
+    const double iterations = static_cast<double>(r.iterations);
+    std::fprintf(out, "%-50s %9zu %9zu %9zu %11.1f %12.0f %9llu %9llu %9llu %10llu %10.1f %9.2f\n", r.name.c_str(),
+                 r.size, r.ledger, r.iterations, r.nsPerOp(), r.opsPerSecond(),
+                 static_cast<unsigned long long>(r.latency.getPercentile(50)),
+                 static_cast<unsigned long long>(r.latency.getPercentile(99)),
+                 static_cast<unsigned long long>(r.latency.getPercentile(99.9)),
+                 static_cast<unsigned long long>(r.latency.getMax()),
+                 static_cast<double>(r.bytes) / iterations, static_cast<double>(r.allocations) / iterations);
+    std::fflush(out);
+}
+
+// Benchmark names are identifiers and the context strings come from the compiler,
+// so nothing written here needs escaping beyond quotes and backslashes.
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void writeJson(std::ostream& out, const Options& options, double timerOverhead, const std::vector<Result>& results) {
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+#if defined(__VERSION__)
+    const std::string compiler = __VERSION__;
+#else
+    const std::string compiler = "unknown";
+#endif
+#if defined(NDEBUG)
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": " << jsonString(date) << ",\n"
+        << "    \"compiler\": " << jsonString(compiler) << ",\n"
+        << "    \"build\": " << jsonString(build) << ",\n"
+        << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"timer_overhead_ns\": " << timerOverhead << ",\n"
+        << "    \"ops\": " << options.ops << ",\n"
+        << "    \"seed\": " << options.seed << "\n"
+        << "  },\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        const double iterations = static_cast<double>(r.iterations);
+        out << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(r.name)
+            << ", \"size\": " << r.size
+            << ", \"ledger\": " << r.ledger
+            << ", \"iterations\": " << r.iterations
+            << ", \"ns_per_op\": " << r.nsPerOp()
+            << ", \"ops_per_sec\": " << r.opsPerSecond()
+            << ", \"min_ns\": " << r.latency.getMin()
+            << ", \"p50_ns\": " << r.latency.getPercentile(50)
+            << ", \"p90_ns\": " << r.latency.getPercentile(90)
+            << ", \"p99_ns\": " << r.latency.getPercentile(99)
+            << ", \"p999_ns\": " << r.latency.getPercentile(99.9)
+            << ", \"max_ns\": " << r.latency.getMax()
+            << ", \"bytes_per_op\": " << static_cast<double>(r.bytes) / iterations
+            << ", \"allocs_per_op\": " << static_cast<double>(r.allocations) / iterations << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// --- Entry Point ---
+void printUsage() {
+    std::fprintf(stderr,
+        "Usage: bank_bench [options]\n"
+        "Times every public Bank operation on banks of each size.\n"
+        "  --sizes <n,n,...>        Accounts (and seed deposits) per bank (default 1000,10000,100000,1000000)\n"
+        "  --ledger <n>             Seed deposits per bank (default: one per account)\n"
+        "  --ops <n>                Timed calls per cheap operation (default 100000)\n"
+        "  --filter <text>          Run only benchmarks whose name contains text\n"
+        "  --json <path>            Also write results as JSON to path; '-' for stdout\n"
+        "  --out-dir <dir>          Directory for the report files (default: system temp)\n"
+        "  --seed <n>               Random seed for the fixture (default 42)\n"
+        "  --threads <n>            Most threads in the performTransfer.threads sweep (default: hardware threads)\n");
+}
+
+bool parseSizes(const std::string& text, std::vector<std::size_t>& sizes) {
+    sizes.clear();
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        char* end = nullptr;
+        const unsigned long long value = std::strtoull(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || value < 2) return false;
+        sizes.push_back(static_cast<std::size_t>(value));
+    }
+    return !sizes.empty();
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value || arg == "--help" || arg == "-h") return false;
+        ++i;
+        if (arg == "--sizes") {
+            if (!parseSizes(value, options.sizes)) return false;
+        } else if (arg == "--ledger") {
+            options.ledger = static_cast<std::size_t>(std::strtoull(value, nullptr, 10));
+            if (options.ledger == 0) return false;
+        } else if (arg == "--ops") {
+            options.ops = static_cast<std::size_t>(std::strtoull(value, nullptr, 10));
+            if (options.ops == 0) return false;
+        } else if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--json") {
+            options.jsonPath = value;
+        } else if (arg == "--out-dir") {
+            options.outDir = value;
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--threads") {
+            options.threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            if (options.threads == 0) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int run(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    if (options.outDir.empty()) options.outDir = std::filesystem::temp_directory_path().string();
+    Logger::instance().setLevel(LogLevel::OFF);
+
+    std::FILE* table = (options.jsonPath == "-") ? stderr : stdout;
+    const double timerOverhead = timerOverheadNanos();
+    std::fprintf(table, "timer overhead %.1f ns per call (included in ns/op and percentiles)\n", timerOverhead);
+    printTableHeader(table);
+
+    const std::vector<Benchmark> benchmarks = makeBenchmarks(options.outDir, options.threads);
+    std::vector<Result> results;
+    for (std::size_t size : options.sizes) {
+        const std::size_t ledger = options.ledger ? options.ledger : size;
+        Fixture fixture(size, ledger, options.seed);
+        for (const Benchmark& benchmark : benchmarks) {
+            if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) continue;
+            std::size_t iterations = benchmark.scansLedger
+                ? std::min(options.ops, std::max(kMinScanIterations, kScanBudget / ledger))
+                : std::max(kMinScanIterations, options.ops / benchmark.batchSize);
+            if (benchmark.maxIterations != 0) iterations = std::min(iterations, benchmark.maxIterations);
+            if (benchmark.setup) benchmark.setup(fixture);
+            results.push_back(measure(benchmark.name, size, iterations, benchmark.threads,
+                                      [&](std::size_t i) { benchmark.op(fixture, i); }));
+            results.back().ledger = ledger;
+            printTableRow(table, results.back());
+        }
+    }
+
+    if (options.jsonPath == "-") {
+        writeJson(std::cout, options, timerOverhead, results);
+    } else if (!options.jsonPath.empty()) {
+        std::ofstream json(options.jsonPath);
+        if (!json) {
+            std::fprintf(stderr, "Cannot write %s.\n", options.jsonPath.c_str());
+            return 1;
+        }
+        writeJson(json, options, timerOverhead, results);
+    }
+    return 0;
+}
+
+} // namespace bench
+} // namespace banking_system
+
+int main(int argc, char** argv) {
+    try {
+        return banking_system::bench::run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Critical Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,525 @@
+// File: bank_workload.cpp
+// Purpose: Synthetic workload generator and trace replayer for capacity tests.
+//
+//   bank_workload generate -o <trace> [options]
+//     Draws a stream of deposits, withdrawals and transfers over a population of
+//     customers and records it to a trace file (see WorkloadTrace.hh). Account
+//     popularity is Zipfian: the k-th most popular customer is chosen with probability
+//     proportional to 1/k^s. Arrivals are a two-state Markov-modulated Poisson process:
+//     calm phases alternate with bursts running burst-factor times faster, with the
+//     long-run mean held at the requested rate.
+//
+//   bank_workload replay <trace> [--speed recorded|max] [--threads n] [options]
+//     Registers the trace's customers in bulk, funds their checking accounts, then
+//     executes the operations at their recorded arrival times or as fast as possible.
+//     With several threads, operations are split by source customer, so each
+//     customer's own stream keeps its order. Prints throughput and latency percentiles per operation type, and
+//     in recorded mode how far execution fell behind the arrival schedule.
+//
+// The same trace and options give the same operations, so runs before and after a
+// change are directly comparable.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bank.hh"
+#include "Customer.hh"
+#include "Journal.hh"
+#include "LatencyHistogram.hh"
+#include "Logger.hh"
+#include "WorkloadTrace.hh"
+
+namespace banking_system {
+namespace workload {
+
+constexpr std::size_t kOperationTypes = 3; // Indexed by TraceOperationType - 1
+
+const char* operationName(TraceOperationType type) {
+    switch (type) {
+        case TraceOperationType::DEPOSIT: return "deposit";
+        case TraceOperationType::WITHDRAW: return "withdraw";
+        case TraceOperationType::TRANSFER: return "transfer";
+    }
+    return "unknown";
+}
+
+struct GenerateOptions {
+    std::string outputPath;
+    std::uint64_t customers = 100000;
+    std::uint64_t operations = 1000000;
+    double mix[kOperationTypes] = {40, 30, 30}; // Deposit, withdraw, transfer weights
+    double zipfExponent = 0.99;                 // 0 is uniform
+    double rate = 50000;                        // Mean operations per second
+    double burstFactor = 8;
+    double burstFraction = 0.1;                 // Share of time spent in bursts
+    double burstMillis = 50;                    // Mean length of a burst
+    std::int64_t initialDepositCents = 100000;
+    std::int64_t minAmountCents = 100;          // Amounts are log-uniform in [min, max]
+    std::int64_t maxAmountCents = 50000;
+    std::uint64_t seed = 42;
+};
+
+struct ReplayOptions {
+    std::string tracePath;
+    bool recordedSpeed = false;
+    unsigned threads = 1;
+    std::string journalPath;
+    JournalSyncMode syncMode = JournalSyncMode::GROUP;
+};
+
+// --- Generation ---
+// Samples ranks 0..n-1 with P(k) proportional to 1/(k+1)^s from a cumulative table.
+class ZipfDistribution {
+public:
+    ZipfDistribution(std::uint64_t n, double exponent) : cdf_(static_cast<std::size_t>(n)) {
+        double sum = 0.0;
+        for (std::size_t k = 0; k < cdf_.size(); ++k) {
+            sum += 1.0 / std::pow(static_cast<double>(k + 1), exponent);
+            cdf_[k] = sum;
+        }
+        for (double& c : cdf_) c /= sum;
+    }
+
+    template <typename Random>
+    std::uint32_t operator()(Random& random) {
+        const double u = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+        const auto it = std::lower_bound(cdf_.begin(), cdf_.end(), u);
+        return static_cast<std::uint32_t>(std::min<std::size_t>(it - cdf_.begin(), cdf_.size() - 1));
+    }
+
+private:
+    std::vector<double> cdf_;
+};
+
+// Interarrival times of a Poisson process whose rate switches between a calm and a
+// burst level; phase lengths are exponential.
+class BurstyArrivals {
+public:
+    explicit BurstyArrivals(const GenerateOptions& options) {
+        const double p = std::min(0.99, std::max(0.0, options.burstFraction));
+        calmRate_ = options.rate / ((1.0 - p) + p * options.burstFactor);
+        burstRate_ = calmRate_ * options.burstFactor;
+        burstNanos_ = options.burstMillis * 1e6;
+        calmNanos_ = p > 0 ? burstNanos_ * (1.0 - p) / p : 0.0;
+        bursty_ = p > 0 && options.burstFactor != 1.0;
+    }
+
+    // Arrival time of the next operation, in nanoseconds since the start.
+    template <typename Random>
+    std::uint64_t next(Random& random) {
+        std::exponential_distribution<double> unit(1.0);
+        double remaining = unit(random); // In units of "expected arrivals"
+        for (;;) {
+            if (bursty_ && phaseLeft_ <= 0.0) {
+                inBurst_ = !inBurst_;
+                phaseLeft_ = unit(random) * (inBurst_ ? burstNanos_ : calmNanos_);
+            }
+            const double rate = (bursty_ && inBurst_ ? burstRate_ : calmRate_) / 1e9;
+            const double needed = remaining / rate;
+            if (!bursty_ || needed <= phaseLeft_) {
+                now_ += needed;
+                phaseLeft_ -= needed;
+                return static_cast<std::uint64_t>(now_);
+            }
+            // The phase ends first; carry the unused part of the draw into the next one.
+            remaining -= phaseLeft_ * rate;
+            now_ += phaseLeft_;
+            phaseLeft_ = 0.0;
+        }
+    }
+
+private:
+    double calmRate_ = 0.0; // Per second
+    double burstRate_ = 0.0;
+    double calmNanos_ = 0.0;
+    double burstNanos_ = 0.0;
+    double now_ = 0.0;
+    double phaseLeft_ = 0.0;
+    bool inBurst_ = true; // Flipped to calm on the first draw
+    bool bursty_ = false;
+};
+
+int generate(const GenerateOptions& options) {
+    if (options.customers == 0 || options.customers > 0xFFFFFFFFull) {
+        std::fprintf(stderr, "--customers must be between 1 and 4294967295.\n");
+        return 2;
+    }
+    std::mt19937_64 random(options.seed);
+
+    // The popularity order is a random permutation, so hot customers are not simply the
+    // first ones registered.
+    std::vector<std::uint32_t> byRank(static_cast<std::size_t>(options.customers));
+    std::iota(byRank.begin(), byRank.end(), 0u);
+    std::shuffle(byRank.begin(), byRank.end(), random);
+
+    ZipfDistribution popularity(options.customers, options.zipfExponent);
+    BurstyArrivals arrivals(options);
+    std::discrete_distribution<int> mix(std::begin(options.mix), std::end(options.mix));
+    std::uniform_real_distribution<double> logAmount(std::log(static_cast<double>(options.minAmountCents)),
+                                                     std::log(static_cast<double>(options.maxAmountCents)));
+
+    TraceHeader header;
+    header.customerCount = options.customers;
+    header.initialDepositCents = options.initialDepositCents;
+    header.seed = options.seed;
+    WorkloadTraceWriter writer(options.outputPath, header);
+
+    std::uint64_t counts[kOperationTypes] = {};
+    TraceOperation operation;
+    for (std::uint64_t i = 0; i < options.operations; ++i) {
+        operation.offsetNanos = arrivals.next(random);
+        operation.type = static_cast<TraceOperationType>(mix(random) + 1);
+        operation.source = byRank[popularity(random)];
+        operation.destination = 0;
+        if (operation.type == TraceOperationType::TRANSFER) {
+            if (options.customers < 2) {
+                operation.type = TraceOperationType::DEPOSIT;
+            } else {
+                do {
+                    operation.destination = byRank[popularity(random)];
+                } while (operation.destination == operation.source);
+            }
+        }
+        operation.cents = std::max<std::int64_t>(1, std::llround(std::exp(logAmount(random))));
+        writer.append(operation);
+        ++counts[static_cast<std::size_t>(operation.type) - 1];
+    }
+    if (!writer.finish()) {
+        std::fprintf(stderr, "Cannot write trace %s.\n", options.outputPath.c_str());
+        return 1;
+    }
+
+    const double seconds = static_cast<double>(operation.offsetNanos) / 1e9;
+    std::printf("%llu customers, %llu operations (%llu deposits, %llu withdrawals, %llu transfers) over %.3f s "
+                "(%.0f ops/s recorded)\n",
+                static_cast<unsigned long long>(options.customers), static_cast<unsigned long long>(options.operations),
+                static_cast<unsigned long long>(counts[0]), static_cast<unsigned long long>(counts[1]),
+                static_cast<unsigned long long>(counts[2]), seconds,
+                seconds > 0 ? static_cast<double>(options.operations) / seconds : 0.0);
+    std::printf("wrote %s: %llu bytes, %.2f bytes per operation\n", options.outputPath.c_str(),
+                static_cast<unsigned long long>(writer.getBytesWritten()),
+                options.operations ? static_cast<double>(writer.getBytesWritten()) / static_cast<double>(options.operations) : 0.0);
+    return 0;
+}
+
+// --- Replay ---
+struct Stats {
+    std::uint64_t succeeded[kOperationTypes] = {};
+    std::uint64_t failed[kOperationTypes] = {};
+    LatencyHistogram latency[kOperationTypes];
+    LatencyHistogram lag; // Recorded speed: start time minus scheduled arrival
+
+    void merge(const Stats& other) {
+        for (std::size_t t = 0; t < kOperationTypes; ++t) {
+            succeeded[t] += other.succeeded[t];
+            failed[t] += other.failed[t];
+            latency[t].merge(other.latency[t]);
+        }
+        lag.merge(other.lag);
+    }
+};
+
+std::uint64_t nanosSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+// Executes the operations listed in mine, in order.
+void replayShare(Bank& bank, const WorkloadTrace& trace, const std::vector<AccountId>& checking,
+                 const std::vector<std::uint32_t>& mine, bool recordedSpeed,
+                 std::chrono::steady_clock::time_point start, Stats& stats) {
+    for (std::uint32_t index : mine) {
+        const TraceOperation& operation = trace.operations[index];
+        if (recordedSpeed) {
+            const auto due = start + std::chrono::nanoseconds(operation.offsetNanos);
+            // Sleep while the wait is long; the last stretch is spun for precision.
+            while (std::chrono::steady_clock::now() + std::chrono::microseconds(200) < due) {
+                std::this_thread::sleep_until(due - std::chrono::microseconds(100));
+            }
+            while (std::chrono::steady_clock::now() < due) {
+            }
+            const std::uint64_t now = nanosSince(start);
+            stats.lag.record(now > operation.offsetNanos ? now - operation.offsetNanos : 0);
+        }
+
+        const Money amount = Money::fromCents(operation.cents);
+        const auto begin = std::chrono::steady_clock::now();
+        bool ok = false;
+        switch (operation.type) {
+            case TraceOperationType::DEPOSIT:
+                ok = bank.performDeposit(checking[operation.source], amount).has_value();
+                break;
+            case TraceOperationType::WITHDRAW:
+                ok = bank.performWithdraw(checking[operation.source], amount).has_value();
+                break;
+            case TraceOperationType::TRANSFER:
+                ok = bank.performTransfer(checking[operation.source], checking[operation.destination], amount).has_value();
+                break;
+        }
+        const std::uint64_t nanos = nanosSince(begin);
+        const std::size_t t = static_cast<std::size_t>(operation.type) - 1;
+        stats.latency[t].record(nanos);
+        ++(ok ? stats.succeeded[t] : stats.failed[t]);
+    }
+}
+
+void printLatencyHeader() {
+    std::printf("%-9s %10s %10s %8s %10s %10s %10s %10s %10s %10s\n", "operation", "count", "ok", "failed",
+                "mean ns", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns");
+}
+
+void printLatencyRow(const char* name, const LatencyHistogram& latency, std::uint64_t succeeded, std::uint64_t failed) {
+    std::printf("%-9s %10llu %10llu %8llu %10.0f %10llu %10llu %10llu %10llu %10llu\n", name,
+                static_cast<unsigned long long>(latency.getCount()), static_cast<unsigned long long>(succeeded),
+                static_cast<unsigned long long>(failed), latency.getMean(),
+                static_cast<unsigned long long>(latency.getPercentile(50)),
+                static_cast<unsigned long long>(latency.getPercentile(90)),
+                static_cast<unsigned long long>(latency.getPercentile(99)),
+                static_cast<unsigned long long>(latency.getPercentile(99.9)),
+                static_cast<unsigned long long>(latency.getMax()));
+}
+
+int replay(const ReplayOptions& options) {
+    const auto loadStart = std::chrono::steady_clock::now();
+    const WorkloadTrace trace = readWorkloadTrace(options.tracePath);
+    const TraceHeader& header = trace.header;
+    std::printf("loaded %llu customers and %llu operations in %.3f s\n",
+                static_cast<unsigned long long>(header.customerCount),
+                static_cast<unsigned long long>(trace.operations.size()),
+                static_cast<double>(nanosSince(loadStart)) / 1e9);
+
+    Bank bank;
+    if (!options.journalPath.empty()) {
+        JournalOptions journalOptions;
+        journalOptions.syncMode = options.syncMode;
+        bank.enableJournal(options.journalPath, journalOptions);
+    }
+
+    // Population: registration and funding are timed, but not part of the replay.
+    std::vector<std::string> names(static_cast<std::size_t>(header.customerCount));
+    for (std::size_t i = 0; i < names.size(); ++i) names[i] = traceCustomerName(header, i);
+    const auto registrationStart = std::chrono::steady_clock::now();
+    const std::vector<Customer*> customers = bank.registerCustomers(names);
+    const double registrationSeconds = static_cast<double>(nanosSince(registrationStart)) / 1e9;
+    std::printf("registered %zu customers in %.3f s (%.0f customers/s)\n", names.size(), registrationSeconds,
+                registrationSeconds > 0 ? static_cast<double>(names.size()) / registrationSeconds : 0.0);
+
+    LatencyHistogram funding;
+    std::vector<AccountId> checking(customers.size());
+    for (std::size_t i = 0; i < customers.size(); ++i) {
+        if (!customers[i]) throw std::runtime_error("Cannot register trace customer " + names[i] + ".");
+        for (AccountId id : customers[i]->getAccountIds()) {
+            if (bank.findAccount(id)->getType() == AccountType::CHECKING) checking[i] = id;
+        }
+    }
+    std::uint64_t funded = 0;
+    if (header.initialDepositCents > 0) {
+        for (AccountId id : checking) {
+            const auto begin = std::chrono::steady_clock::now();
+            funded += bank.performDeposit(id, Money::fromCents(header.initialDepositCents), "initial").has_value();
+            funding.record(nanosSince(begin));
+        }
+    }
+
+    const unsigned threads = std::max(1u, options.threads);
+    std::vector<std::vector<std::uint32_t>> shares(threads);
+    for (std::size_t i = 0; i < trace.operations.size(); ++i) {
+        shares[trace.operations[i].source % threads].push_back(static_cast<std::uint32_t>(i));
+    }
+
+    std::vector<Stats> stats(threads);
+    std::atomic<bool> go{false};
+    std::chrono::steady_clock::time_point start;
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            replayShare(bank, trace, checking, shares[t], options.recordedSpeed, start, stats[t]);
+        });
+    }
+    start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    replayShare(bank, trace, checking, shares[0], options.recordedSpeed, start, stats[0]);
+    for (std::thread& worker : workers) worker.join();
+    const double wallSeconds = static_cast<double>(nanosSince(start)) / 1e9;
+    Logger::instance().flush();
+
+    Stats total;
+    for (const Stats& s : stats) total.merge(s);
+
+    printLatencyHeader();
+    if (funding.getCount()) printLatencyRow("fund", funding, funded, funding.getCount() - funded);
+    LatencyHistogram all;
+    std::uint64_t succeeded = 0;
+    std::uint64_t failed = 0;
+    for (std::size_t t = 0; t < kOperationTypes; ++t) {
+        if (total.latency[t].getCount() == 0) continue;
+        printLatencyRow(operationName(static_cast<TraceOperationType>(t + 1)), total.latency[t],
+                        total.succeeded[t], total.failed[t]);
+        all.merge(total.latency[t]);
+        succeeded += total.succeeded[t];
+        failed += total.failed[t];
+    }
+    printLatencyRow("all", all, succeeded, failed);
+
+    const double recordedSeconds = trace.operations.empty() ? 0.0 : static_cast<double>(trace.operations.back().offsetNanos) / 1e9;
+    std::printf("replayed %zu operations on %u thread%s in %.3f s: %.0f ops/s (trace spans %.3f s, %.0f ops/s recorded)\n",
+                trace.operations.size(), threads, threads == 1 ? "" : "s", wallSeconds,
+                wallSeconds > 0 ? static_cast<double>(trace.operations.size()) / wallSeconds : 0.0, recordedSeconds,
+                recordedSeconds > 0 ? static_cast<double>(trace.operations.size()) / recordedSeconds : 0.0);
+    if (options.recordedSpeed) {
+        std::printf("schedule lag: p50 %llu ns, p99 %llu ns, max %llu ns\n",
+                    static_cast<unsigned long long>(total.lag.getPercentile(50)),
+                    static_cast<unsigned long long>(total.lag.getPercentile(99)),
+                    static_cast<unsigned long long>(total.lag.getMax()));
+    }
+    return 0;
+}
+
+// --- Entry Point ---
+void printUsage() {
+    std::fprintf(stderr,
+        "Usage: bank_workload generate -o <trace> [options]\n"
+        "  --customers <n>          Customers to register (default 100000)\n"
+        "  --ops <n>                Operations to generate (default 1000000)\n"
+        "  --mix <d:w:t>            Deposit:withdraw:transfer weights (default 40:30:30)\n"
+        "  --zipf <s>               Popularity exponent; 0 is uniform (default 0.99)\n"
+        "  --rate <ops/s>           Mean arrival rate (default 50000)\n"
+        "  --burst-factor <f>       Rate multiplier during bursts (default 8; 1 disables bursts)\n"
+        "  --burst-fraction <p>     Share of time spent in bursts (default 0.1)\n"
+        "  --burst-ms <ms>          Mean burst length (default 50)\n"
+        "  --initial-deposit <amt>  Funding of every checking account (default 1000.00)\n"
+        "  --amounts <min:max>      Range of log-uniform amounts (default 1.00:500.00)\n"
+        "  --seed <n>               Random seed (default 42)\n"
+        "       bank_workload replay <trace> [options]\n"
+        "  --speed <recorded|max>   Honour arrival times or run flat out (default max)\n"
+        "  --threads <n>            Replay threads (default 1)\n"
+        "  --journal <path>         Journal every operation to path\n"
+        "  --sync <mode>            Journal sync mode: per-op, group (default) or async\n");
+}
+
+bool parseMoney(const char* text, std::int64_t& cents) {
+    const std::optional<Money> amount = Money::parse(text);
+    if (!amount || !amount->isPositive()) return false;
+    cents = amount->getCents();
+    return true;
+}
+
+bool parseGenerateOptions(int argc, char** argv, GenerateOptions& options) {
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+        if (arg == "-o" || arg == "--output") {
+            options.outputPath = value;
+        } else if (arg == "--customers") {
+            options.customers = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--ops") {
+            options.operations = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--mix") {
+            if (std::sscanf(value, "%lf:%lf:%lf", &options.mix[0], &options.mix[1], &options.mix[2]) != 3) return false;
+            if (options.mix[0] < 0 || options.mix[1] < 0 || options.mix[2] < 0 ||
+                options.mix[0] + options.mix[1] + options.mix[2] <= 0) {
+                return false;
+            }
+        } else if (arg == "--zipf") {
+            options.zipfExponent = std::strtod(value, nullptr);
+            if (options.zipfExponent < 0) return false;
+        } else if (arg == "--rate") {
+            options.rate = std::strtod(value, nullptr);
+            if (options.rate <= 0) return false;
+        } else if (arg == "--burst-factor") {
+            options.burstFactor = std::strtod(value, nullptr);
+            if (options.burstFactor < 1) return false;
+        } else if (arg == "--burst-fraction") {
+            options.burstFraction = std::strtod(value, nullptr);
+            if (options.burstFraction < 0 || options.burstFraction >= 1) return false;
+        } else if (arg == "--burst-ms") {
+            options.burstMillis = std::strtod(value, nullptr);
+            if (options.burstMillis <= 0) return false;
+        } else if (arg == "--initial-deposit") {
+            if (!parseMoney(value, options.initialDepositCents)) return false;
+        } else if (arg == "--amounts") {
+            const char* colon = std::strchr(value, ':');
+            if (!colon || !parseMoney(std::string(value, colon).c_str(), options.minAmountCents) ||
+                !parseMoney(colon + 1, options.maxAmountCents) || options.minAmountCents > options.maxAmountCents) {
+                return false;
+            }
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+    return !options.outputPath.empty();
+}
+
+bool parseReplayOptions(int argc, char** argv, ReplayOptions& options) {
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.empty() || arg[0] != '-') {
+            if (!options.tracePath.empty()) return false;
+            options.tracePath = arg;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+        if (arg == "--speed") {
+            if (std::strcmp(value, "recorded") == 0) options.recordedSpeed = true;
+            else if (std::strcmp(value, "max") == 0) options.recordedSpeed = false;
+            else return false;
+        } else if (arg == "--threads") {
+            options.threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            if (options.threads == 0) return false;
+        } else if (arg == "--journal") {
+            options.journalPath = value;
+        } else if (arg == "--sync") {
+            if (std::strcmp(value, "per-op") == 0) options.syncMode = JournalSyncMode::PER_OPERATION;
+            else if (std::strcmp(value, "group") == 0) options.syncMode = JournalSyncMode::GROUP;
+            else if (std::strcmp(value, "async") == 0) options.syncMode = JournalSyncMode::ASYNC;
+            else return false;
+        } else {
+            return false;
+        }
+    }
+    return !options.tracePath.empty();
+}
+
+int run(int argc, char** argv) {
+    // Rejected operations (an overdrawn withdrawal) are part of a workload.
+    Logger::instance().setLevel(LogLevel::OFF);
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "generate") {
+        GenerateOptions options;
+        if (parseGenerateOptions(argc, argv, options)) return generate(options);
+    } else if (mode == "replay") {
+        ReplayOptions options;
+        if (parseReplayOptions(argc, argv, options)) return replay(options);
+    }
+    printUsage();
+    return 2;
+}
+
+} // namespace workload
+} // namespace banking_system
+
+int main(int argc, char** argv) {
+    try {
+        return banking_system::workload::run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Critical Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,504 @@
+// File: minibank_cli.cpp
+// Purpose: Headless driver for the banking engine. Reads a script of commands from a
+// file or stdin, executes them against a Bank and prints per-command and aggregate
+// timings. Parsing runs on its own thread, a block of commands ahead of execution, so
+// the executing thread only calls into the Bank.
+//
+// Script format: one command per line; '#' starts a comment. Customer names are single
+// words. An <account> is an account ID (6221-...) or <name>:savings / <name>:checking.
+//   register <name>
+//   deposit <account> <amount> [note...]
+//   withdraw <account> <amount> [note...]
+//   transfer <from account> <to account> <amount> [note...]
+//   report all <file>
+//   report customer <name> <file>
+//   report account <account> <file>
+//   report day <YYYY-MM-DD> <file>     (all transactions of one local day)
+//   interest <floor>:<rate%> [<floor>:<rate%>...]
+//                                      (one day's tiered interest on every savings
+//                                       account; e.g. interest 0:1.5 10000:2.25)
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bank.hh"
+#include "Customer.hh"
+#include "Journal.hh"
+#include "LatencyHistogram.hh"
+#include "Logger.hh"
+#include "Utils.hh"
+
+namespace banking_system {
+namespace cli {
+
+enum class CommandType : std::uint8_t {
+    REGISTER,
+    DEPOSIT,
+    WITHDRAW,
+    TRANSFER,
+    REPORT,
+    INTEREST,
+    INVALID // A line that failed to parse; error holds the reason
+};
+constexpr std::size_t kCommandTypes = 6;
+
+const char* commandName(CommandType type) {
+    switch (type) {
+        case CommandType::REGISTER: return "register";
+        case CommandType::DEPOSIT: return "deposit";
+        case CommandType::WITHDRAW: return "withdraw";
+        case CommandType::TRANSFER: return "transfer";
+        case CommandType::REPORT: return "report";
+        case CommandType::INTEREST: return "interest";
+        default: return "invalid";
+    }
+}
+
+struct Command {
+    CommandType type = CommandType::INVALID;
+    std::size_t line = 0;
+    std::string name;        // REGISTER: customer; REPORT: scope (all/customer/account/day)
+    std::string source;      // Account reference, or the report's customer/account/day
+    std::string destination; // Account reference, or the report file
+    Money amount;
+    std::string note;
+    std::vector<InterestTier> tiers; // INTEREST
+    std::string error;
+};
+
+struct Options {
+    std::string scriptPath = "-";
+    std::string journalPath;
+    JournalSyncMode syncMode = JournalSyncMode::GROUP;
+    std::string logPath;
+    LogLevel logLevel = LogLevel::OFF; // Rejected operations log errors; keep timing runs quiet
+    bool printEach = false;
+};
+
+// --- Parsing ---
+// Parses an annual rate in percent with up to four decimals, e.g. "2.25", into parts
+// per million.
+std::optional<std::uint32_t> parseRatePpm(const std::string& text) {
+    const std::size_t dot = text.find('.');
+    const std::string whole = text.substr(0, dot);
+    std::string fraction = (dot == std::string::npos) ? std::string() : text.substr(dot + 1);
+    auto digits = [](const std::string& part) {
+        return part.find_first_not_of("0123456789") == std::string::npos;
+    };
+    if (whole.empty() || whole.size() > 4 || fraction.size() > 4 || !digits(whole) || !digits(fraction)) {
+        return std::nullopt;
+    }
+    fraction.resize(4, '0');
+    return static_cast<std::uint32_t>(std::stoul(whole) * 10000 + std::stoul(fraction));
+}
+
+Command parseCommand(const std::string& text, std::size_t line) {
+    Command command;
+    command.line = line;
+    std::istringstream in(text);
+    std::string verb;
+    in >> verb;
+
+    auto fail = [&](const std::string& reason) {
+        command.type = CommandType::INVALID;
+        command.error = reason;
+        return command;
+    };
+    auto readAmount = [&]() -> bool {
+        std::string amountText;
+        if (!(in >> amountText)) return false;
+        std::optional<Money> amount = Money::parse(amountText);
+        if (!amount) return false;
+        command.amount = *amount;
+        return true;
+    };
+    auto readNote = [&]() {
+        std::getline(in >> std::ws, command.note);
+    };
+
+    if (verb == "register") {
+        command.type = CommandType::REGISTER;
+        if (!(in >> command.name)) return fail("register needs a customer name");
+    } else if (verb == "deposit" || verb == "withdraw") {
+        command.type = (verb == "deposit") ? CommandType::DEPOSIT : CommandType::WITHDRAW;
+        if (!(in >> command.source)) return fail(verb + " needs an account");
+        if (!readAmount()) return fail(verb + " needs a valid amount");
+        readNote();
+    } else if (verb == "transfer") {
+        command.type = CommandType::TRANSFER;
+        if (!(in >> command.source >> command.destination)) return fail("transfer needs two accounts");
+        if (!readAmount()) return fail("transfer needs a valid amount");
+        readNote();
+    } else if (verb == "report") {
+        command.type = CommandType::REPORT;
+        if (!(in >> command.name)) return fail("report needs a scope");
+        if (command.name == "customer" || command.name == "account") {
+            if (!(in >> command.source)) return fail("report " + command.name + " needs a " + command.name);
+        } else if (command.name == "day") {
+            if (!(in >> command.source) || !utils::parseLocalDate(command.source)) {
+                return fail("report day needs a YYYY-MM-DD date");
+            }
+        } else if (command.name != "all") {
+            return fail("unknown report scope '" + command.name + "'");
+        }
+        if (!(in >> command.destination)) return fail("report needs a file name");
+    } else if (verb == "interest") {
+        command.type = CommandType::INTEREST;
+        std::string tierText;
+        while (in >> tierText) {
+            const std::size_t colon = tierText.find(':');
+            const std::optional<Money> floor = Money::parse(tierText.substr(0, colon));
+            const std::optional<std::uint32_t> rate =
+                (colon == std::string::npos) ? std::nullopt : parseRatePpm(tierText.substr(colon + 1));
+            if (!floor || !rate) return fail("interest tiers are <floor>:<rate%>, e.g. 0:1.5");
+            command.tiers.push_back(InterestTier{*floor, *rate});
+        }
+        try {
+            InterestSchedule schedule(command.tiers);
+        } catch (const std::invalid_argument& e) {
+            return fail(e.what());
+        }
+    } else {
+        return fail("unknown command '" + verb + "'");
+    }
+    return command;
+}
+
+// Parses the script on a background thread in blocks of kBlockSize commands, keeping
+// at most kMaxBlocks blocks ahead of the executor.
+class CommandReader {
+public:
+    static constexpr std::size_t kBlockSize = 4096;
+    static constexpr std::size_t kMaxBlocks = 8;
+
+    explicit CommandReader(std::istream& in) : in_(in), thread_(&CommandReader::run, this) {}
+
+    ~CommandReader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+        thread_.join();
+    }
+
+    // Next block in script order; empty once the script is exhausted.
+    std::vector<Command> nextBlock() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [&] { return !blocks_.empty() || finished_; });
+        if (blocks_.empty()) return {};
+        std::vector<Command> block = std::move(blocks_.front());
+        blocks_.pop_front();
+        changed_.notify_all();
+        return block;
+    }
+
+private:
+    void run() {
+        std::string text;
+        std::size_t line = 0;
+        std::vector<Command> block;
+        bool more = true;
+        while (more) {
+            block.clear();
+            block.reserve(kBlockSize);
+            while (block.size() < kBlockSize && (more = static_cast<bool>(std::getline(in_, text)))) {
+                ++line;
+                const std::size_t start = text.find_first_not_of(" \t\r");
+                if (start == std::string::npos || text[start] == '#') continue;
+                block.push_back(parseCommand(text, line));
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [&] { return blocks_.size() < kMaxBlocks || stopping_; });
+            if (stopping_) break;
+            if (!block.empty()) blocks_.push_back(std::move(block));
+            changed_.notify_all();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+        changed_.notify_all();
+    }
+
+    std::istream& in_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<std::vector<Command>> blocks_;
+    bool finished_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+// --- Execution ---
+class Executor {
+public:
+    Executor(Bank& bank, bool printEach) : bank_(bank), printEach_(printEach) {}
+
+    void execute(const Command& command);
+    void printSummary(double wallSeconds) const;
+    std::uint64_t getInvalidLines() const;
+
+private:
+    struct Stats {
+        std::uint64_t succeeded = 0;
+        std::uint64_t failed = 0;
+        LatencyHistogram latency;
+    };
+
+    bool resolveAccount(const std::string& reference, AccountId& accountId) const;
+    bool run(const Command& command, std::string& detail);
+
+    Bank& bank_;
+    bool printEach_;
+    Stats stats_[kCommandTypes];
+    std::uint64_t invalid_ = 0;
+};
+
+// <name>:savings and <name>:checking name a customer's accounts; anything else must be
+// an account ID.
+bool Executor::resolveAccount(const std::string& reference, AccountId& accountId) const {
+    const std::size_t colon = reference.rfind(':');
+    if (colon == std::string::npos) {
+        std::optional<AccountId> parsed = AccountId::parse(reference);
+        if (!parsed) return false;
+        accountId = *parsed;
+        return true;
+    }
+    const Customer* customer = bank_.findCustomer(reference.substr(0, colon));
+    if (!customer) return false;
+    const std::string kind = reference.substr(colon + 1);
+    if (kind != "savings" && kind != "checking") return false;
+    const AccountType type = (kind == "savings") ? AccountType::SAVINGS : AccountType::CHECKING;
+    for (AccountId id : customer->getAccountIds()) {
+        const Account* account = bank_.findAccount(id);
+        if (account && account->getType() == type) {
+            accountId = id;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Runs one command against the bank. Returns false, with detail set when the bank
+// was not asked at all, if the command failed.
+bool Executor::run(const Command& command, std::string& detail) {
+    AccountId source;
+    AccountId destination;
+    const bool needsSource = command.type == CommandType::DEPOSIT || command.type == CommandType::WITHDRAW ||
+                             command.type == CommandType::TRANSFER ||
+                             (command.type == CommandType::REPORT && command.name == "account");
+    if ((needsSource && !resolveAccount(command.source, source)) ||
+        (command.type == CommandType::TRANSFER && !resolveAccount(command.destination, destination))) {
+        detail = "unknown account";
+        return false;
+    }
+
+    switch (command.type) {
+        case CommandType::REGISTER:
+            return bank_.registerCustomer(command.name) != nullptr;
+        case CommandType::DEPOSIT:
+            return bank_.performDeposit(source, command.amount, command.note).has_value();
+        case CommandType::WITHDRAW:
+            return bank_.performWithdraw(source, command.amount, command.note).has_value();
+        case CommandType::TRANSFER:
+            return bank_.performTransfer(source, destination, command.amount, command.note).has_value();
+        case CommandType::REPORT:
+            if (command.name == "all") return bank_.generateGlobalReport(command.destination);
+            if (command.name == "customer") return bank_.generateCustomerReport(command.source, command.destination);
+            if (command.name == "day") {
+                const auto dayStart = *utils::parseLocalDate(command.source);
+                return bank_.generateReport(TransactionQuery::all().between(dayStart, utils::nextLocalDayStart(dayStart)),
+                                            command.destination);
+            }
+            return bank_.generateAccountReport(source, command.destination);
+        case CommandType::INTEREST:
+            try {
+                const InterestRun interest = bank_.accrueInterest(InterestEngine(InterestSchedule(command.tiers)));
+                detail = std::to_string(interest.accountsCredited) + " accounts credited";
+            } catch (const std::overflow_error& e) {
+                detail = e.what();
+                return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+void Executor::execute(const Command& command) {
+    if (command.type == CommandType::INVALID) {
+        ++invalid_;
+        std::fprintf(stderr, "line %zu: %s\n", command.line, command.error.c_str());
+        return;
+    }
+    std::string detail;
+    const auto start = std::chrono::steady_clock::now();
+    const bool succeeded = run(command, detail);
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    Stats& stats = stats_[static_cast<std::size_t>(command.type)];
+    stats.latency.record(static_cast<std::uint64_t>(nanos));
+    ++(succeeded ? stats.succeeded : stats.failed);
+    if (printEach_) {
+        std::printf("line %zu: %s %s in %lld ns%s%s\n", command.line, commandName(command.type),
+                    succeeded ? "ok" : "failed", static_cast<long long>(nanos),
+                    detail.empty() ? "" : ", ", detail.c_str());
+    }
+}
+
+std::uint64_t Executor::getInvalidLines() const {
+    return invalid_;
+}
+
+void Executor::printSummary(double wallSeconds) const {
+    std::printf("%-9s %10s %10s %8s %12s %10s %10s %10s %10s\n", "command", "count", "ok", "failed",
+                "total ms", "mean ns", "p50 ns", "p99 ns", "max ns");
+    LatencyHistogram all;
+    std::uint64_t succeeded = 0;
+    for (std::size_t i = 0; i < kCommandTypes; ++i) {
+        const Stats& stats = stats_[i];
+        const LatencyHistogram& latency = stats.latency;
+        if (latency.getCount() == 0) continue;
+        std::printf("%-9s %10llu %10llu %8llu %12.3f %10.0f %10llu %10llu %10llu\n",
+                    commandName(static_cast<CommandType>(i)),
+                    static_cast<unsigned long long>(latency.getCount()),
+                    static_cast<unsigned long long>(stats.succeeded),
+                    static_cast<unsigned long long>(stats.failed),
+                    latency.getMean() * static_cast<double>(latency.getCount()) / 1e6, latency.getMean(),
+                    static_cast<unsigned long long>(latency.getPercentile(50)),
+                    static_cast<unsigned long long>(latency.getPercentile(99)),
+                    static_cast<unsigned long long>(latency.getMax()));
+        all.merge(latency);
+        succeeded += stats.succeeded;
+    }
+    const double busySeconds = all.getMean() * static_cast<double>(all.getCount()) / 1e9;
+    std::printf("%llu commands (%llu ok, %llu invalid lines) in %.3f s: %.0f commands/s wall, %.0f commands/s in Bank\n",
+                static_cast<unsigned long long>(all.getCount()), static_cast<unsigned long long>(succeeded),
+                static_cast<unsigned long long>(invalid_), wallSeconds,
+                wallSeconds > 0 ? static_cast<double>(all.getCount()) / wallSeconds : 0.0,
+                busySeconds > 0 ? static_cast<double>(all.getCount()) / busySeconds : 0.0);
+}
+
+// --- Entry Point ---
+void printUsage() {
+    std::fprintf(stderr,
+        "Usage: minibank_cli [options] [script]\n"
+        "Runs the commands in script (default '-', stdin) and prints their timings.\n"
+        "  --journal <path>         Journal every operation to path\n"
+        "  --sync <mode>            Journal sync mode: per-op, group (default) or async\n"
+        "  --log-file <path>        Write the bank's log to path instead of stderr\n"
+        "  --log-level <level>      debug, info, warning, error or off (default)\n"
+        "  --each                   Print every command's result and latency\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : nullptr; };
+        if (arg == "--journal") {
+            const char* path = value();
+            if (!path) return false;
+            options.journalPath = path;
+        } else if (arg == "--sync") {
+            const char* mode = value();
+            if (!mode) return false;
+            if (std::strcmp(mode, "per-op") == 0) options.syncMode = JournalSyncMode::PER_OPERATION;
+            else if (std::strcmp(mode, "group") == 0) options.syncMode = JournalSyncMode::GROUP;
+            else if (std::strcmp(mode, "async") == 0) options.syncMode = JournalSyncMode::ASYNC;
+            else return false;
+        } else if (arg == "--log-file") {
+            const char* path = value();
+            if (!path) return false;
+            options.logPath = path;
+        } else if (arg == "--log-level") {
+            const char* level = value();
+            if (!level) return false;
+            const char* names[] = {"debug", "info", "warning", "error", "off"};
+            bool known = false;
+            for (int l = 0; l < 5; ++l) {
+                if (std::strcmp(level, names[l]) == 0) {
+                    options.logLevel = static_cast<LogLevel>(l);
+                    known = true;
+                }
+            }
+            if (!known) return false;
+        } else if (arg == "--each") {
+            options.printEach = true;
+        } else if (arg == "--help" || arg == "-h" || (arg.size() > 1 && arg[0] == '-')) {
+            return false;
+        } else {
+            options.scriptPath = arg;
+        }
+    }
+    return true;
+}
+
+int run(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    Logger& logger = Logger::instance();
+    logger.setLevel(options.logLevel);
+    if (!options.logPath.empty()) logger.openFile(options.logPath);
+
+    std::ifstream file;
+    if (options.scriptPath != "-") {
+        file.open(options.scriptPath);
+        if (!file) {
+            std::fprintf(stderr, "Cannot open script %s.\n", options.scriptPath.c_str());
+            return 1;
+        }
+    }
+    std::istream& script = (options.scriptPath == "-") ? std::cin : file;
+
+    Bank bank;
+    if (!options.journalPath.empty()) {
+        JournalOptions journalOptions;
+        journalOptions.syncMode = options.syncMode;
+        bank.enableJournal(options.journalPath, journalOptions);
+    }
+
+    Executor executor(bank, options.printEach);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        CommandReader reader(script);
+        for (std::vector<Command> block = reader.nextBlock(); !block.empty(); block = reader.nextBlock()) {
+            for (const Command& command : block) {
+                executor.execute(command);
+            }
+        }
+    }
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    logger.flush();
+    executor.printSummary(wallSeconds);
+    // Operations the bank rejects are part of a workload; only a broken script fails.
+    return executor.getInvalidLines() == 0 ? 0 : 1;
+}
+
+} // namespace cli
+} // namespace banking_system
+
+int main(int argc, char** argv) {
+    try {
+        return banking_system::cli::run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Critical Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,208 @@
+// File: minibank_import.cpp
+// Purpose: Migrates an existing book into a new Bank with importFile (see
+// BulkImport.hh): customers, opening balances and historical transactions, from one
+// or more CSV or fixed-width files applied in the order given. Prints progress while
+// importing and a report with the rate and the first errors of each file. The result
+// is kept by journaling the import, writing a snapshot at the end, or both.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Bank.hh"
+#include "BulkImport.hh"
+#include "Journal.hh"
+#include "Logger.hh"
+
+namespace banking_system {
+namespace importer {
+
+struct Options {
+    std::vector<std::string> paths;
+    ImportOptions import;
+    bool formatGiven = false;
+    std::string journalPath;
+    JournalSyncMode syncMode = JournalSyncMode::ASYNC; // One commit per chunk; the snapshot or a final flush makes it durable
+    std::string snapshotPath;
+    std::size_t printErrors = 20;
+    bool quiet = false;
+};
+
+void printUsage() {
+    std::fprintf(stderr,
+        "Usage: minibank_import [options] <file>...\n"
+        "Imports customers, opening balances and historical transactions into a new bank.\n"
+        "  --format <csv|fixed>     Input format (default: csv, or fixed for .dat and .txt files)\n"
+        "  --threads <n>            Parser threads (default: one per hardware thread)\n"
+        "  --chunk-kb <n>           Bytes parsed per chunk, in KiB (default 4096)\n"
+        "  --journal <path>         Journal the imported records to path\n"
+        "  --sync <mode>            Journal sync mode: per-op, group or async (default)\n"
+        "  --snapshot <path>        Write a snapshot of the bank after importing\n"
+        "  --errors <n>             Errors printed per file (default 20)\n"
+        "  --quiet                  Do not print progress\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : nullptr; };
+        auto count = [&](std::size_t& out) {
+            const char* text = value();
+            if (!text) return false;
+            try {
+                out = static_cast<std::size_t>(std::stoull(text));
+            } catch (const std::exception&) {
+                return false;
+            }
+            return true;
+        };
+        if (arg == "--format") {
+            const char* format = value();
+            if (!format) return false;
+            if (std::strcmp(format, "csv") == 0) options.import.format = ImportFormat::CSV;
+            else if (std::strcmp(format, "fixed") == 0) options.import.format = ImportFormat::FIXED_WIDTH;
+            else return false;
+            options.formatGiven = true;
+        } else if (arg == "--threads") {
+            std::size_t threads = 0;
+            if (!count(threads)) return false;
+            options.import.threads = static_cast<unsigned>(threads);
+        } else if (arg == "--chunk-kb") {
+            std::size_t kilobytes = 0;
+            if (!count(kilobytes) || kilobytes == 0) return false;
+            options.import.chunkBytes = kilobytes << 10;
+        } else if (arg == "--journal") {
+            const char* path = value();
+            if (!path) return false;
+            options.journalPath = path;
+        } else if (arg == "--sync") {
+            const char* mode = value();
+            if (!mode) return false;
+            if (std::strcmp(mode, "per-op") == 0) options.syncMode = JournalSyncMode::PER_OPERATION;
+            else if (std::strcmp(mode, "group") == 0) options.syncMode = JournalSyncMode::GROUP;
+            else if (std::strcmp(mode, "async") == 0) options.syncMode = JournalSyncMode::ASYNC;
+            else return false;
+        } else if (arg == "--snapshot") {
+            const char* path = value();
+            if (!path) return false;
+            options.snapshotPath = path;
+        } else if (arg == "--errors") {
+            if (!count(options.printErrors)) return false;
+        } else if (arg == "--quiet") {
+            options.quiet = true;
+        } else if (arg == "--help" || arg == "-h" || (arg.size() > 1 && arg[0] == '-')) {
+            return false;
+        } else {
+            options.paths.push_back(arg);
+        }
+    }
+    return !options.paths.empty();
+}
+
+ImportFormat formatFor(const Options& options, const std::string& path) {
+    if (options.formatGiven) return options.import.format;
+    auto endsWith = [&path](const char* suffix) {
+        const std::size_t length = std::strlen(suffix);
+        return path.size() >= length && path.compare(path.size() - length, length, suffix) == 0;
+    };
+    return (endsWith(".dat") || endsWith(".txt")) ? ImportFormat::FIXED_WIDTH : ImportFormat::CSV;
+}
+
+void printReport(const std::string& path, const ImportReport& report, std::size_t printErrors) {
+    const double megabytes = static_cast<double>(report.bytes) / (1024.0 * 1024.0);
+    const double seconds = report.elapsedSeconds > 0 ? report.elapsedSeconds : 1e-9;
+    const std::uint64_t records = report.customers + report.transactions;
+    std::printf("%s: %llu lines, %llu customers, %llu transactions in %.3f s "
+                "(%.1f MB/s, %.0f records/s)\n",
+                path.c_str(), static_cast<unsigned long long>(report.lines),
+                static_cast<unsigned long long>(report.customers),
+                static_cast<unsigned long long>(report.transactions), report.elapsedSeconds,
+                megabytes / seconds, static_cast<double>(records) / seconds);
+    if (report.getErrorCount() == 0) return;
+    std::printf("  %llu errors: %llu malformed lines, %llu records rejected\n",
+                static_cast<unsigned long long>(report.getErrorCount()),
+                static_cast<unsigned long long>(report.parseErrors),
+                static_cast<unsigned long long>(report.rejected));
+    const std::size_t shown = std::min(printErrors, report.errors.size());
+    for (std::size_t i = 0; i < shown; ++i) {
+        std::printf("  line %llu: %s\n", static_cast<unsigned long long>(report.errors[i].line),
+                    report.errors[i].message.c_str());
+    }
+    if (report.getErrorCount() > shown) {
+        std::printf("  ... %llu more\n", static_cast<unsigned long long>(report.getErrorCount() - shown));
+    }
+}
+
+int run(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    // The report below covers what the bank would log at info level.
+    Logger::instance().setLevel(LogLevel::WARNING);
+    options.import.maxReportedErrors = options.printErrors;
+
+    Bank bank;
+    if (!options.journalPath.empty()) {
+        JournalOptions journalOptions;
+        journalOptions.syncMode = options.syncMode;
+        bank.enableJournal(options.journalPath, journalOptions);
+    }
+
+    std::uint64_t errors = 0;
+    for (const std::string& path : options.paths) {
+        ImportOptions importOptions = options.import;
+        importOptions.format = formatFor(options, path);
+        auto lastPrinted = std::chrono::steady_clock::now();
+        if (!options.quiet) {
+            importOptions.onProgress = [&](const ImportProgress& progress) {
+                const auto now = std::chrono::steady_clock::now();
+                if (progress.bytesDone != progress.bytesTotal && now - lastPrinted < std::chrono::milliseconds(500)) {
+                    return;
+                }
+                lastPrinted = now;
+                const double percent = progress.bytesTotal
+                    ? 100.0 * static_cast<double>(progress.bytesDone) / static_cast<double>(progress.bytesTotal) : 100.0;
+                std::fprintf(stderr, "\r%s: %5.1f%%  %llu records  %llu errors  %.1f s", path.c_str(), percent,
+                             static_cast<unsigned long long>(progress.recordsApplied),
+                             static_cast<unsigned long long>(progress.errorCount), progress.elapsedSeconds);
+                if (progress.bytesDone == progress.bytesTotal) std::fputc('\n', stderr);
+            };
+        }
+        const ImportReport report = importFile(bank, path, importOptions);
+        printReport(path, report, options.printErrors);
+        errors += report.getErrorCount();
+    }
+
+    if (Journal* journal = bank.getJournal()) journal->flush();
+    if (!options.snapshotPath.empty()) {
+        const auto started = std::chrono::steady_clock::now();
+        if (!bank.writeSnapshotAsync(options.snapshotPath).get()) {
+            std::fprintf(stderr, "Cannot write snapshot %s.\n", options.snapshotPath.c_str());
+            return 1;
+        }
+        std::printf("snapshot %s written in %.3f s\n", options.snapshotPath.c_str(),
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+    }
+    std::printf("bank: %zu customers, %zu accounts, %zu transactions, total balance %s\n",
+                bank.getAllCustomers().size(), bank.getAccountCount(), bank.getTransactionCount(),
+                bank.getTotalBalance().toString().c_str());
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace importer
+} // namespace banking_system
+
+int main(int argc, char** argv) {
+    try {
+        return banking_system::importer::run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Critical Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,63 +1,84 @@
-#pragma once 
+#pragma once
 
 #include <string>
-#include <vector>
-#include <memory> 
-#include <ctime> 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "AccountId.hh"
+#include "Money.hh"
 
 namespace banking_system {
 
-class Transaction;
+class Customer;
+class ShardedBalance;
 
 // Enum to represent different types of accounts
-enum class AccountType {
+enum class AccountType : std::uint8_t {
     SAVINGS,
     CHECKING
 };
 
 // File: Account.hh
-// Purpose: Defines the Account class, which serves as an abstract base class
-// for all types of bank accounts in the system. It outlines common
-// properties (like account ID, owner, balance) and behaviors (like deposit,
-// withdraw, transfer) that specific account types will implement or override.
+// Purpose: Defines the Account class, the record the Bank keeps for each bank account
+// (ID, owner, type and balance). Accounts are plain fixed-size records, stored by
+// value in an AccountPool (see AccountPool.hh) and addressed by their slot: the type
+// is a tag rather than a subclass, and the owner is a reference to its Customer
+// rather than a copy of the name. The rules for what each type may do are enforced by
+// the Bank, which performs every deposit, withdrawal and transfer.
 class Account {
 public:
     // Constructor: Initializes an Account object.
     // accountId: Unique identifier for the account.
-    // ownerName: Name of the account holder.
+    // type: Savings or checking.
+    // owner: The account holder, which must outlive the account.
     // initialBalance: The starting balance of the account.
-    Account(const std::string& accountId, const std::string& ownerName, double initialBalance);
+    // slot: Dense position of the account in the Bank's pool and balance columns.
+    Account(AccountId accountId, AccountType type, const Customer& owner, Money initialBalance, std::size_t slot);
 
-    virtual ~Account() = default;
+    ~Account();
 
     // --- Getters for account details ---
-    const std::string& getAccountId() const;
-    const std::string& getOwnerName() const; 
-    double getBalance() const;       
-
-    // --- virtual function for account type(and it`s pure jaja) ---
-    virtual AccountType getType() const = 0;
+    AccountId getAccountId() const { return accountId_; }
+    AccountType getType() const { return type_; }
+    const Customer& getOwner() const { return *owner_; }
+    const std::string& getOwnerName() const;
+    Money getBalance() const;       // Settled balance plus any pending sharded credits
 
-    // --- Virtual functions for account operations  ---
-    virtual bool deposit(double amount, const std::string& note = "");
-    virtual bool withdraw(double amount, const std::string& note = "");
-    virtual bool transfer(Account* destinationAccount, double amount, const std::string& note = "");
+    void setBalance(Money newBalance); // Sets the settled balance
 
-    void setBalance(double newBalance);
+    // --- Hot-account support (see ShardedBalance.hh) ---
+    // Balance excluding credits still pending in shards; equals getBalance() for
+    // accounts that are not sharded.
+    Money getSettledBalance() const;
+    // Null until the account is promoted. Promotion is one-way.
+    ShardedBalance* getShardedBalance() const;
+    // Routes future credits through shards seeded with the current settled balance.
+    // The caller holds the account lock.
+    void enableShardedBalance();
+    // Contention score used to decide promotion: raised on every contended lock
+    // acquisition and decayed on uncontended ones. Returns the new score.
+    std::uint32_t recordLockContention();
+    void recordUncontendedLock();
 
-protected:
-    // Data members accessible by derived classes
-    std::string accountId_;
-    std::string ownerName_;
-    double balance_;
+    // Dense position of this account in the Bank's balance columns.
+    std::size_t getSlot() const { return slot_; }
 
 private:
-    // Helper function to validate if an amount is positive.
-    bool isValidAmount(double amount) const;
+    // Fields written by operations first, then the identity fields, which never change.
+    // Cents, atomic so balances can be displayed while other threads update them.
+    // Writers are serialized by the Bank's account locks.
+    std::atomic<std::int64_t> balance_{0};
+    std::atomic<ShardedBalance*> sharded_{nullptr}; // Owned
+    std::atomic<std::uint32_t> contentionScore_{0};
+    std::uint32_t slot_ = 0;
+    AccountId accountId_;
+    const Customer* owner_ = nullptr;
+    AccountType type_;
 
-    // Disable copy operations to prevent slicing and unintended copies.
+    // Disable copy operations; accounts are referred to by address and never move.
     Account(const Account&) = delete;
     Account& operator=(const Account&) = delete;
 };
 
-} 
+}
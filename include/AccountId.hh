@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace banking_system {
+
+// File: AccountId.hh
+// Purpose: Defines AccountId, a compact value type for bank account numbers.
+// The text form is "62XX-YYYY-ZZZZ-AAAA" (19 characters): the fixed "62" prefix,
+// a two-digit type code (XX), a four-digit branch (YYYY) and an eight-digit
+// account number (ZZZZAAAA). Internally the three variable fields are packed into
+// one 64-bit integer, most significant field first, so that hashing and comparison
+// cost one integer operation and the integer order matches the text order.
+class AccountId {
+public:
+    static constexpr std::size_t kTextLength = 19;   // "62XX-YYYY-ZZZZ-AAAA"
+    static constexpr unsigned kMaxBranch = 9999;
+    static constexpr std::uint32_t kMaxNumber = 99999999;
+
+    // Type codes used in the XX position.
+    static constexpr unsigned kSavingsTypeCode = 21;
+    static constexpr unsigned kCheckingTypeCode = 22;
+
+    // Default-constructed IDs are invalid ("no account"), e.g. the source of a deposit.
+    constexpr AccountId() = default;
+
+    // Builds an ID from its fields. Throws std::invalid_argument if a field is out of range.
+    static AccountId fromParts(unsigned typeCode, unsigned branch, std::uint32_t number);
+
+    // Parses the dashed text form. Returns std::nullopt if the text is malformed.
+    static std::optional<AccountId> parse(std::string_view text);
+
+    // Raw packed representation, for persistence.
+    static constexpr AccountId fromPacked(std::uint64_t packed) { return AccountId(packed); }
+    constexpr std::uint64_t getPacked() const { return value_; }
+
+    constexpr bool isValid() const { return value_ != 0; }
+    constexpr unsigned getTypeCode() const { return static_cast<unsigned>(value_ >> 48); }
+    constexpr unsigned getBranch() const { return static_cast<unsigned>((value_ >> 32) & 0xFFFF); }
+    constexpr std::uint32_t getNumber() const { return static_cast<std::uint32_t>(value_); }
+
+    // Writes exactly kTextLength characters (no terminator) to out.
+    // An invalid ID is written as all spaces.
+    void format(char* out) const;
+
+    // Returns the dashed text form, or an empty string for an invalid ID.
+    std::string toString() const;
+
+    friend constexpr bool operator==(AccountId a, AccountId b) { return a.value_ == b.value_; }
+    friend constexpr bool operator!=(AccountId a, AccountId b) { return a.value_ != b.value_; }
+    friend constexpr bool operator<(AccountId a, AccountId b) { return a.value_ < b.value_; }
+    friend constexpr bool operator>(AccountId a, AccountId b) { return a.value_ > b.value_; }
+    friend constexpr bool operator<=(AccountId a, AccountId b) { return a.value_ <= b.value_; }
+    friend constexpr bool operator>=(AccountId a, AccountId b) { return a.value_ >= b.value_; }
+
+private:
+    constexpr explicit AccountId(std::uint64_t packed) : value_(packed) {}
+
+    std::uint64_t value_ = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, AccountId id);
+
+// --- Bulk conversion routines ---
+// For callers holding many IDs at once (an import chunk, a report chunk). IDs go
+// through in batches of eight: the four-digit groups of a batch are gathered into
+// vectors, one lane per ID, and validated and converted with SSE2 where available;
+// the rest go through the single-ID routines. Results match parse and format exactly.
+
+// Parses count texts into out. Malformed entries produce an invalid AccountId.
+// Returns the number of entries that parsed successfully.
+std::size_t parseAccountIds(const std::string_view* texts, std::size_t count, AccountId* out);
+
+// Formats count IDs back-to-back into out, which must hold count * kTextLength chars.
+void formatAccountIds(const AccountId* ids, std::size_t count, char* out);
+
+} // namespace banking_system
+
+namespace std {
+template <>
+struct hash<banking_system::AccountId> {
+    std::size_t operator()(banking_system::AccountId id) const noexcept {
+        // Fibonacci-style multiplicative mix so that sequential numbers spread across buckets.
+        std::uint64_t x = id.getPacked() * 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>(x ^ (x >> 32));
+    }
+};
+} // namespace std
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Account.hh"
+#include "AccountId.hh"
+
+namespace banking_system {
+
+// File: AccountIdAllocator.hh
+// Purpose: Defines AccountIdAllocator, which hands out account IDs that are unique by
+// construction yet look random. The n-th ID of a type is a keyed permutation of n over
+// that type's branch x account number space (10^4 branches x 9*10^7 eight-digit
+// numbers): a four-round Feistel network on 40 bits, re-applied while the result falls
+// outside the space (about 1.2 applications per ID on average). Different n give
+// different IDs, so allocation is O(1) and never looks for collisions; it fails only
+// once all kCapacity IDs of a type have been handed out.
+class AccountIdAllocator {
+public:
+    static constexpr std::uint32_t kMinNumber = 10000000; // Account numbers have eight digits
+    static constexpr std::uint64_t kNumberSpan = AccountId::kMaxNumber - kMinNumber + 1;
+    static constexpr std::uint64_t kCapacity = (AccountId::kMaxBranch + 1) * kNumberSpan;
+
+    // Allocators with the same key produce the same sequences.
+    explicit AccountIdAllocator(std::uint64_t key);
+
+    // Next ID of type. Throws std::runtime_error once the type's space is exhausted.
+    AccountId next(AccountType type);
+    // The index-th ID of type (index < kCapacity); next() returns index 0, 1, 2, ...
+    AccountId at(AccountType type, std::uint64_t index) const;
+
+    std::uint64_t getAllocated(AccountType type) const { return allocated_[static_cast<std::size_t>(type)]; }
+
+private:
+    static constexpr unsigned kRounds = 4;
+    static constexpr unsigned kHalfBits = 20; // 2^40 >= kCapacity
+
+    std::uint64_t permute(std::uint64_t value, const std::array<std::uint64_t, kRounds>& roundKeys) const;
+
+    std::array<std::array<std::uint64_t, kRounds>, 2> roundKeys_{}; // Per AccountType
+    std::array<std::uint64_t, 2> allocated_{};
+};
+
+} // namespace banking_system
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Account.hh"
+#include "AccountId.hh"
+#include "AppendLog.hh"
+#include "Money.hh"
+
+namespace banking_system {
+
+// File: AccountPool.hh
+// Purpose: Defines AccountPool, the Bank's storage for accounts. Accounts are stored
+// by value, in creation order, in slabs of kSlabSize records (an AppendLog), so the
+// account with slot i is found by two shifts and a scan over all accounts walks
+// memory sequentially. Records never move, so Account pointers stay valid for the
+// life of the pool. Lookups by ID go through an open-addressed table of slot numbers,
+// probed linearly and kept at most half full: four bytes per bucket rather than a
+// heap node per account, and the probe ends on the record it was looking for.
+//
+// Lookups may run concurrently with each other; add and reserve must not run
+// concurrently with anything. The Bank guards its pool with the registry lock.
+class AccountPool {
+public:
+    static constexpr std::size_t kSlabBits = 12;
+    static constexpr std::size_t kSlabSize = std::size_t(1) << kSlabBits;
+
+    // Creates an account with slot size(). Throws std::invalid_argument if the ID is
+    // invalid or already in the pool, or the balance is negative.
+    Account& add(AccountId accountId, AccountType type, const Customer& owner, Money balance);
+    // Makes room in the ID table for count accounts in total.
+    void reserve(std::size_t count);
+
+    // Null if no account has this ID.
+    Account* find(AccountId accountId) const;
+    Account& operator[](std::size_t slot) { return records_[slot]; }
+    const Account& operator[](std::size_t slot) const { return records_[slot]; }
+    std::size_t size() const { return records_.size(); }
+
+private:
+    static constexpr std::size_t kMinBuckets = 1024;
+    static constexpr std::uint32_t kEmpty = 0; // Buckets hold slot + 1
+
+    std::size_t bucketOf(AccountId accountId) const;
+    void rehash(std::size_t bucketCount);
+
+    AppendLog<Account, kSlabBits> records_;
+    std::vector<std::uint32_t> buckets_; // Power-of-two size
+};
+
+} // namespace banking_system
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Account.hh"
+#include "AccountId.hh"
+
+namespace banking_system {
+
+class Bank;
+
+enum class AccountSortKey {
+    ID,
+    OWNER,
+    BALANCE
+};
+
+// File: AccountTableModel.hh
+// Purpose: Defines AccountTableModel, the retained state behind the "All Accounts"
+// table. It keeps one ordered index per sort key, so a table can be sorted by ID, owner
+// or balance and scrolled without sorting anything per frame. Row r of the current
+// order is a single lookup, so a frame only touches the rows it draws.
+//
+// refresh() is meant to be called once per frame. New accounts are read from the
+// creation order (Bank::getAccountsFrom), up to kLoadBudget per call, and merged into
+// every index. Balance changes are found through the ledger: the records added since
+// the last refresh name the accounts whose balances may have moved, and only those are
+// taken out of the balance index and merged back in at their new place. After a burst
+// too large for that to pay off, the balance index is rebuilt instead.
+class AccountTableModel {
+public:
+    static constexpr std::size_t kLoadBudget = std::size_t(1) << 16; // Accounts per refresh
+
+    AccountTableModel() = default;
+
+    AccountTableModel(const AccountTableModel&) = delete;
+    AccountTableModel& operator=(const AccountTableModel&) = delete;
+
+    // Starts following every account of the bank, which must outlive the model or
+    // the next open/close.
+    void open(const Bank& bank);
+    void close(); // Releases the indexes
+
+    // Picks up new accounts and balance changes. Returns true if the rows changed.
+    bool refresh();
+
+    void setSortOrder(AccountSortKey key, bool descending);
+    AccountSortKey getSortKey() const { return sortKey_; }
+    bool isDescending() const { return descending_; }
+
+    bool isOpen() const { return bank_ != nullptr; }
+    bool isLoading() const; // Accounts still to be added
+    std::size_t getRowCount() const { return accounts_.size(); }
+
+    // Account shown in row of the current order. Its balance is read live, so it can
+    // be newer than the order until the next refresh.
+    const Account& getAccount(std::size_t row) const;
+
+private:
+    struct BalanceEntry {
+        std::int64_t cents;  // Balance when the entry was placed
+        std::uint32_t index; // Into accounts_
+    };
+
+    bool addAccounts();
+    bool updateBalances();
+    void rebuildBalanceOrder();
+    bool balanceLess(const BalanceEntry& a, const BalanceEntry& b) const;
+
+    const Bank* bank_ = nullptr;
+    AccountSortKey sortKey_ = AccountSortKey::ID;
+    bool descending_ = false;
+
+    std::vector<const Account*> accounts_; // Creation order
+    std::unordered_map<AccountId, std::uint32_t> indexOf_;
+    std::vector<std::uint32_t> idOrder_;
+    std::vector<std::uint32_t> ownerOrder_; // By owner name, then ID
+    std::vector<BalanceEntry> balanceOrder_; // By balance, then ID
+    std::vector<std::int64_t> placedCents_;  // Key of each account in balanceOrder_
+    std::size_t accountTotal_ = 0;           // Bank's account count at the last refresh
+    std::size_t watermark_ = 0;              // Ledger positions below it are reflected
+
+    // Scratch reused across refreshes.
+    std::vector<std::uint32_t> changed_;
+    std::vector<BalanceEntry> moved_;
+};
+
+} // namespace banking_system
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace banking_system {
+
+// File: AppendLog.hh
+// Purpose: Defines AppendLog, an append-only sequence whose elements never move.
+// Elements live in fixed-size chunks reached through a directory that is allocated
+// once, so appending never relocates existing elements or the directory itself.
+// Any number of threads may append concurrently without a mutex: each reserves an
+// index with an atomic compare-and-swap and constructs its element in place, and
+// indexes are published in reservation order, so size() always covers a fully
+// constructed prefix. Publishing waits for the predecessor to publish, so appends are
+// not lock-free: an appender descheduled mid-construction holds up later ones. Readers
+// may access any index below a size() they observed while appends continue. This is
+// what lets a snapshot be written in the background while the bank keeps recording
+// transactions, and lets concurrent operations append without a shared lock.
+template <typename T, std::size_t ChunkBits = 16, std::size_t DirectoryBits = 16>
+class AppendLog {
+public:
+    static constexpr std::size_t kChunkSize = std::size_t(1) << ChunkBits;
+    static constexpr std::size_t kMaxChunks = std::size_t(1) << DirectoryBits;
+
+    AppendLog() : chunks_(new std::atomic<Chunk*>[kMaxChunks]()) {}
+
+    ~AppendLog() {
+        clear();
+    }
+
+    AppendLog(const AppendLog&) = delete;
+    AppendLog& operator=(const AppendLog&) = delete;
+
+    // Appends a copy of value and returns its index. Element construction must not
+    // throw: a reserved index that is never published would stall later appends.
+    std::size_t push_back(const T& value) {
+        return emplace_back(value);
+    }
+
+    // Throws std::length_error when the log is full; no index is reserved then, so
+    // appends already in flight still publish.
+    template <typename... Args>
+    std::size_t emplace_back(Args&&... args) {
+        std::size_t index = reserved_.load(std::memory_order_relaxed);
+        do {
+            if ((index >> ChunkBits) >= kMaxChunks) {
+                throw std::length_error("AppendLog capacity exhausted.");
+            }
+        } while (!reserved_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+        const std::size_t chunkIndex = index >> ChunkBits;
+        Chunk* chunk = chunks_[chunkIndex].load(std::memory_order_acquire);
+        if (!chunk) {
+            // Racing appenders may both allocate the chunk; the loser frees its copy.
+            Chunk* fresh = new Chunk;
+            if (chunks_[chunkIndex].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+                chunk = fresh;
+            } else {
+                delete fresh;
+            }
+        }
+        new (chunk->bytes + (index & (kChunkSize - 1)) * sizeof(T)) T(std::forward<Args>(args)...);
+
+        // Publish in reservation order. Waiting is short: the predecessor has already
+        // reserved its index and is only constructing its element.
+        for (unsigned spins = 0; size_.load(std::memory_order_acquire) != index; ++spins) {
+            if (spins >= kSpinsBeforeYield) std::this_thread::yield();
+        }
+        size_.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    // Number of fully constructed elements visible to the calling thread.
+    std::size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    const T& operator[](std::size_t index) const {
+        return *std::launder(reinterpret_cast<const T*>(slot(index)));
+    }
+
+    T& operator[](std::size_t index) {
+        return *std::launder(reinterpret_cast<T*>(slot(index)));
+    }
+
+    // Destroys all elements. Not safe while other threads are appending or reading.
+    void clear() {
+        const std::size_t count = size_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            (*this)[i].~T();
+        }
+        for (std::size_t c = 0; c < kMaxChunks; ++c) {
+            Chunk* chunk = chunks_[c].exchange(nullptr, std::memory_order_relaxed);
+            if (!chunk) break;
+            delete chunk;
+        }
+        reserved_.store(0, std::memory_order_relaxed);
+        size_.store(0, std::memory_order_release);
+    }
+
+private:
+    struct Chunk {
+        alignas(T) unsigned char bytes[kChunkSize * sizeof(T)];
+    };
+
+    static constexpr unsigned kSpinsBeforeYield = 64;
+
+    // Callers only pass published indexes; the acquire on size_ that made an index
+    // visible also makes its chunk pointer visible.
+    unsigned char* slot(std::size_t index) const {
+        return chunks_[index >> ChunkBits].load(std::memory_order_relaxed)->bytes +
+               (index & (kChunkSize - 1)) * sizeof(T);
+    }
+
+    std::unique_ptr<std::atomic<Chunk*>[]> chunks_;
+    std::atomic<std::size_t> reserved_{0}; // Next index to hand out
+    std::atomic<std::size_t> size_{0};     // Length of the published prefix
+};
+
+} // namespace banking_system
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Money.hh"
+
+namespace banking_system {
+namespace kernels {
+
+// File: BalanceKernels.hh
+// Purpose: Reduction kernels over contiguous columns of balances in cents.
+// All kernels are exact: each 64-bit value is split into its high and low 32-bit
+// halves and the halves are accumulated separately in 64-bit lanes, which cannot
+// overflow for any realistic column length. The halves are recombined with
+// Money's checked arithmetic, so a total that does not fit throws
+// std::overflow_error instead of silently wrapping. The inner loops use AVX2 or
+// SSE2 when the compiler targets them and fall back to portable scalar code.
+
+// Sum of all count balances.
+Money sumBalances(const std::int64_t* cents, std::size_t count);
+
+// Sum of the balances whose tag equals the given tag (e.g. an account type column).
+Money sumBalancesWhere(const std::int64_t* cents, const std::uint8_t* tags,
+                       std::uint8_t tag, std::size_t count);
+
+// Per-key totals for small dense keys (e.g. branch codes). Returns keyCount totals;
+// keys at or beyond keyCount are ignored.
+std::vector<Money> sumBalancesByKey(const std::int64_t* cents, const std::uint16_t* keys,
+                                    std::size_t count, std::size_t keyCount);
+
+// One band of a tiered rate schedule, for accrueTiered. Bands are contiguous: each
+// starts where the previous one ends.
+struct AccrualTier {
+    std::int64_t floor = 0;         // Lowest balance in the band, in cents
+    std::int64_t width = 0;         // Cents of balance the band spans; ignored for the top band
+    std::uint32_t dailyFactor = 0;  // Daily rate in units of 2^-32
+};
+
+constexpr std::size_t kMaxAccrualTiers = 8;
+
+// One day's tiered interest: the part of a balance inside each band accrues at that
+// band's rate, and out[i] = floor(sum of part * dailyFactor / 2^32) cents over the bands,
+// computed exactly. Entries whose tag differs (when tags is non-null) and non-positive
+// balances accrue 0. tiers are in ascending order; the top band is unbounded. Requires
+// 1 <= tierCount <= kMaxAccrualTiers. Since every factor is below 2^32, an accrual
+// never exceeds its balance and cannot overflow.
+void accrueTiered(const std::int64_t* cents, const std::uint8_t* tags, std::uint8_t tag,
+                  const AccrualTier* tiers, std::size_t tierCount, std::size_t count, std::int64_t* out);
+
+} // namespace kernels
+} // namespace banking_system
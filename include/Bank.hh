@@ -5,20 +5,47 @@
 #include <unordered_map> // Using unordered_map
 #include <memory>
 #include <optional>
-#include <random>
+#include <future>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 
+#include "AppendLog.hh"
 #include "Transaction.hh"
 #include "Customer.hh"
 #include "Account.hh"
+#include "AccountPool.hh"
+#include "AccountId.hh"
+#include "AccountIdAllocator.hh"
+#include "Money.hh"
+#include "Journal.hh"
+#include "LedgerSegments.hh"
+#include "NoteArena.hh"
+#include "ReportJob.hh"
+#include "BatchOperation.hh"
+#include "BulkImport.hh"
+#include "InterestEngine.hh"
+#include "SearchIndex.hh"
+#include "TransactionQuery.hh"
 
 namespace banking_system {
 
 // File: Bank.hh
 // Purpose: Defines the Bank class, the central orchestrator of the banking system.
+//
+// Thread safety: operations may be called from any number of threads. Deposits,
+// withdrawals, transfers and history queries hold the registry lock shared plus the
+// lock stripe of each account they touch, so operations on different accounts run in
+// parallel. Registration, recovery, snapshot cuts and whole-bank totals hold the
+// registry lock exclusively. Journal commits wait for durability after all locks are
+// released, so concurrent operations share group commits. getAllCustomers and
+// getAllAccounts expose the containers themselves and must not be used while
+// customers are being registered; enableJournal must be called before serving.
 class Bank {
 public:
     Bank();
-    ~Bank() = default; // Default destructor is fine
+    ~Bank(); // Waits for a background snapshot that is still being written
 
     // --- Canonical Form: Non-copyable and Non-movable ---
     // By deleting the copy operations, and not declaring move operations,
@@ -32,57 +59,296 @@ public:
 
     // Customer Management
     Customer* registerCustomer(const std::string& name);
+    // Registers every name, for bulk onboarding: containers are sized once and the
+    // journal is committed once. Returns each name's customer, or nullptr where the name
+    // was already taken (also by an earlier entry of names).
+    std::vector<Customer*> registerCustomers(const std::vector<std::string>& names);
     Customer* findCustomer(const std::string& name);
     const Customer* findCustomer(const std::string& name) const;
     const std::vector<std::unique_ptr<Customer>>& getAllCustomers() const;
 
     // Account Management
-    Account* findAccount(const std::string& accountId);
-    const Account* findAccount(const std::string& accountId) const;
-    const std::unordered_map<std::string, std::unique_ptr<Account>>& getAllAccounts() const;
+    Account* findAccount(AccountId accountId);
+    const Account* findAccount(AccountId accountId) const;
+    const AccountPool& getAllAccounts() const; // Indexed by slot, in creation order
     std::vector<Account*> getCustomerAccounts(const std::string& customerName);
     std::vector<const Account*> getCustomerAccounts(const std::string& customerName) const;
+    std::size_t getAccountCount() const;
+    std::size_t getAccountCount(AccountType type) const;
+    // Writes the accounts created from the firstSlot-th on (creation order, as in
+    // Account::getSlot) to out, up to capacity, and returns how many were written.
+    // Accounts are never removed, so a caller can pick up new ones from the count it
+    // has already seen.
+    std::size_t getAccountsFrom(std::size_t firstSlot, const Account** out, std::size_t capacity) const;
+
+    // Search
+    // Up to limit suggestions for a partly typed customer name or account ID, best
+    // first: those that start with the text, ignoring case, then those within a typo or
+    // two of it (see SearchIndex.hh). Account IDs may be typed with or without dashes,
+    // and are suggested with a typo only if none starts with the text. Nothing is
+    // suggested for empty text.
+    std::vector<SearchSuggestion> suggestCustomers(const std::string& text, std::size_t limit) const;
+    std::vector<SearchSuggestion> suggestAccounts(const std::string& text, std::size_t limit) const;
+
+    // Balance Aggregates
+    // Totals by account type are maintained as balances change, so reading them costs
+    // the same for any number of accounts. Branch totals are computed by a vectorized
+    // kernel over the contiguous balance columns. All are exact to the cent.
+    Money getTotalBalance() const;
+    Money getTotalBalance(AccountType type) const;
+    // Reads the same totals under the shared registry lock, so it never stalls
+    // operations but may include one side of a transfer still being applied. Meant for
+    // figures refreshed every frame.
+    Money getLiveTotalBalance(AccountType type) const;
+    std::vector<Money> getBranchTotals() const; // Indexed by branch code (0..9999)
+
+    // Hot Accounts
+    // Switches an account to a sharded balance (see ShardedBalance.hh) so concurrent
+    // credits into it stop serializing on its lock. Accounts are also promoted
+    // automatically once credits to them keep finding their lock taken.
+    bool promoteHotAccount(AccountId accountId);
 
     // Transaction Operations
-    std::optional<Transaction> performDeposit(const std::string& accountId,
-                                              double amount,
+    std::optional<Transaction> performDeposit(AccountId accountId,
+                                              Money amount,
                                               const std::string& note = "");
-    std::optional<Transaction> performWithdraw(const std::string& accountId,
-                                               double amount,
+    std::optional<Transaction> performWithdraw(AccountId accountId,
+                                               Money amount,
                                                const std::string& note = "");
-    std::optional<Transaction> performTransfer(const std::string& srcAccountId,
-                                               const std::string& dstAccountId,
-                                               double amount,
+    std::optional<Transaction> performTransfer(AccountId srcAccountId,
+                                               AccountId dstAccountId,
+                                               Money amount,
                                                const std::string& note = "");
 
+    // Applies many operations under one acquisition of their account locks and waits
+    // for the journal once. Returns one status per operation, in order. The same
+    // validation rules as the single operations apply; nothing is printed per operation.
+    //   ALL_OR_NOTHING: the batch is validated as a unit against each account's net
+    //   effect, so an account may be funded and drawn down within one batch. Either
+    //   every operation is applied or none is.
+    //   BEST_EFFORT: operations are applied in order against running balances, and
+    //   those that fail are skipped.
+    std::vector<BatchStatus> executeBatch(const std::vector<BatchOperation>& operations, BatchMode mode);
+
+    // Bulk Import
+    // Applies import records (see BulkImport.hh) in order under one exclusive registry
+    // lock and waits for the journal once. Returns one status per record; nothing is
+    // logged per record. Transactions keep the records' timestamps, which must not be
+    // earlier than the ledger's latest record, so the ledger stays chronological.
+    std::vector<ImportStatus> importRecords(const std::vector<ImportRecord>& records);
+
+    // End-of-Day Interest
+    // Credits one day's interest, as engine computes it, to every savings account and
+    // records an INTEREST transaction for each that earns at least a cent. Balances are
+    // accrued in one vectorized pass over the balance column and the records applied on
+    // the engine's threads, all under one exclusive registry lock; the records share one
+    // timestamp and the journal is waited for once. Throws std::overflow_error, changing
+    // nothing, if a balance would overflow.
+    InterestRun accrueInterest(const InterestEngine& engine);
+
     // Reporting
+    // Zero-copy reads: the cursor yields pointers to stored records, a page at a time,
+    // restricted to the query's scope, time and position ranges, order, offset and limit
+    // (see TransactionQuery.hh). An unknown customer or account yields an empty cursor.
+    TransactionCursor queryTransactions(const TransactionQuery& query) const;
+
+    // Records in the ledger, read without a lock. Every record below the returned count is seen
+    // by queries made afterwards, so readers can poll it and query the difference.
+    std::size_t getTransactionCount() const;
+
+    // Arena holding the notes of this bank's transactions (see Transaction::getNote).
+    const NoteArena& getNotes() const;
+
+    // Full copies of a scope's history, oldest first. Prefer queryTransactions.
     std::vector<Transaction> getAllTransactionsChronological() const;
     std::vector<Transaction> getCustomerTransactionsChronological(const std::string& customerName) const;
-    std::vector<Transaction> getAccountTransactionsChronological(const std::string& accountId) const;
+    std::vector<Transaction> getAccountTransactionsChronological(AccountId accountId) const;
 
+    // Scope reports are incremental: the ReportJob (see ReportJob.hh) that last wrote a
+    // file appends the records added since its last run and rewrites the totals footer.
+    // The file starts over on a new local day, or when another scope writes the path.
     bool generateGlobalReport(const std::string& filename) const;
     bool generateCustomerReport(const std::string& customerName,
                                 const std::string& filename) const;
-    bool generateAccountReport(const std::string& accountId,
+    bool generateAccountReport(AccountId accountId,
                                const std::string& filename) const;
+    // Reports the records a query selects, e.g. one day's with
+    // TransactionQuery::all().between(dayStart, nextDayStart). Always written in full.
+    bool generateReport(const TransactionQuery& query, const std::string& filename) const;
+
+    // The ledger's daily segments (see LedgerSegments.hh), oldest first. Time-bounded
+    // queries and reports only read the segments their range overlaps.
+    std::vector<LedgerSegment> getLedgerSegments() const;
+
+    // Persistence
+    // Starts writing every customer registration and transaction to an append-only
+    // journal at path; operations return only once their record is as durable as the
+    // journal's sync mode requires. Throws std::runtime_error if the file cannot be opened.
+    void enableJournal(const std::string& path, const JournalOptions& options = JournalOptions());
+    Journal* getJournal() const;
+
+    // Rebuilds an empty Bank from the snapshot at snapshotPath followed by the journal
+    // records at journalPath that are newer than it; either file may be missing. The
+    // journal tail is replayed on replayThreads threads (0 = one per hardware thread),
+    // partitioned by account. Call before enableJournal. Returns false if either file
+    // is corrupt, in which case the Bank holds partial state and must not be used.
+    bool recover(const std::string& snapshotPath, const std::string& journalPath,
+                 unsigned replayThreads = 0);
+
+    // Writes a snapshot of the current state to path (see Snapshot.hh). Only the cut,
+    // a copy of the account columns, is taken on the calling thread; the file is written
+    // on a background thread while operations continue. The future yields false if
+    // writing failed. A snapshot still in progress is waited for before a new one starts.
+    std::shared_future<bool> writeSnapshotAsync(const std::string& path);
 
 private:
     std::vector<std::unique_ptr<Customer>> customers_;
-    std::unordered_map<std::string, std::unique_ptr<Account>> accounts_;
-    std::vector<Transaction> transactions_;
+    AccountPool accounts_; // Slot i holds the account with balanceColumn_[i]
+    // Stable storage: a background snapshot reads records while new ones are appended.
+    AppendLog<Transaction> transactions_;
+    NoteArena notes_; // Text of the notes of transactions_
     std::unordered_map<std::string, Customer*> customerIndex_;
+    // registerCustomers releases the registry lock between chunks of this many customers.
+    static constexpr std::size_t kRegistrationChunk = std::size_t(1) << 16;
+
+    // Column mirror of every account, indexed by Account::getSlot(). Balances are kept
+    // in step with Account::balance_ by setAccountBalance so that whole-bank totals and
+    // snapshot cuts scan only the fields they need, as plain integers.
+    std::vector<std::int64_t> balanceColumn_;
+    std::vector<std::uint8_t> typeColumn_;
+    std::vector<std::uint16_t> branchColumn_;
+    std::vector<std::uint64_t> idColumn_;      // AccountId::getPacked()
+    std::vector<std::uint32_t> ownerColumn_;   // Index into customers_
+    static constexpr std::size_t kAccountTypes = 2;  // AccountType values
+    std::array<std::size_t, kAccountTypes> typeCounts_{}; // Guarded by registryMutex_
+
+    // Posting index, by account slot: the positions in transactions_ of every record
+    // that touches the account (as source or destination), in chronological order.
+    // Maintained by recordTransaction so account history costs O(k), not O(N). The lists
+    // never move, so cursors can keep them after the registry lock is released.
+    AppendLog<std::vector<std::size_t>> accountPostings_;
+
+    // Daily segments of transactions_, extended after every operation that records
+    // transactions (see extendLedgerSegments). Guarded by segmentsMutex_, which is taken
+    // after registryMutex_ and before any account lock, or with no other lock held.
+    mutable LedgerSegments ledgerSegments_;
+    mutable std::mutex segmentsMutex_;
+
+    // Report jobs by normalized file path. A path belongs to the scope that wrote it
+    // last: a report of another scope (or generateReport) to the same path replaces or
+    // drops its job, so no job appends to a file it did not write. At most
+    // kMaxReportJobs are kept; the least recently run is dropped, and its file is
+    // written from scratch if it is reported again. Guarded by reportJobsMutex_; each
+    // job serializes its own runs, and is shared so eviction cannot free a running one.
+    struct ReportJobEntry {
+        std::string scopeKey;
+        std::shared_ptr<ReportJob> job;
+        std::uint64_t lastUse = 0;
+    };
+    static constexpr std::size_t kMaxReportJobs = 64;
+    mutable std::unordered_map<std::string, ReportJobEntry> reportJobs_;
+    mutable std::uint64_t reportJobClock_ = 0;
+    mutable std::mutex reportJobsMutex_;
+
+    // Autocomplete indexes over customer names and account ID digits. Their entries are
+    // numbered like customers_ and account slots. Guarded by registryMutex_.
+    SearchIndex customerSearch_;
+    SearchIndex accountSearch_;
+
+    AccountIdAllocator accountIdAllocator_; // Guarded by registryMutex_
+    bool restoredAccounts_ = false;          // Accounts were recovered or imported with IDs from elsewhere
+
+    std::atomic<std::uint64_t> nextTransactionNumber_{1};
+
+    // --- Concurrency ---
+    // Exclusive while customers or accounts are added or all balances must be read
+    // consistently; shared for operations on individual accounts.
+    mutable std::shared_mutex registryMutex_;
+
+    // Account locks, striped by AccountId hash so the lock table stays small. Each
+    // stripe has its own cache line. Transfers lock both stripes in index order, so
+    // two transfers in opposite directions cannot deadlock.
+    // A stripe also holds the settled balance totals of its accounts by type, kept by
+    // setAccountBalance on the line the writer already owns. They are atomic only
+    // because journal replay updates accounts of one stripe from several partitions.
+    // creditHolder names the account a credit is applying under the stripe lock, so a
+    // contended credit can tell a wait on its own account from a wait on a neighbour.
+    static constexpr std::size_t kLockStripes = 1024;
+    struct alignas(64) LockStripe {
+        std::mutex mutex;
+        std::atomic<const Account*> creditHolder{nullptr};
+        std::array<std::atomic<std::int64_t>, kAccountTypes> typeCents{};
+    };
+    mutable std::array<LockStripe, kLockStripes> lockStripes_;
+
+    // A stripe lock taken by lockCreditTarget. It clears the stripe's creditHolder
+    // before unlocking.
+    class CreditLock {
+    public:
+        CreditLock() = default;
+        CreditLock(LockStripe& stripe, std::unique_lock<std::mutex> lock);
+        CreditLock(CreditLock&& other) noexcept;
+        CreditLock& operator=(CreditLock&& other) noexcept;
+        ~CreditLock();
+
+    private:
+        void release();
+
+        LockStripe* stripe_ = nullptr;
+        std::unique_lock<std::mutex> lock_;
+    };
 
-    std::mt19937 randomEngine_{std::random_device{}()};
-    std::uniform_int_distribution<int> branchDist_;
-    std::uniform_int_distribution<long long> accountNumDist_;
+    // Contention score at which a credited account is promoted to a sharded balance.
+    static constexpr std::uint32_t kHotAccountThreshold = 32;
+    std::vector<Account*> hotAccounts_; // Promoted accounts, for exact totals
+    mutable std::mutex hotAccountsMutex_;
 
-    long long nextTransactionId_ = 1;
+    std::unique_ptr<Journal> journal_; // Null when running purely in memory.
+    std::shared_future<bool> snapshotTask_; // Background snapshot, if one was started.
 
     // Helpers
-    std::string generateUniqueAccountId(AccountType type);
-    std::string generateUniqueTransactionId();
-    void recordTransaction(const Transaction& transaction);
-    bool accountExists(const std::string& accountId) const;
+    std::size_t stripeIndex(AccountId accountId) const;
+    Account* lookupAccount(AccountId accountId) const;   // Caller holds registryMutex_
+    Customer* lookupCustomer(const std::string& name) const;
+    Customer* lookupOwner(AccountId accountId) const;    // Caller holds registryMutex_
+    AccountId generateUniqueAccountId(AccountType type);
+    void reserveRegistry(std::size_t customerCount, std::size_t accountCount); // Room for this many more
+    std::uint64_t generateTransactionNumber();
+    BatchStatus validateBatchOperation(const BatchOperation& operation,
+                                       Account*& source, Account*& destination) const;
+    bool applyNetEffects(const std::vector<BatchOperation>& operations,
+                         const std::vector<Account*>& sources,
+                         const std::vector<Account*>& destinations,
+                         std::vector<BatchStatus>& statuses);
+    void applyInOrder(const std::vector<BatchOperation>& operations,
+                      const std::vector<Account*>& sources,
+                      const std::vector<Account*>& destinations,
+                      std::vector<BatchStatus>& statuses);
+    ImportStatus importCustomer(const ImportRecord& record, std::uint64_t& sequence);
+    ImportStatus importTransaction(const ImportRecord& record, std::chrono::system_clock::time_point& latest,
+                                   std::chrono::system_clock::time_point now, std::uint64_t& sequence);
+    Customer* addCustomer(const std::string& name);
+    void addAccount(AccountType type, AccountId accountId, std::uint32_t ownerIndex, Money balance);
+    void setAccountBalance(Account& account, Money newBalance);
+    Money sumStripeTotals(AccountType type) const;
+    bool adjustBalanceLocked(Account& account, Money delta);
+    CreditLock lockCreditTarget(Account& account);
+    void promoteLocked(Account& account);
+    void addAccountStreams(TransactionCursor& cursor, AccountId accountId,
+                           std::size_t firstPosition, std::size_t lastPosition) const;
+    bool updateReport(const std::string& scopeKey, const TransactionQuery& scope, const std::string& filename) const;
+    void releaseReportPath(const std::string& filename) const;
+    std::uint64_t recordTransaction(const Transaction& transaction,
+                                    std::vector<std::size_t>* destinationPostings = nullptr);
+    void indexTransactions(std::size_t begin, std::size_t end, unsigned threads, bool applyBalances);
+    void extendLedgerSegments() const; // Indexes new records; call with no account lock held
+    void commitJournal(std::uint64_t sequence);
+    void updateCustomerAggregates(const Transaction& transaction);
+    template <typename Visitor>
+    void forEachCustomerEffect(const Transaction& transaction, Visitor&& visit) const;
+    void loadSnapshot(const std::string& path, unsigned threads, std::uint64_t& journalSequence);
+    void replayJournal(const std::string& path, std::uint64_t afterSequence, unsigned threads);
+    bool accountExists(AccountId accountId) const;
     bool customerExists(const std::string& name) const;
 };
 
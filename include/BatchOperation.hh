@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "AccountId.hh"
+#include "Money.hh"
+
+namespace banking_system {
+
+enum class BatchOperationType : std::uint8_t {
+    DEPOSIT,
+    WITHDRAW,
+    TRANSFER
+};
+
+// How Bank::executeBatch treats operations that cannot be applied.
+enum class BatchMode {
+    ALL_OR_NOTHING, // Any failure rejects the whole batch; nothing is applied.
+    BEST_EFFORT     // Operations are applied in order; failing ones are skipped.
+};
+
+// Outcome of one batch operation, one byte each.
+enum class BatchStatus : std::uint8_t {
+    APPLIED,
+    NOT_APPLIED,          // Valid, but the batch was rejected because of another operation
+    ACCOUNT_NOT_FOUND,
+    NOT_CHECKING_ACCOUNT, // Deposits and withdrawals need a checking account
+    INVALID_AMOUNT,
+    SAME_ACCOUNT,
+    TRANSFER_NOT_ALLOWED, // Savings accounts only transfer to their owner's checking account
+    INSUFFICIENT_FUNDS,
+    BALANCE_OVERFLOW
+};
+
+// File: BatchOperation.hh
+// Purpose: Defines BatchOperation, one leg of a batch passed to Bank::executeBatch,
+// together with the batch mode and per-operation status codes. Deposits use only the
+// destination account, withdrawals only the source.
+struct BatchOperation {
+    BatchOperationType type = BatchOperationType::DEPOSIT;
+    AccountId sourceAccountId;
+    AccountId destinationAccountId;
+    Money amount;
+    std::string note;
+
+    static BatchOperation deposit(AccountId accountId, Money amount, const std::string& note = "");
+    static BatchOperation withdraw(AccountId accountId, Money amount, const std::string& note = "");
+    static BatchOperation transfer(AccountId sourceAccountId, AccountId destinationAccountId,
+                                   Money amount, const std::string& note = "");
+};
+
+// Helper function to convert BatchStatus enum to a string.
+std::string batchStatusToString(BatchStatus status);
+
+} // namespace banking_system
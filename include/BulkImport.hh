@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AccountId.hh"
+#include "Money.hh"
+
+namespace banking_system {
+
+class Bank;
+
+enum class ImportRecordType : std::uint8_t {
+    CUSTOMER,
+    BALANCE,  // Opening balance of an account of any type, recorded as a deposit
+    DEPOSIT,
+    WITHDRAW,
+    TRANSFER
+};
+
+// Outcome of applying one import record to a Bank.
+enum class ImportStatus : std::uint8_t {
+    APPLIED,
+    CUSTOMER_EXISTS,
+    ACCOUNT_EXISTS,
+    INVALID_ACCOUNT_ID,   // A customer's IDs are not a savings and a checking ID, or only one is given
+    ACCOUNT_NOT_FOUND,
+    NOT_CHECKING_ACCOUNT, // Deposits and withdrawals need a checking account
+    INVALID_AMOUNT,
+    SAME_ACCOUNT,
+    TRANSFER_NOT_ALLOWED, // Savings accounts only transfer to their owner's checking account
+    INSUFFICIENT_FUNDS,
+    BALANCE_OVERFLOW,
+    OUT_OF_ORDER          // Timestamp before the ledger's latest record, or in the future
+};
+
+// One parsed line of an import, as passed to Bank::importRecords.
+struct ImportRecord {
+    ImportRecordType type = ImportRecordType::DEPOSIT;
+    // CUSTOMER: savings account (invalid = allocate both IDs); TRANSFER: source;
+    // otherwise the account credited or debited.
+    AccountId accountId;
+    // CUSTOMER: checking account; TRANSFER: destination.
+    AccountId secondAccountId;
+    Money amount;                                     // Not used by CUSTOMER
+    std::chrono::system_clock::time_point timestamp;  // Not used by CUSTOMER
+    std::string_view text;                            // CUSTOMER: name; otherwise the note
+};
+
+enum class ImportFormat {
+    CSV,        // Comma-separated; see importFile
+    FIXED_WIDTH // Space-padded columns at the offsets in FixedWidthLayout
+};
+
+// Column offsets of a fixed-width line. Every field but the last is space-padded to
+// its width; the text runs to the end of the line.
+struct FixedWidthLayout {
+    static constexpr std::size_t kKind = 0;             // 1 char
+    static constexpr std::size_t kTimestamp = 1;        // 30 chars
+    static constexpr std::size_t kAccount = 31;         // 19 chars
+    static constexpr std::size_t kSecondAccount = 50;   // 19 chars
+    static constexpr std::size_t kAmount = 69;          // 21 chars
+    static constexpr std::size_t kText = 90;
+};
+
+struct ImportError {
+    std::uint64_t line = 0; // 1-based
+    std::string message;
+};
+
+// Reported on the calling thread after every applied chunk.
+struct ImportProgress {
+    std::uint64_t bytesDone = 0;
+    std::uint64_t bytesTotal = 0;
+    std::uint64_t recordsApplied = 0;
+    std::uint64_t errorCount = 0;
+    double elapsedSeconds = 0.0;
+};
+
+struct ImportOptions {
+    ImportFormat format = ImportFormat::CSV;
+    unsigned threads = 0;                      // Parser threads; 0 = one per hardware thread
+    std::size_t chunkBytes = std::size_t(4) << 20;
+    std::size_t maxReportedErrors = 100;       // Every error is counted; this many are kept
+    std::function<void(const ImportProgress&)> onProgress;
+};
+
+struct ImportReport {
+    std::uint64_t bytes = 0;
+    std::uint64_t lines = 0;
+    std::uint64_t customers = 0;      // Customers registered
+    std::uint64_t transactions = 0;   // Balances, deposits, withdrawals and transfers applied
+    std::uint64_t parseErrors = 0;    // Lines that did not parse
+    std::uint64_t rejected = 0;       // Records the bank refused
+    std::vector<ImportError> errors;  // The first maxReportedErrors, in line order
+    double elapsedSeconds = 0.0;
+
+    std::uint64_t getErrorCount() const { return parseErrors + rejected; }
+};
+
+// File: BulkImport.hh
+// Purpose: Declares importFile, which migrates an existing book of customers, opening
+// balances and historical transactions into a Bank. The file is memory-mapped and cut
+// into chunks at line boundaries; worker threads parse and validate chunks ahead of
+// the calling thread, which applies them strictly in file order through
+// Bank::importRecords, one registry lock and one journal commit per chunk. Historical
+// records keep their own timestamps.
+//
+// One record per line. Blank lines and lines starting with '#' are skipped. CSV lines:
+//   C,<name>[,<savings id>,<checking id>]           customer (IDs allocated if omitted)
+//   B,<timestamp>,<account>,<amount>[,<note>]       opening balance
+//   D,<timestamp>,<account>,<amount>[,<note>]       deposit
+//   W,<timestamp>,<account>,<amount>[,<note>]       withdrawal
+//   T,<timestamp>,<source>,<destination>,<amount>[,<note>]
+// Fields may be double-quoted, with "" for a quote; a field cannot span lines.
+// Fixed-width lines carry the same fields in the FixedWidthLayout columns (a customer
+// leaves the timestamp and amount blank). Timestamps are UTC, "YYYY-MM-DD HH:MM:SS"
+// with an optional 'T' separator, fraction of up to nine digits and trailing 'Z', or
+// whole seconds since the epoch. They must not decrease through the file.
+//
+// Throws std::runtime_error if the file cannot be mapped; malformed lines and records
+// the bank rejects are counted and reported, and the import continues past them.
+ImportReport importFile(Bank& bank, const std::string& path, const ImportOptions& options = ImportOptions());
+
+// Parses a timestamp in the import format. Returns false if it is malformed.
+bool parseImportTimestamp(std::string_view text, std::chrono::system_clock::time_point& timestamp);
+
+// Helper function to convert ImportStatus enum to a string.
+std::string importStatusToString(ImportStatus status);
+
+} // namespace banking_system
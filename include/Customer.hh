@@ -3,6 +3,13 @@
 #include <string>
 #include <vector>
 #include <memory> 
+#include <ctime>
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+
+#include "AccountId.hh"
+#include "Money.hh"
 
 namespace banking_system {
 
@@ -21,14 +28,42 @@ public:
     const std::string& getName() const;
 
     // Returns a list of account IDs associated with this customer.
-    const std::vector<std::string>& getAccountIds() const;
+    const std::vector<AccountId>& getAccountIds() const;
 
     // --- Account Management ---
-    void addAccountId(const std::string& accountId);
+    void addAccountId(AccountId accountId);
+
+    // --- Running aggregates ---
+    // Maintained incrementally by Bank as transactions are recorded, so customer
+    // views never have to re-scan the ledger or re-sum account balances. Held in
+    // atomics: operations on different accounts of one customer update them
+    // concurrently under different account locks.
+    // The balance total is kept modulo 2^64, so recording never fails: a customer's
+    // two accounts each hold at most Money::max(), and their sum always fits. A total
+    // above Money::max() reads as Money::max().
+    Money getTotalBalance() const;
+    std::size_t getTransactionCount() const;
+    std::time_t getLastActivity() const; // 0 if the customer has no transactions yet
+
+    // Applies one recorded transaction to the aggregates.
+    void recordActivity(Money balanceDelta, std::time_t timestamp);
+
+    // Applies several transactions at once, pre-summed (used by parallel recovery).
+    // balanceDeltaCents is the sum of their deltas modulo 2^64 (see addWrapping).
+    void recordActivity(std::uint64_t balanceDeltaCents, std::size_t transactionCount, std::time_t latestTimestamp);
+
+    // Adds a delta to a total kept modulo 2^64, the form the balance total uses.
+    static std::uint64_t addWrapping(std::uint64_t total, Money delta) {
+        return total + static_cast<std::uint64_t>(delta.getCents());
+    }
 
 private:
     std::string name_;                  // Customer's name
-    std::vector<std::string> accountIds_; 
+    std::vector<AccountId> accountIds_; 
+
+    std::atomic<std::uint64_t> totalBalanceCents_{0}; // Modulo 2^64
+    std::atomic<std::size_t> transactionCount_{0};
+    std::atomic<std::time_t> lastActivity_{0};
 };
 
 } 
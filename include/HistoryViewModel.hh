@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ReportWriter.hh"
+#include "Transaction.hh"
+#include "TransactionQuery.hh"
+
+namespace banking_system {
+
+class Bank;
+
+// File: HistoryViewModel.hh
+// Purpose: Defines HistoryViewModel, the retained state behind a transaction history
+// screen. It keeps pointers to the records in a query's scope, oldest first, and
+// formats row text only when a row is asked for, caching the text of recently shown
+// rows. refresh() is meant to be called once per frame. It notices new records by
+// polling Bank::getTransactionCount and queries only the ledger positions added since
+// the last poll. A long history is loaded kLoadBudget records per call, so no frame does
+// more than a bounded amount of work, whether the scope has ten records or ten million.
+class HistoryViewModel {
+public:
+    static constexpr std::size_t kLoadBudget = std::size_t(1) << 16; // Records per refresh
+    static constexpr std::size_t kCachedRows = 256;                  // Formatted rows kept
+
+    HistoryViewModel() = default;
+
+    HistoryViewModel(const HistoryViewModel&) = delete;
+    HistoryViewModel& operator=(const HistoryViewModel&) = delete;
+
+    // Starts following query's scope and time range; its position range, order, offset
+    // and limit are ignored. The bank must outlive the model or the next open/close.
+    void open(const Bank& bank, const TransactionQuery& query);
+    void close(); // Releases the loaded rows
+
+    // Loads up to kLoadBudget records that are not shown yet. Returns true if rows were
+    // added.
+    bool refresh();
+
+    bool isOpen() const { return bank_ != nullptr; }
+    bool isLoading() const { return !pending_.atEnd(); } // Older records still to come
+    std::size_t getRowCount() const { return records_.size(); }
+    const Transaction& getRecord(std::size_t row) const { return *records_[row]; }
+
+    // The row's record in the form of Transaction::toString. The reference stays valid
+    // until the text of another row is requested.
+    const std::string& getRowText(std::size_t row);
+
+private:
+    struct CachedRow {
+        std::size_t row = std::numeric_limits<std::size_t>::max();
+        std::string text;
+    };
+
+    const Bank* bank_ = nullptr;
+    TransactionQuery query_;
+    TransactionCursor pending_;  // Records below watermark_ not loaded yet
+    std::size_t watermark_ = 0;  // Ledger positions below it have been queried
+    std::deque<const Transaction*> records_; // Grows without moving what is loaded
+    std::vector<CachedRow> rowCache_; // Row r lives in slot r % kCachedRows
+    std::optional<TransactionFormatter> formatter_; // Bound to the bank's notes by open()
+    std::vector<char> formatBuffer_;
+};
+
+} // namespace banking_system
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BalanceKernels.hh"
+#include "Money.hh"
+
+namespace banking_system {
+
+// One band of an InterestSchedule: the part of a balance from floor up to the next
+// band's floor accrues at annualRatePpm parts per million a year (50000 = 5%).
+struct InterestTier {
+    Money floor;
+    std::uint32_t annualRatePpm = 0;
+};
+
+// What one Bank::accrueInterest run posted.
+struct InterestRun {
+    std::size_t accountsCredited = 0;
+    Money totalInterest;
+    std::size_t firstPosition = 0; // Its records are at ledger positions
+                                   // [firstPosition, firstPosition + accountsCredited)
+};
+
+// A tiered rate schedule. Rates are marginal, like tax brackets: with bands from $0 at
+// 1% and from $10,000 at 2%, a $15,000 balance earns 1% on $10,000 and 2% on $5,000.
+// Each annual rate is turned into a daily factor in units of 2^-32 (rate / daysPerYear,
+// rounded), and a day's accrual is the exact floor of the parts times their factors,
+// in whole cents; see kernels::accrueTiered. Sub-cent remainders are not carried over.
+class InterestSchedule {
+public:
+    static constexpr std::size_t kMaxTiers = kernels::kMaxAccrualTiers;
+
+    // Throws std::invalid_argument unless there are 1 to kMaxTiers tiers, the first
+    // starts at zero, floors strictly ascend, daysPerYear is 1 to 366 and every daily
+    // rate is below 100%.
+    explicit InterestSchedule(std::vector<InterestTier> tiers, unsigned daysPerYear = 365);
+
+    const std::vector<InterestTier>& getTiers() const { return tiers_; }
+    unsigned getDaysPerYear() const { return daysPerYear_; }
+    const std::vector<kernels::AccrualTier>& getAccrualTiers() const { return accrualTiers_; }
+
+    // One day's interest on balance; 0 for balances that are not positive.
+    Money dailyAccrual(Money balance) const;
+
+private:
+    std::vector<InterestTier> tiers_;
+    unsigned daysPerYear_;
+    std::vector<kernels::AccrualTier> accrualTiers_;
+};
+
+// File: InterestEngine.hh
+// Purpose: Defines InterestEngine, which computes end-of-day interest accruals over a
+// contiguous column of balances in one pass. The column is split into ranges that are
+// accrued on separate threads, each with the vectorized kernels::accrueTiered, so a
+// run over the whole book is bound by memory bandwidth. The engine only computes;
+// Bank::accrueInterest posts the results to the ledger.
+class InterestEngine {
+public:
+    static constexpr std::size_t kMinBalancesPerThread = std::size_t(1) << 16;
+    static constexpr unsigned kMaxThreads = 64;
+
+    // threads = 0 uses one per hardware thread.
+    explicit InterestEngine(InterestSchedule schedule, unsigned threads = 0);
+
+    const InterestSchedule& getSchedule() const { return schedule_; }
+    unsigned getThreads() const { return threads_; }
+
+    // Writes one day's accrual in cents for each of count balances to out; entries
+    // whose tag differs from tag (when tags is non-null) get 0.
+    void accrue(const std::int64_t* cents, const std::uint8_t* tags, std::uint8_t tag,
+                std::size_t count, std::int64_t* out) const;
+
+private:
+    InterestSchedule schedule_;
+    unsigned threads_;
+};
+
+} // namespace banking_system
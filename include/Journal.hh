@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "AccountId.hh"
+#include "Transaction.hh"
+
+namespace banking_system {
+
+// How Journal::waitDurable trades latency for throughput.
+enum class JournalSyncMode {
+    PER_OPERATION, // Every commit writes and fsyncs before returning.
+    GROUP,         // Commits wait for a shared fsync issued by the flusher thread.
+    ASYNC          // Commits return immediately; the flusher syncs in the background.
+};
+
+struct JournalOptions {
+    JournalSyncMode syncMode = JournalSyncMode::GROUP;
+    // GROUP: extra time the flusher holds a batch open so more commits can join it,
+    // i.e. the latency budget traded for fewer fsyncs. With 0 a batch is written as
+    // soon as the previous sync completes; commits arriving during a sync still share
+    // the next one.
+    std::chrono::microseconds groupCommitWindow{0};
+    // ASYNC: interval between background syncs, bounding how much is lost on a crash.
+    std::chrono::microseconds asyncFlushInterval{5000};
+    // A batch is flushed early once this many bytes are pending.
+    std::size_t groupCommitMaxBytes = 1 << 20;
+};
+
+enum class JournalRecordType : std::uint8_t {
+    CUSTOMER_REGISTERED = 1,
+    TRANSACTION = 2
+};
+
+// One decoded journal record, as returned by Journal::readRecords.
+struct JournalRecord {
+    std::uint64_t sequence = 0;
+    JournalRecordType type = JournalRecordType::TRANSACTION;
+
+    // CUSTOMER_REGISTERED
+    std::string customerName;
+    AccountId savingsId;
+    AccountId checkingId;
+
+    // TRANSACTION
+    std::optional<Transaction> transaction;
+};
+
+// File: Journal.hh
+// Purpose: Defines Journal, an append-only binary write-ahead log of everything that
+// changes Bank state. The file starts with an 8-byte header ("MBJ1" + version) followed
+// by records laid out as
+//     u32 payload length | u32 CRC-32 | u64 sequence | u8 record type | payload
+// where the CRC covers the type, payload and sequence, in that order. All integers are
+// little-endian; strings in a payload are a u32 length followed by their bytes. Records are encoded and checksummed by the appending thread before the
+// journal lock is taken; under the lock only the sequence is assigned and folded into
+// the CRC, so concurrent appenders hold it for a few nanoseconds. Appends only go to
+// an in-memory batch; waitDurable decides when the batch reaches the disk according
+// to JournalSyncMode, so several operations can share one fsync (group commit).
+class Journal {
+public:
+    static constexpr std::uint32_t kFormatVersion = 3;
+
+    // Opens (or creates) the journal at path for appending.
+    // Throws std::runtime_error if the file cannot be opened or has a foreign header.
+    explicit Journal(const std::string& path, const JournalOptions& options = JournalOptions());
+
+    // Flushes everything pending and stops the flusher thread.
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // --- Appending ---
+    // Each append returns the record's sequence number without waiting for the disk.
+    std::uint64_t appendCustomerRegistered(const std::string& name, AccountId savingsId, AccountId checkingId);
+    // note is the transaction's note text (see Transaction::getNote).
+    std::uint64_t appendTransaction(const Transaction& transaction, std::string_view note);
+
+    // Blocks until the record with the given sequence is durable, as far as the sync
+    // mode requires (ASYNC never blocks). Throws std::runtime_error if a write failed.
+    void waitDurable(std::uint64_t sequence);
+
+    // Writes and fsyncs everything appended so far, regardless of mode.
+    void flush();
+
+    const std::string& getPath() const;
+    const JournalOptions& getOptions() const;
+    std::uint64_t getLastSequence() const;
+    std::uint64_t getDurableSequence() const;
+    std::uint64_t getSyncCount() const; // Number of fsyncs issued, for tuning group commit.
+
+    // --- Reading ---
+    // Decodes the records of the journal at path whose sequence is greater than
+    // afterSequence, in order. Earlier records are only checksummed, not decoded.
+    // Reading stops at a torn tail. A missing file yields no records. Transaction notes
+    // are stored in notes, the arena of the bank being recovered.
+    // Throws std::runtime_error if the file is not a journal or a record is malformed.
+    static std::vector<JournalRecord> readRecords(const std::string& path, NoteArena& notes,
+                                                  std::uint64_t afterSequence = 0);
+
+private:
+    std::uint64_t append(std::string& record);
+    void writeBatchLocked(std::unique_lock<std::mutex>& lock);
+    void flusherLoop();
+    void throwIfFailedLocked() const;
+
+    std::string path_;
+    JournalOptions options_;
+    int fd_ = -1;
+
+    mutable std::mutex mutex_;
+    std::condition_variable flusherCv_;   // Wakes the flusher when work arrives.
+    std::condition_variable durableCv_;   // Wakes committers when durableSequence_ advances.
+    std::string pending_;                 // Encoded records not yet written.
+    std::chrono::steady_clock::time_point batchOpened_;
+    std::uint64_t lastSequence_ = 0;      // Highest sequence appended.
+    std::uint64_t durableSequence_ = 0;   // Highest sequence written and synced.
+    std::uint64_t syncCount_ = 0;
+    bool writing_ = false;                // A batch is being written outside the lock.
+    bool stopping_ = false;
+    std::string error_;                   // First I/O error, reported to later callers.
+    std::thread flusher_;
+};
+
+} // namespace banking_system
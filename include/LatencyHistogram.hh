@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace banking_system {
+
+// File: LatencyHistogram.hh
+// Purpose: Defines LatencyHistogram, a fixed-size histogram of durations in
+// nanoseconds for the command-line and benchmark tools. Buckets are log-linear: every
+// power of two is split into kSubBuckets equal buckets, so a percentile is reported
+// within 1/kSubBuckets (about 3%) of the true value, from one nanosecond to centuries,
+// and recording is a few instructions with no allocation. Histograms from several
+// threads are combined with merge().
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 5;
+    static constexpr std::size_t kSubBuckets = std::size_t(1) << kSubBucketBits;
+
+    void record(std::uint64_t nanos);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    std::uint64_t getCount() const { return count_; }
+    std::uint64_t getMin() const { return count_ ? min_ : 0; }
+    std::uint64_t getMax() const { return max_; }
+    double getMean() const;
+    // Value at or below which percentile % of the recorded values fall (percentile in
+    // [0, 100]), rounded up to its bucket's bound and capped at getMax(). 0 when empty.
+    std::uint64_t getPercentile(double percentile) const;
+
+private:
+    static constexpr std::size_t kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    static std::size_t bucketOf(std::uint64_t nanos);
+    static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+    std::array<std::uint64_t, kBuckets> counts_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t min_ = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max_ = 0;
+    double sum_ = 0.0;
+};
+
+} // namespace banking_system
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "AccountId.hh"
+#include "AppendLog.hh"
+#include "Transaction.hh"
+
+namespace banking_system {
+
+// Summary of the ledger records of one local calendar day.
+struct LedgerSegment {
+    std::size_t begin = 0; // Ledger positions [begin, end)
+    std::size_t end = 0;
+    std::chrono::system_clock::time_point dayStart;     // Local midnight of the segment's day
+    std::chrono::system_clock::time_point minTimestamp; // Of the records in the segment
+    std::chrono::system_clock::time_point maxTimestamp;
+    bool sealed = false; // A later day has begun; the segment will not change again
+};
+
+// File: LedgerSegments.hh
+// Purpose: Defines LedgerSegments, which partitions the ledger into daily segments,
+// the unit of the per-day report files. The ledger is in time order up to racing
+// clock reads, so each day is a contiguous range of positions. The newest segment is the head; it is sealed when
+// the first record of a later day arrives, and then gets a Bloom filter of the
+// accounts its records touch.
+//
+// Time bounds are resolved against the segment table first, so a search reads records
+// of the one day that holds the bound, not of the whole ledger. The filters tell which
+// sealed days an account is absent from, so a date-range query for an account can
+// skip it without taking its locks. Since sealed segments never change, they are also
+// the unit in which old history could be compacted or moved out of memory.
+//
+// extend() indexes the records appended since the last call; Bank calls it after
+// every append, so a query only catches up on the few records appended since, and
+// the operation that records the first transaction of a day seals the previous one.
+// Not thread-safe; Bank guards its segments with their own mutex.
+//
+// Operations that race stamp their records before appending them, so a record can be
+// stamped a little earlier than one before it. extend() tracks the largest such lag,
+// and positionRange() widens its searches by it, so a time range never loses a record.
+class LedgerSegments {
+public:
+    static constexpr unsigned kBitsPerAccount = 10; // Filter size; about 1% false positives
+    static constexpr unsigned kFilterHashes = 4;
+
+    // Indexes the records at positions [getRecordCount(), count). accountCount bounds
+    // the distinct accounts a sealed segment can touch, which sizes its filter.
+    void extend(const AppendLog<Transaction>& ledger, std::size_t count, std::size_t accountCount);
+    std::size_t getRecordCount() const { return recordCount_; }
+    const std::vector<LedgerSegment>& getSegments() const { return segments_; }
+
+    // Ledger positions [begin, end) below getRecordCount() that hold every record
+    // stamped in [from, to). Records outside it by at most getMaxLag() may be included.
+    std::pair<std::size_t, std::size_t> positionRange(const AppendLog<Transaction>& ledger,
+                                                      std::chrono::system_clock::time_point from,
+                                                      std::chrono::system_clock::time_point to) const;
+    // Largest amount by which a record is stamped earlier than one before it.
+    std::chrono::system_clock::duration getMaxLag() const { return maxLag_; }
+
+    // False only if no record at positions [begin, end) touches accountId, as told by
+    // the filters of the sealed segments overlapping the range.
+    bool mayContain(AccountId accountId, std::size_t begin, std::size_t end) const;
+
+private:
+    void seal(const AppendLog<Transaction>& ledger, std::size_t accountCount);
+    std::size_t firstAtOrAfter(const AppendLog<Transaction>& ledger, std::chrono::system_clock::time_point time) const;
+
+    std::vector<LedgerSegment> segments_;
+    std::vector<std::vector<std::uint64_t>> filters_; // Per sealed segment; power-of-two bit count
+    std::chrono::system_clock::time_point headDayEnd_; // Records from here on start a new segment
+    std::chrono::system_clock::time_point latest_;     // Latest stamp indexed so far
+    std::chrono::system_clock::duration maxLag_{0};
+    std::size_t recordCount_ = 0;
+};
+
+} // namespace banking_system
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "AccountId.hh"
+#include "Money.hh"
+
+// Lowest level whose log statements are compiled in: 0 = debug, 1 = info,
+// 2 = warning, 3 = error. Statements below it expand to nothing.
+#ifndef MINIBANK_MIN_LOG_LEVEL
+    #define MINIBANK_MIN_LOG_LEVEL 0
+#endif
+
+namespace banking_system {
+
+enum class LogLevel : std::uint8_t {
+    DEBUG,
+    INFO,
+    WARNING,
+    ERROR,
+    OFF // Only as a threshold: disables all output
+};
+
+// File: Logger.hh
+// Purpose: Defines Logger, the process-wide asynchronous log. A message is formatted
+// into a stack buffer by LogLine and copied into a fixed-size slot of a lock-free ring
+// (a bounded multi-producer queue with per-slot sequence numbers). A background thread
+// drains the ring, adds the timestamp text and level, and writes the lines to a
+// rotating log file, or to stdout/stderr while no file is open. Producers never block
+// and never touch the file: if the ring is full the message is dropped and counted,
+// and the writer reports the count. Use the MINIBANK_LOG_* macros below rather than
+// LogLine directly, so that disabled levels skip formatting altogether.
+class Logger {
+public:
+    static constexpr std::size_t kSlotSize = 256;
+    static constexpr std::size_t kMaxMessageLength = kSlotSize - 24; // Longer messages are truncated
+    static constexpr std::size_t kCapacity = 4096;                   // Slots; a power of two
+    static constexpr std::size_t kDefaultMaxFileBytes = 16 << 20;
+    static constexpr unsigned kDefaultMaxFiles = 5;
+
+    static Logger& instance();
+
+    // Drains everything already logged and stops the writer thread.
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void setLevel(LogLevel level);
+    LogLevel getLevel() const;
+    bool isEnabled(LogLevel level) const { return level >= level_.load(std::memory_order_relaxed); }
+
+    // Sends subsequent lines to path, appending if it exists. Once the file exceeds
+    // maxBytes it is renamed to path.1 (older files shift up to path.<maxFiles>) and a
+    // new one is started. Throws std::runtime_error if the file cannot be opened.
+    void openFile(const std::string& path, std::size_t maxBytes = kDefaultMaxFileBytes,
+                  unsigned maxFiles = kDefaultMaxFiles);
+    void closeFile(); // Back to stdout/stderr
+
+    // Blocks until every message logged before the call has been written.
+    void flush();
+
+    // Queues one message. Lock-free; returns false if the ring was full.
+    bool publish(LogLevel level, const char* text, std::size_t length);
+
+    std::uint64_t getDroppedCount() const;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        std::int64_t timestampNanos = 0;
+        std::uint16_t length = 0;
+        LogLevel level = LogLevel::INFO;
+        char text[kMaxMessageLength];
+    };
+    static_assert(sizeof(Slot) == kSlotSize, "Log slots must stay one fixed size.");
+
+    Logger();
+
+    void run();
+    void drain();
+    void writeLine(LogLevel level, std::int64_t timestampNanos, const char* text, std::size_t length);
+    void rotate();
+
+    std::atomic<LogLevel> level_{LogLevel::INFO};
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::uint64_t> enqueuePosition_{0};
+    alignas(64) std::atomic<std::uint64_t> writtenPosition_{0}; // Slots handed to the sink
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t dequeuePosition_ = 0; // Writer thread only
+    std::uint64_t droppedReported_ = 0; // Writer thread only
+
+    // Sink state, guarded by sinkMutex_.
+    std::mutex sinkMutex_;
+    std::FILE* file_ = nullptr;
+    std::string filePath_;
+    std::size_t fileBytes_ = 0;
+    std::size_t maxFileBytes_ = kDefaultMaxFileBytes;
+    unsigned maxFiles_ = kDefaultMaxFiles;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;    // Writer: flush requested or stopping
+    std::condition_variable written_; // Flushers: writtenPosition_ advanced
+    bool flushRequested_ = false;
+    bool stopping_ = false;
+    std::thread writer_;
+};
+
+// One log message under construction. Appends text and numbers to a stack buffer
+// without allocating and publishes it to the Logger on destruction.
+class LogLine {
+public:
+    explicit LogLine(LogLevel level) : level_(level) {}
+    ~LogLine() { Logger::instance().publish(level_, buffer_, length_); }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLine& operator<<(const char* text) { return append(std::string_view(text)); }
+    LogLine& operator<<(const std::string& text) { return append(std::string_view(text)); }
+    LogLine& operator<<(std::string_view text) { return append(text); }
+    LogLine& operator<<(char c) { return append(std::string_view(&c, 1)); }
+    LogLine& operator<<(int value) { return appendInteger(static_cast<long long>(value)); }
+    LogLine& operator<<(long value) { return appendInteger(static_cast<long long>(value)); }
+    LogLine& operator<<(long long value) { return appendInteger(value); }
+    LogLine& operator<<(unsigned value) { return appendInteger(static_cast<unsigned long long>(value)); }
+    LogLine& operator<<(unsigned long value) { return appendInteger(static_cast<unsigned long long>(value)); }
+    LogLine& operator<<(unsigned long long value) { return appendInteger(value); }
+    LogLine& operator<<(Money amount);
+    LogLine& operator<<(AccountId accountId);
+
+private:
+    LogLine& append(std::string_view text);
+    LogLine& appendInteger(long long value);
+    LogLine& appendInteger(unsigned long long value);
+
+    LogLevel level_;
+    std::size_t length_ = 0;
+    char buffer_[Logger::kMaxMessageLength];
+};
+
+} // namespace banking_system
+
+// Usage: MINIBANK_LOG_INFO("Deposit to " << accountId << " of $" << amount);
+// The message expression is only evaluated when the level is enabled at run time.
+#define MINIBANK_LOG(level, message)                                      \
+    do {                                                                  \
+        if (::banking_system::Logger::instance().isEnabled(level)) {      \
+            ::banking_system::LogLine(level) << message;                  \
+        }                                                                 \
+    } while (false)
+
+#if MINIBANK_MIN_LOG_LEVEL <= 0
+    #define MINIBANK_LOG_DEBUG(message) MINIBANK_LOG(::banking_system::LogLevel::DEBUG, message)
+#else
+    #define MINIBANK_LOG_DEBUG(message) do {} while (false)
+#endif
+#if MINIBANK_MIN_LOG_LEVEL <= 1
+    #define MINIBANK_LOG_INFO(message) MINIBANK_LOG(::banking_system::LogLevel::INFO, message)
+#else
+    #define MINIBANK_LOG_INFO(message) do {} while (false)
+#endif
+#if MINIBANK_MIN_LOG_LEVEL <= 2
+    #define MINIBANK_LOG_WARNING(message) MINIBANK_LOG(::banking_system::LogLevel::WARNING, message)
+#else
+    #define MINIBANK_LOG_WARNING(message) do {} while (false)
+#endif
+#if MINIBANK_MIN_LOG_LEVEL <= 3
+    #define MINIBANK_LOG_ERROR(message) MINIBANK_LOG(::banking_system::LogLevel::ERROR, message)
+#else
+    #define MINIBANK_LOG_ERROR(message) do {} while (false)
+#endif
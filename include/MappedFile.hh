@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace banking_system {
+
+// File: MappedFile.hh
+// Purpose: Defines MappedFile, a read-only memory mapping of a whole file.
+// Used to load snapshots and scan journals without copying them through stream
+// buffers: the OS pages the file in on demand and the bytes are read in place.
+class MappedFile {
+public:
+    // Maps the file at path. An empty file yields size() == 0 and data() == nullptr.
+    // Throws std::runtime_error if the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const;
+    std::size_t size() const;
+    const std::string& getPath() const;
+
+    // Hints that the whole mapping is about to be read, so the OS can start readahead.
+    void prefetch() const;
+
+private:
+    std::string path_;
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace banking_system
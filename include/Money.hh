@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace banking_system {
+
+// File: Money.hh
+// Purpose: Defines Money, a fixed-point currency amount stored as a signed 64-bit
+// count of cents. Arithmetic is exact and overflow-checked: any operation whose
+// result does not fit throws std::overflow_error instead of wrapping or drifting
+// the way repeated double additions do.
+class Money {
+public:
+    constexpr Money() = default;
+
+    static constexpr Money fromCents(std::int64_t cents) { return Money(cents); }
+
+    // Converts a floating-point amount, rounding to the nearest cent.
+    // Throws std::out_of_range if the value is not finite or does not fit.
+    static Money fromDouble(double amount);
+
+    // Parses a plain decimal amount such as "12", "12.5" or "-12.50".
+    // At most two fractional digits are accepted. Returns std::nullopt if malformed.
+    static std::optional<Money> parse(std::string_view text);
+
+    static constexpr Money zero() { return Money(0); }
+    static constexpr Money max() { return Money(std::numeric_limits<std::int64_t>::max()); }
+
+    constexpr std::int64_t getCents() const { return cents_; }
+    double toDouble() const { return static_cast<double>(cents_) / 100.0; }
+
+    static constexpr std::size_t kMaxTextLength = 21; // "-92233720368547758.08"
+
+    // Formats as "1234.56" (always two decimals, leading '-' when negative).
+    std::string toString() const;
+
+    // Writes the toString() form to out, which must hold kMaxTextLength chars, without
+    // allocating. Returns the number of characters written (no terminator).
+    std::size_t format(char* out) const;
+
+    constexpr bool isZero() const { return cents_ == 0; }
+    constexpr bool isPositive() const { return cents_ > 0; }
+    constexpr bool isNegative() const { return cents_ < 0; }
+
+    // --- Overflow-checked arithmetic ---
+    Money operator+(Money other) const { return Money(checkedAdd(cents_, other.cents_)); }
+    Money operator-(Money other) const { return Money(checkedSub(cents_, other.cents_)); }
+    Money operator-() const { return Money(checkedSub(0, cents_)); }
+    Money& operator+=(Money other) { cents_ = checkedAdd(cents_, other.cents_); return *this; }
+    Money& operator-=(Money other) { cents_ = checkedSub(cents_, other.cents_); return *this; }
+
+    friend constexpr bool operator==(Money a, Money b) { return a.cents_ == b.cents_; }
+    friend constexpr bool operator!=(Money a, Money b) { return a.cents_ != b.cents_; }
+    friend constexpr bool operator<(Money a, Money b) { return a.cents_ < b.cents_; }
+    friend constexpr bool operator>(Money a, Money b) { return a.cents_ > b.cents_; }
+    friend constexpr bool operator<=(Money a, Money b) { return a.cents_ <= b.cents_; }
+    friend constexpr bool operator>=(Money a, Money b) { return a.cents_ >= b.cents_; }
+
+    // Raw checked helpers, shared with the aggregation kernels.
+    static std::int64_t checkedAdd(std::int64_t a, std::int64_t b) {
+        std::int64_t result;
+#if defined(__GNUC__) || defined(__clang__)
+        if (__builtin_add_overflow(a, b, &result)) throwOverflow();
+#else
+        if ((b > 0 && a > std::numeric_limits<std::int64_t>::max() - b) ||
+            (b < 0 && a < std::numeric_limits<std::int64_t>::min() - b)) throwOverflow();
+        result = a + b;
+#endif
+        return result;
+    }
+
+    static std::int64_t checkedSub(std::int64_t a, std::int64_t b) {
+        std::int64_t result;
+#if defined(__GNUC__) || defined(__clang__)
+        if (__builtin_sub_overflow(a, b, &result)) throwOverflow();
+#else
+        if ((b < 0 && a > std::numeric_limits<std::int64_t>::max() + b) ||
+            (b > 0 && a < std::numeric_limits<std::int64_t>::min() + b)) throwOverflow();
+        result = a - b;
+#endif
+        return result;
+    }
+
+private:
+    constexpr explicit Money(std::int64_t cents) : cents_(cents) {}
+
+    [[noreturn]] static void throwOverflow() {
+        throw std::overflow_error("Money arithmetic overflow.");
+    }
+
+    std::int64_t cents_ = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, Money amount);
+
+} // namespace banking_system
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace banking_system {
+
+// File: NoteArena.hh
+// Purpose: Defines NoteArena, the append-only store behind one Bank's transaction
+// notes. A Transaction keeps only a Note, the offset and length of its text in the
+// arena, so records are fixed-size, trivially copyable and position-independent: the
+// same offsets are valid in a snapshot of the arena, which is written and loaded as one
+// image instead of note by note.
+//
+// Offsets address kChunkSize-byte chunks through a directory allocated once, so notes
+// never move and a view handed out stays valid for the life of the arena. A note never
+// crosses a chunk boundary, except a long one, which gets a run of whole chunks of its
+// own. Each thread remembers the last note it stored and hands the same copy out again
+// for an equal note, so the two records of a transfer, and runs of records with a
+// common note, store it once.
+class NoteArena {
+public:
+    static constexpr std::size_t kChunkBits = 16;
+    static constexpr std::size_t kChunkSize = std::size_t(1) << kChunkBits;
+    static constexpr std::size_t kMaxChunks = std::size_t(1) << (32 - kChunkBits); // 4 GiB of offsets
+    static constexpr std::size_t kMaxInlineNote = kChunkSize / 4; // Longer notes get their own chunks
+
+    // Where a note's text lives in the arena. The empty note is {0, 0}.
+    struct Note {
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+    };
+
+    // The extent of the arena at one point in time (see cut()).
+    struct Cut {
+        std::size_t chunks = 0;       // Chunks allocated
+        std::size_t openChunk = 0;    // Chunk small notes were going into
+        std::size_t openChunkUsed = 0; // Bytes of it in use
+    };
+
+    NoteArena();
+
+    NoteArena(const NoteArena&) = delete;
+    NoteArena& operator=(const NoteArena&) = delete;
+
+    // Stores a copy of note. Empty notes are not stored. Thread-safe.
+    // Throws std::length_error once kMaxChunks chunks are in use.
+    Note intern(std::string_view note);
+
+    // Text of a note returned by intern or restored by loadImage.
+    std::string_view view(Note note) const {
+        if (note.length == 0) return {};
+        const char* chunk = chunks_[note.offset >> kChunkBits].load(std::memory_order_relaxed);
+        return std::string_view(chunk + (note.offset & (kChunkSize - 1)), note.length);
+    }
+
+    // --- Images ---
+    // The image of an arena is its chunks back to back, kChunkSize bytes each, so a
+    // note's offset is its position in the image. cut() marks the extent to write;
+    // chunkImage(cut, c) is then safe to read while new notes are stored.
+    Cut cut() const;
+    // Bytes of chunk c that are final at the cut. Shorter than kChunkSize for the open
+    // chunk: the rest of the chunk reads as zeros in the image.
+    std::string_view chunkImage(const Cut& cut, std::size_t c) const;
+    // Restores an image into this arena, which must be empty. imageSize must be a
+    // multiple of kChunkSize. Throws std::length_error if it is too large.
+    void loadImage(const char* image, std::size_t imageSize);
+
+    // Bytes allocated for notes so far.
+    std::size_t getBytesAllocated() const;
+
+private:
+    char* allocateChunks(std::size_t count); // Caller holds mutex_; returns the first
+
+    const std::uint64_t id_; // Tells arenas apart in the per-thread last-note cache
+    std::unique_ptr<std::atomic<char*>[]> chunks_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::size_t chunkCount_ = 0;
+    std::size_t openChunk_ = 0;
+    std::size_t openChunkUsed_ = kChunkSize; // No open chunk yet
+};
+
+} // namespace banking_system
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "ReportWriter.hh"
+#include "TransactionQuery.hh"
+
+namespace banking_system {
+
+class Bank;
+
+// File: ReportJob.hh
+// Purpose: Defines ReportJob, which keeps the report file of one scope (all
+// transactions, a customer or an account) up to date incrementally. The job remembers
+// the ledger count its file was written up to (the high-water mark), where the file's
+// record lines end, the file's size and the running totals of its footer. A later run
+// queries only the positions from the mark on, cuts the old footer off, appends the new
+// lines and writes the new footer, so its cost follows the activity since the last run
+// rather than the size of the history.
+//
+// The file is written from scratch instead when the job has not written it before,
+// when the path changes, when the local day has changed since the file was started
+// (its header carries the date), or when the file's size no longer matches what the
+// job left, meaning someone else has written it. A size check cannot catch a scope
+// that wrote the same path with a file of the same size, so Bank keeps one job per
+// path and replaces it when another scope reports there. Thread-safe; runs of one job
+// are serialized.
+class ReportJob {
+public:
+    // scope is the query whose records the report holds; its position range is
+    // replaced by the job's.
+    explicit ReportJob(TransactionQuery scope);
+
+    ReportJob(const ReportJob&) = delete;
+    ReportJob& operator=(const ReportJob&) = delete;
+
+    // Brings the report at path up to date with bank's ledger and returns the number
+    // of record lines written. Throws std::runtime_error if the file cannot be
+    // written; the next run then writes it from scratch.
+    std::size_t update(const Bank& bank, const std::string& path);
+
+    std::size_t getHighWaterMark() const;
+    ReportTotals getTotals() const;
+
+private:
+    bool canAppend(const std::string& path, std::chrono::system_clock::time_point today) const;
+
+    mutable std::mutex mutex_;
+    TransactionQuery scope_;
+    std::string path_;                          // File of the last run
+    std::chrono::system_clock::time_point day_; // Local day the file was started
+    std::size_t highWaterMark_ = 0;             // Ledger positions below it are in the file
+    std::uint64_t bodyEnd_ = 0;                 // Offset where the footer starts
+    std::uint64_t fileSize_ = 0;                // As the last run left it; 0 if it failed
+    ReportTotals totals_;
+};
+
+} // namespace banking_system
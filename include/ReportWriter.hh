@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Transaction.hh"
+
+namespace banking_system {
+
+// Formats transactions into the one-line form of Transaction::toString, writing into
+// caller-provided memory with std::to_chars instead of streams. The
+// "Time: <date time> | ID: " prefix is cached and only rebuilt when the second
+// changes, so chronological runs of records skip localtime almost entirely. Notes are
+// read from the arena of the bank the records belong to. An instance is not
+// thread-safe; give each thread its own.
+class TransactionFormatter {
+public:
+    // Upper bound on the length of a line, excluding the note.
+    static constexpr std::size_t kMaxFixedLength = 192 + Transaction::kMaxIdLength;
+
+    explicit TransactionFormatter(const NoteArena& notes) : notes_(&notes) {}
+
+    static std::size_t maxLength(const Transaction& transaction) {
+        return kMaxFixedLength + transaction.getNoteRef().length;
+    }
+
+    // Writes the line (no newline) to out, which must hold maxLength(transaction)
+    // chars. Returns the number of chars written.
+    std::size_t format(const Transaction& transaction, char* out);
+    // The same, with the record's account IDs already formatted, e.g. by
+    // formatAccountIds for a run of records: accountTexts holds the texts of its valid
+    // IDs back to back, source first.
+    std::size_t format(const Transaction& transaction, const char* accountTexts, char* out);
+
+private:
+    static constexpr std::size_t kPrefixLength = 32; // "Time: YYYY-MM-DD HH:MM:SS | ID: "
+
+    const NoteArena* notes_;
+    std::time_t cachedSecond_ = -1;
+    char cachedPrefix_[kPrefixLength] = {};
+};
+
+// Running totals of the records in a report, by type: the report's footer line.
+struct ReportTotals {
+    std::size_t records = 0;
+    Money deposits;
+    Money withdrawals;
+    Money transfersOut;
+    Money transfersIn;
+    Money interest;
+
+    void add(const Transaction& transaction);
+};
+
+// File: ReportWriter.hh
+// Purpose: Defines ReportWriter, which writes transaction reports to a file. Records
+// are formatted in chunks of kRecordsPerChunk lines into large reusable buffers, each
+// written with a single sequential write; within a chunk, the account IDs of each
+// kRecordsPerIdBlock records are formatted in one batch. Chunks are formatted on up to
+// `threads` worker threads a few chunks ahead of the writer, while the calling thread
+// writes finished chunks in order, so the output is identical to a sequential run.
+class ReportWriter {
+public:
+    static constexpr std::size_t kRecordsPerChunk = std::size_t(1) << 15;
+    static constexpr unsigned kMaxThreads = 64;
+    // Records whose account IDs are formatted together by one formatAccountIds call.
+    static constexpr std::size_t kRecordsPerIdBlock = 256;
+
+    // Creates (or truncates) the report at path. Throws std::runtime_error on failure.
+    explicit ReportWriter(const std::string& path);
+    // Reopens the report at path to extend it: its first keepBytes bytes are kept,
+    // writing resumes after them, and whatever the new bytes do not overwrite is cut off
+    // by close(). Throws std::runtime_error on failure.
+    ReportWriter(const std::string& path, std::uint64_t keepBytes);
+    ~ReportWriter(); // Closes without reporting errors; call close() to check them
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    void writeText(std::string_view text);
+
+    // Report framing: the "Transaction Report - Generated: <date>" header and its
+    // separator, and the closing separator followed by the totals line.
+    void writeHeader();
+    void writeFooter(const ReportTotals& totals);
+
+    // Bytes in the file so far, counting kept ones.
+    std::uint64_t getSize() const { return size_; }
+
+    // Writes count transactions, one per line, in index order. recordAt(i) returns a
+    // reference to the i-th record that stays valid during the call, and must be safe
+    // to call from several threads at once; notes is the arena of the bank they belong
+    // to. threads = 0 uses one per hardware thread.
+    // Throws std::runtime_error if a write fails.
+    template <typename RecordAt>
+    void writeTransactions(std::size_t count, RecordAt recordAt, const NoteArena& notes, unsigned threads = 0);
+
+    // Flushes and closes the file. Throws std::runtime_error if anything failed to write.
+    void close();
+
+private:
+    template <typename RecordAt>
+    static std::size_t formatChunk(std::size_t first, std::size_t last, RecordAt& recordAt,
+                                   const NoteArena& notes, std::vector<char>& buffer);
+    static unsigned resolveThreads(unsigned threads, std::size_t chunks);
+
+    void open(const char* mode);
+    void write(const char* data, std::size_t bytes);
+
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::uint64_t size_ = 0;
+    std::uint64_t reopenedSize_ = 0; // Length of a reopened file before writing
+};
+
+// --- Template Implementations ---
+template <typename RecordAt>
+std::size_t ReportWriter::formatChunk(std::size_t first, std::size_t last, RecordAt& recordAt,
+                                      const NoteArena& notes, std::vector<char>& buffer) {
+    TransactionFormatter formatter(notes);
+    const Transaction* records[kRecordsPerIdBlock];
+    AccountId ids[2 * kRecordsPerIdBlock];
+    char accountTexts[2 * kRecordsPerIdBlock * AccountId::kTextLength];
+    std::size_t size = 0;
+    for (std::size_t block = first; block < last; block += kRecordsPerIdBlock) {
+        const std::size_t count = std::min(kRecordsPerIdBlock, last - block);
+        std::size_t idCount = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            records[i] = &recordAt(block + i);
+            // Invalid IDs (a deposit's source, a withdrawal's destination) are not printed.
+            ids[idCount] = records[i]->getSourceAccountId();
+            idCount += ids[idCount].isValid();
+            ids[idCount] = records[i]->getDestinationAccountId();
+            idCount += ids[idCount].isValid();
+        }
+        formatAccountIds(ids, idCount, accountTexts);
+
+        const char* texts = accountTexts;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Transaction& transaction = *records[i];
+            const std::size_t needed = TransactionFormatter::maxLength(transaction) + 1;
+            if (buffer.size() - size < needed) {
+                // Buffers are reused across chunks, so growth is rare after the first one.
+                buffer.resize(std::max(buffer.size() * 2, size + needed));
+            }
+            size += formatter.format(transaction, texts, buffer.data() + size);
+            buffer[size++] = '\n';
+            texts += (transaction.getSourceAccountId().isValid() + transaction.getDestinationAccountId().isValid()) *
+                     AccountId::kTextLength;
+        }
+    }
+    return size;
+}
+
+template <typename RecordAt>
+void ReportWriter::writeTransactions(std::size_t count, RecordAt recordAt, const NoteArena& notes, unsigned threads) {
+    const std::size_t chunks = (count + kRecordsPerChunk - 1) / kRecordsPerChunk;
+    threads = resolveThreads(threads, chunks);
+    auto chunkEnd = [count](std::size_t chunk) { return std::min(count, (chunk + 1) * kRecordsPerChunk); };
+
+    if (threads <= 1) {
+        std::vector<char> buffer;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            write(buffer.data(), formatChunk(chunk * kRecordsPerChunk, chunkEnd(chunk), recordAt, notes, buffer));
+        }
+        return;
+    }
+
+    // Sliding window: chunk c formats into buffers[c % window]. Once the writer has
+    // written it, that buffer is handed to chunk c + window, so `threads` chunks are
+    // always being formatted while the writer catches up.
+    const std::size_t window = threads + 1;
+    std::vector<std::vector<char>> buffers(window);
+    std::vector<std::future<std::size_t>> pending(window);
+    auto launch = [&](std::size_t chunk) {
+        pending[chunk % window] = std::async(std::launch::async,
+            [&recordAt, &notes, &chunkEnd, &buffer = buffers[chunk % window], chunk] {
+                return formatChunk(chunk * kRecordsPerChunk, chunkEnd(chunk), recordAt, notes, buffer);
+            });
+    };
+    for (std::size_t chunk = 0; chunk < std::min(window, chunks); ++chunk) {
+        launch(chunk);
+    }
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        const std::size_t size = pending[chunk % window].get();
+        write(buffers[chunk % window].data(), size);
+        if (chunk + window < chunks) launch(chunk + window);
+    }
+}
+
+} // namespace banking_system
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AccountId.hh"
+
+namespace banking_system {
+
+// One entry found by SearchIndex::find.
+struct SearchMatch {
+    std::uint32_t entry = 0; // Number of the entry, in the order entries were added
+    std::uint8_t edits = 0;  // Typos between the query and the entry's closest prefix
+};
+
+// One suggestion from Bank::suggestCustomers or Bank::suggestAccounts.
+struct SearchSuggestion {
+    std::string customerName;
+    AccountId accountId;  // Invalid for customer suggestions
+    unsigned edits = 0;   // Typos between the text and the suggestion
+};
+
+// File: SearchIndex.hh
+// Purpose: Defines SearchIndex, a case-insensitive prefix index with typo tolerance,
+// used by Bank for customer name and account ID suggestions. Keys are lowercased and
+// kept in sorted runs of fixed-size records whose first 24 key bytes are stored
+// inline, so comparisons rarely leave the run. New keys are appended to a small
+// buffer, which is sorted once full and merged like a binary counter, so adding a key
+// costs O(log n) sequential record moves and there are O(log n) runs to search.
+//
+// A sorted run is read as an implicit trie: the keys below a trie node are a range of
+// the run, and its children are found by binary search on the next byte. find walks
+// this trie depth-first, carrying one row of the Damerau-Levenshtein table per level,
+// and cuts every branch whose row exceeds the typo budget. It searches with no typos
+// first and only widens the budget while fewer than limit results were found, so
+// plain prefix queries cost a few binary searches per run. Each typo pass is capped
+// at kMaxVisits nodes, which bounds the cost of a query however dense the keys.
+//
+// Not thread-safe; Bank guards its indexes with the registry lock.
+class SearchIndex {
+public:
+    static constexpr std::size_t kMaxKeyLength = 64; // Longer keys are indexed by this prefix
+    static constexpr unsigned kMaxEdits = 2;
+
+    // Adds key as entry size().
+    void add(std::string_view key);
+    // Makes room for entries more keys.
+    void reserve(std::size_t entries);
+    std::size_t size() const { return entryCount_; }
+
+    // Up to limit entries with a prefix within maxEdits (at most kMaxEdits, and fewer
+    // than the query's length) insertions, deletions, substitutions or adjacent
+    // transpositions of query. Fewest edits first, then in key order. A pass that
+    // allows typos stops after kMaxVisits trie nodes with the matches it has found, so
+    // a long query over densely packed keys may miss some of its farther matches.
+    std::vector<SearchMatch> find(std::string_view query, std::size_t limit, unsigned maxEdits) const;
+
+    // Typo budget suited to a query of length characters: none below three, so short
+    // prefixes stay precise, one up to five and two from six.
+    static unsigned editsFor(std::size_t length);
+
+private:
+    static constexpr std::size_t kInlineWords = 3;
+    static constexpr std::size_t kInlineBytes = 8 * kInlineWords;
+    static constexpr std::size_t kBufferSize = 256;
+    static constexpr std::size_t kScanRange = 4;     // Trie nodes with fewer keys are scanned key by key
+    static constexpr std::size_t kMaxVisits = 2048;  // Rows a typo pass may compute
+
+    struct Record {
+        std::uint64_t words[kInlineWords] = {}; // First key bytes, big-endian, zero-padded
+        std::uint32_t entry = 0;
+        std::uint32_t length = 0;               // Key length
+    };
+    using Run = std::vector<Record>;
+    struct Walk;
+
+    unsigned byteAt(const Record& record, std::size_t depth) const; // 0 past the end of the key
+    bool less(const Record& a, const Record& b) const;
+    void compact();
+    void walk(const Run& run, std::size_t first, std::size_t last, std::size_t depth, Walk& state) const;
+    unsigned advance(std::size_t depth, unsigned byte, Walk& state) const;
+    void collect(const Run& run, std::size_t first, std::size_t last, Walk& state) const;
+
+    // Largest first. The last run is the unsorted buffer until it holds kBufferSize.
+    std::vector<Run> runs_;
+    // Bytes from kInlineBytes on of keys longer than that, at longKeyOffsets_[entry].
+    std::string longKeys_;
+    std::vector<std::uint32_t> longKeyOffsets_;
+    std::uint32_t entryCount_ = 0;
+};
+
+} // namespace banking_system
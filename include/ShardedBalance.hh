@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Money.hh"
+
+namespace banking_system {
+
+// File: ShardedBalance.hh
+// Purpose: Defines ShardedBalance, the split-counter balance of a hot account.
+// Credits land in one of several cache-line-sized shards picked by the calling
+// thread, so concurrent inflows into one account do not serialize on its lock.
+// Everything else (debits, credits that do not fit a shard, exact reads) settles
+// first: with all shards locked, pending credits are folded into the account's
+// settled balance.
+//
+// Overflow is prevented by escrow. At every settle, the headroom between the
+// settled balance and Money::max() is split evenly across the shards. A shard only
+// accepts credits its share can cover, so settled + pending can never exceed the
+// maximum. Overdrafts need no escrow: debits run under the account lock on a settled
+// balance, and pending credits only ever add to it.
+class ShardedBalance {
+public:
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::atomic<std::int64_t> credited{0}; // Pending credits in cents, written under mutex
+        std::int64_t headroom = 0;             // Escrowed cents this shard may still credit
+        std::vector<std::size_t> postings;     // Ledger positions of credits taken here
+    };
+
+    // Splits the headroom above settledCents across one shard per hardware thread.
+    explicit ShardedBalance(std::int64_t settledCents);
+
+    ShardedBalance(const ShardedBalance&) = delete;
+    ShardedBalance& operator=(const ShardedBalance&) = delete;
+
+    // The shard assigned to the calling thread.
+    Shard& localShard();
+
+    // Adds amount to the shard if its escrow covers it; the caller holds shard.mutex.
+    bool tryCredit(Shard& shard, Money amount);
+
+    // With every shard locked: moves pending credits into settledCents, applies
+    // deltaCents if the result stays within [0, Money::max()], and re-escrows the
+    // remaining headroom. Returns false if deltaCents was rejected; pending credits
+    // are folded in either way. The caller holds the account lock.
+    bool settle(std::int64_t& settledCents, std::int64_t deltaCents);
+
+    // Sum of credits not yet settled. Lock-free and may lag credits in flight.
+    Money getPendingCredits() const;
+
+    std::size_t getShardCount() const;
+    // Readers of a shard's postings lock its mutex; each list is in ledger order.
+    Shard& getShard(std::size_t index) const;
+
+private:
+    void escrowLocked(std::int64_t settledCents);
+
+    std::size_t shardCount_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace banking_system
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "MappedFile.hh"
+
+namespace banking_system {
+
+// File: Snapshot.hh
+// Purpose: Defines the on-disk snapshot format and its writer and reader.
+// A snapshot is a point-in-time image of a Bank: customers, accounts with their
+// balances, and the full transaction log, tagged with the last journal sequence it
+// reflects so recovery can replay only the journal tail after it.
+//
+// Layout (little-endian, every section 64-byte aligned):
+//     SnapshotHeader | SnapshotSection[kSectionCount] | customers | accounts | transactions | notes | strings
+// Sections are arrays of fixed-size POD records, so a mapped snapshot is validated
+// with one CRC-32 per section and then read in place. Customer names live in the
+// strings section and are referenced by offset and length; transaction notes keep their
+// NoteArena offsets, and the notes section is the arena's image.
+
+enum class SnapshotSectionKind : std::uint32_t {
+    CUSTOMERS = 0,
+    ACCOUNTS = 1,
+    TRANSACTIONS = 2,
+    NOTES = 3,
+    STRINGS = 4
+};
+
+struct SnapshotHeader {
+    char magic[8];                  // "MBSNAP\0\0"
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;    // 0x01020304 as written by the producing host
+    std::uint64_t journalSequence;  // Last journal record reflected in this snapshot
+    std::uint64_t nextTransactionId;
+    std::uint64_t createdAtNanos;   // Wall clock when the snapshot was cut
+    std::uint32_t sectionCount;
+    std::uint32_t headerCrc;        // CRC-32 of header (with this field zero) and section table
+    std::uint8_t reserved[16];
+};
+
+struct SnapshotSection {
+    std::uint64_t offset;           // From the start of the file
+    std::uint64_t bytes;
+    std::uint64_t count;            // Number of records (bytes for NOTES and STRINGS)
+    std::uint32_t crc;
+    std::uint32_t kind;             // SnapshotSectionKind
+};
+
+struct SnapshotCustomer {
+    std::uint64_t nameOffset;       // Into the strings section
+    std::uint32_t nameLength;
+    std::uint32_t reserved;
+};
+
+struct SnapshotAccount {
+    std::uint64_t id;               // AccountId::getPacked()
+    std::int64_t balanceCents;
+    std::uint32_t ownerIndex;       // Into the customers section
+    std::uint8_t type;              // AccountType
+    std::uint8_t reserved[3];
+};
+
+struct SnapshotTransaction {
+    std::uint64_t number;           // Numeric part of the "T<n>" transaction ID
+    std::int64_t amountCents;
+    std::uint64_t sourceId;
+    std::uint64_t destinationId;
+    std::int64_t timestampNanos;    // Since the system_clock epoch
+    std::uint64_t noteOffset;       // Into the notes section
+    std::uint32_t noteLength;
+    std::uint8_t type;              // TransactionType
+    std::uint8_t reserved[3];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "Snapshot header layout changed");
+static_assert(sizeof(SnapshotSection) == 32, "Snapshot section layout changed");
+static_assert(sizeof(SnapshotCustomer) == 16, "Snapshot customer layout changed");
+static_assert(sizeof(SnapshotAccount) == 24, "Snapshot account layout changed");
+static_assert(sizeof(SnapshotTransaction) == 56, "Snapshot transaction layout changed");
+
+// Streams a snapshot to "<path>.tmp" and atomically renames it over path on commit,
+// so a crash mid-write never replaces the previous snapshot with a partial one.
+// Sections are written in SnapshotSectionKind order; strings are collected in memory
+// by addString and written last. All failures throw std::runtime_error.
+class SnapshotWriter {
+public:
+    static constexpr std::uint32_t kFormatVersion = 2;
+    static constexpr std::uint32_t kSectionCount = 5;
+
+    explicit SnapshotWriter(const std::string& path);
+    ~SnapshotWriter(); // Removes the temporary file unless committed
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    void beginSection(SnapshotSectionKind kind);
+    void appendRecords(const void* records, std::size_t bytes, std::size_t count);
+    void endSection();
+
+    // Appends text to the strings section and returns its offset there.
+    std::uint64_t addString(std::string_view text);
+
+    // Writes the strings section, header and section table, syncs and renames.
+    void commit(std::uint64_t journalSequence, std::uint64_t nextTransactionId, std::uint64_t createdAtNanos);
+
+private:
+    void write(const void* data, std::size_t bytes);
+    void padToAlignment();
+
+    std::string path_;
+    std::string tempPath_;
+    std::FILE* file_ = nullptr;
+    std::uint64_t offset_ = 0;
+    SnapshotSection sections_[kSectionCount] = {};
+    SnapshotSection* current_ = nullptr;
+    std::uint32_t nextKind_ = 0;
+    std::string strings_;
+    bool committed_ = false;
+};
+
+// Maps a snapshot and validates its header, bounds and section checksums (the
+// per-section CRCs run in parallel). Records are then read straight from the mapping.
+// Throws std::runtime_error if the file is missing, foreign, truncated or corrupt.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::string& path);
+
+    const SnapshotHeader& getHeader() const;
+
+    const SnapshotCustomer* getCustomers() const;
+    std::size_t getCustomerCount() const;
+    const SnapshotAccount* getAccounts() const;
+    std::size_t getAccountCount() const;
+    const SnapshotTransaction* getTransactions() const;
+    std::size_t getTransactionCount() const;
+
+    // Text referenced by a record. Throws std::runtime_error if out of bounds.
+    std::string_view getString(std::uint64_t offset, std::uint32_t length) const;
+    // The NoteArena image transaction notes are offsets into.
+    std::string_view getNoteImage() const;
+
+private:
+    const unsigned char* sectionData(SnapshotSectionKind kind) const;
+    std::size_t sectionCount(SnapshotSectionKind kind) const;
+
+    MappedFile file_;
+    SnapshotHeader header_;
+    SnapshotSection sections_[SnapshotWriter::kSectionCount];
+};
+
+} // namespace banking_system
@@ -1,53 +1,91 @@
-#pragma once 
+#pragma once
 
 #include <string>
-#include <chrono> 
-#include <ctime>  
+#include <string_view>
+#include <optional>
+#include <chrono>
+#include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "AccountId.hh"
+#include "Money.hh"
+#include "NoteArena.hh"
 
 namespace banking_system {
 
-enum class TransactionType {
+enum class TransactionType : std::uint8_t {
     DEPOSIT,
     WITHDRAWAL,
     TRANSFER_OUT, // From the perspective of the source account
-    TRANSFER_IN   // From the perspective of the destination account
+    TRANSFER_IN,  // From the perspective of the destination account
+    INTEREST      // Accrued interest credited to the destination account
 };
 
 // File: Transaction.hh
 // Purpose: Defines the Transaction class, which represents a single financial transaction.
 // It stores details like ID, type, amount, involved accounts, timestamp, and an optional note.
+// A Transaction is a fixed-size, trivially copyable record: the ID is kept as its number
+// (the text form is "T<number>"), and the note is an offset and length into the owning
+// Bank's NoteArena (see NoteArena.hh), so creating, copying and storing records never
+// allocates, and a record means the same wherever it is copied to.
 class Transaction {
 public:
+    static constexpr std::size_t kMaxIdLength = 21; // "T" and up to 20 digits
+
     // Constructor: Initializes a Transaction object.
-    Transaction(const std::string& transactionId,
+    Transaction(std::uint64_t number,
+                TransactionType type,
+                Money amount,
+                AccountId sourceAccountId,      // Invalid (default) for deposits
+                AccountId destinationAccountId, // Invalid (default) for withdrawals
+                NoteArena::Note note = {});     // Optional note, stored in the bank's arena
+
+    // Creates a transaction with an explicit timestamp: restoring a recorded one
+    // (snapshot loading, journal replay) or stamping a whole batch with one clock read.
+    Transaction(std::uint64_t number,
                 TransactionType type,
-                double amount,
-                const std::string& sourceAccountId,      // Can be empty for deposits
-                const std::string& destinationAccountId, // Can be empty for withdrawals
-                const std::string& note = "");           // Optional note for the transaction
+                Money amount,
+                AccountId sourceAccountId,
+                AccountId destinationAccountId,
+                NoteArena::Note note,
+                std::chrono::system_clock::time_point timestamp);
 
     // --- Getters for transaction details ---
-    const std::string& getTransactionId() const;
-    TransactionType getType() const;
-    double getAmount() const;
-    const std::string& getSourceAccountId() const;
-    const std::string& getDestinationAccountId() const;
-    const std::string& getNote() const;
+    std::uint64_t getNumber() const { return number_; }
+    std::string getTransactionId() const; // "T<number>"
+    // Writes the ID to out, which must hold kMaxIdLength chars. Returns its length.
+    std::size_t formatTransactionId(char* out) const;
+    TransactionType getType() const { return type_; }
+    Money getAmount() const { return amount_; }
+    AccountId getSourceAccountId() const { return sourceAccountId_; }
+    AccountId getDestinationAccountId() const { return destinationAccountId_; }
+    // Text of the note, read from the arena of the bank the record belongs to.
+    std::string_view getNote(const NoteArena& notes) const { return notes.view(note_); }
+    NoteArena::Note getNoteRef() const { return note_; }
     std::time_t getTimestamp() const; // Returns a std::time_t timestamp
+    std::chrono::system_clock::time_point getTimePoint() const { return timestamp_; } // Full-resolution timestamp
 
     // Formats the transaction details into a human-readable string.
-    std::string toString() const;
+    std::string toString(const NoteArena& notes) const;
 
 private:
-    std::string transactionId_;
-    TransactionType type_;
-    double amount_;
-    std::string sourceAccountId_;
-    std::string destinationAccountId_;
-    std::string note_;
+    std::uint64_t number_;
+    Money amount_;
+    AccountId sourceAccountId_;
+    AccountId destinationAccountId_;
     std::chrono::system_clock::time_point timestamp_; // High-resolution timestamp
+    NoteArena::Note note_;                            // In the bank's NoteArena
+    TransactionType type_;
 };
 
+static_assert(std::is_trivially_copyable<Transaction>::value, "Transaction must stay a plain record");
+static_assert(sizeof(Transaction) <= 64, "Transaction must fit in a cache line");
+
+// Number of a "T<number>" transaction ID, or std::nullopt if the text is not one.
+std::optional<std::uint64_t> parseTransactionId(std::string_view transactionId);
+
 // Helper function to convert TransactionType enum to a string.
 std::string transactionTypeToString(TransactionType type);
 
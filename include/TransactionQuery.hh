@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AccountId.hh"
+#include "AppendLog.hh"
+#include "Transaction.hh"
+
+namespace banking_system {
+
+enum class QueryOrder {
+    OLDEST_FIRST,
+    NEWEST_FIRST
+};
+
+// What Bank::queryTransactions should return. Build one with all(), forCustomer() or
+// forAccount() and narrow it with the chained setters.
+struct TransactionQuery {
+    enum class Scope { ALL, CUSTOMER, ACCOUNT };
+
+    Scope scope = Scope::ALL;
+    std::string customerName; // CUSTOMER
+    AccountId accountId;      // ACCOUNT
+    // Half-open time range [from, to).
+    std::chrono::system_clock::time_point from = std::chrono::system_clock::time_point::min();
+    std::chrono::system_clock::time_point to = std::chrono::system_clock::time_point::max();
+    // Half-open range of ledger positions [firstPosition, lastPosition), counted as in
+    // Bank::getTransactionCount. Lets a reader pick up only the records added since it
+    // last looked.
+    std::size_t firstPosition = 0;
+    std::size_t lastPosition = std::numeric_limits<std::size_t>::max();
+    QueryOrder order = QueryOrder::OLDEST_FIRST;
+    std::size_t offset = 0; // Records skipped, counted in iteration order
+    std::size_t limit = std::numeric_limits<std::size_t>::max();
+
+    static TransactionQuery all();
+    static TransactionQuery forCustomer(const std::string& customerName);
+    static TransactionQuery forAccount(AccountId accountId);
+
+    TransactionQuery& between(std::chrono::system_clock::time_point rangeFrom,
+                              std::chrono::system_clock::time_point rangeTo);
+    TransactionQuery& positions(std::size_t first, std::size_t last);
+    TransactionQuery& newestFirst();
+    TransactionQuery& page(std::size_t pageOffset, std::size_t pageLimit);
+};
+
+// File: TransactionQuery.hh
+// Purpose: Defines TransactionQuery and TransactionCursor, the zero-copy read path over
+// the ledger. A cursor yields pointers to the stored records, which never move, so
+// reading a page copies nothing but the pointers. It is bounded when it is created:
+// records appended later are not returned, however long the cursor is kept.
+//
+// A cursor walks one or more streams of ledger positions: the whole ledger, or the
+// posting lists of the accounts in scope (a customer's accounts, plus the shard lists
+// of hot accounts). Several streams are merged in ledger order, and a record posted
+// to two streams (a transfer between a customer's own accounts) is returned once.
+// Posting lists keep growing while a cursor reads them, so each read takes the lock
+// that guards the list for the length of the read only. A single stream copies a page
+// per acquisition; merged streams copy up to kPositionsPerLock positions each into a
+// per-stream buffer, and the merge runs on the buffers.
+//
+// Time ranges are found by binary search, which relies on the ledger being ordered by
+// timestamp. That holds up to the clock reads of operations that race each other: a
+// record may be stamped up to LedgerSegments::getMaxLag() (microseconds) before one
+// recorded ahead of it. The search is widened by that lag, so a range never misses a
+// record stamped inside it, but may include records stamped within the lag outside it.
+class TransactionCursor {
+public:
+    TransactionCursor() = default; // Yields nothing
+
+    // Writes up to capacity records to out, in the query's order, and returns how many
+    // were written; 0 once the cursor is exhausted. Calling again resumes where the
+    // previous call stopped.
+    std::size_t next(const Transaction** out, std::size_t capacity);
+
+    bool atEnd() const;
+
+    // Records still to be returned; an upper bound when streams are merged, since
+    // records shared by two streams are counted twice. Constant time.
+    std::size_t remainingUpperBound() const;
+
+private:
+    friend class Bank;
+
+    static constexpr std::size_t kPositionsPerLock = 64;
+
+    struct Stream {
+        const std::vector<std::size_t>* positions = nullptr; // Null: the ledger itself
+        std::mutex* mutex = nullptr;                         // Guards *positions
+        std::size_t begin = 0;                               // Unread range of *positions
+        std::size_t end = 0;
+        std::size_t head = 0;                                // Merge scratch: position at the read end
+        // Merge reads of a posting list: positions taken from the read end of
+        // [begin, end), in read order, and not returned yet.
+        std::size_t bufferNext = 0;
+        std::size_t bufferEnd = 0;
+        std::array<std::size_t, kPositionsPerLock> buffer = {};
+    };
+    static constexpr std::size_t kInlineStreams = 2;
+
+    void addStream(const Stream& stream);
+    Stream* streams();
+    const Stream* streams() const;
+    static bool exhausted(const Stream& stream);
+    bool fillBuffer(Stream& stream);
+    bool nextPosition(std::size_t& position);
+    std::size_t readSingle(Stream& stream, const Transaction** out, std::size_t capacity);
+    void skip(std::size_t count);
+
+    const AppendLog<Transaction>* ledger_ = nullptr;
+    QueryOrder order_ = QueryOrder::OLDEST_FIRST;
+    std::size_t remaining_ = 0; // Limit left
+    std::size_t streamCount_ = 0;
+    std::array<Stream, kInlineStreams> inlineStreams_; // Accounts and typical customers
+    std::vector<Stream> moreStreams_;                  // Hot accounts' shard lists
+};
+
+} // namespace banking_system
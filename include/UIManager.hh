@@ -5,6 +5,12 @@
 #include <string>
 #include <vector>
 
+#include "AccountId.hh"
+#include "AccountTableModel.hh"
+#include "HistoryViewModel.hh"
+#include "Money.hh"
+#include "SearchIndex.hh"
+
 // declarations for classes used by UIManager
 namespace banking_system {
     class Bank;
@@ -60,7 +66,7 @@ private:
     bool searchCustomerNameEditMode_ = false;
     std::string currentCustomerName_ = "";
     Customer* currentCustomer_ = nullptr;
-    std::string currentAccountId_ = "";
+    AccountId currentAccountId_;
     Account* currentAccount_ = nullptr;
     char amountInput_[32] = {0};
     bool amountEditMode_ = false;
@@ -68,12 +74,20 @@ private:
     bool destinationAccountEditMode_ = false;
     char noteInput_[128] = {0};
     bool noteEditMode_ = false;
-    float transactionAmount_ = 0.0f;
+    Money transactionAmount_;
     int listViewScrollIndex_ = 0;
     int listViewActive_ = -1;
     std::string messageTitle_ = "";
     std::string messageText_ = "";
     ScreenState messageReturnState_ = ScreenState::MAIN_MENU;
+    HistoryViewModel historyView_;   // Open while a transaction history screen is shown
+    std::string historyTitle_ = "";
+    AccountTableModel accountTable_; // Open while the "All Accounts" screen is shown
+    // Live suggestions under the customer search or transfer destination box while it is
+    // edited, looked up again only when its text changes.
+    std::vector<SearchSuggestion> suggestions_;
+    std::string suggestionsText_ = "";
+    static constexpr std::size_t kSuggestionLimit = 6;
 
     void drawMainMenu();
     void drawRegisterCustomer();
@@ -86,9 +100,12 @@ private:
     void drawWithdrawView();
     void drawTransferView();
     void drawViewAllAccounts();
-    void drawTransactionHistory(const std::string& title, const std::vector<Transaction>& transactions, ScreenState returnState);
+    void drawTransactionHistory(ScreenState returnState);
     void drawTransactionHistoryWrapper();
     void drawMessageBox();
+    void refreshSuggestions(const char* text, bool accounts);
+    Rectangle suggestionBounds(Rectangle inputBounds) const;
+    int drawSuggestions(Rectangle bounds);
 
     bool processInput();
     void changeState(ScreenState newState);
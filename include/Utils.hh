@@ -2,6 +2,10 @@
 
 #include <string>
 #include <chrono> 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
 
 namespace banking_system {
 namespace utils { 
@@ -9,9 +13,22 @@ namespace utils {
 // File: Utils.hh
 // Purpose: Defines a namespace 'utils' containing miscellaneous utility functions
 // that can be used across the banking system application.
-// Currently, it includes a function to get the current date as a string.
+// Currently, it includes a function to get the current date as a string, local
+// calendar day helpers and a CRC-32 checksum used to validate persisted records.
 
     std::string getCurrentDateString();
 
+    // Start of the local calendar day containing time, and of the day after it.
+    std::chrono::system_clock::time_point localDayStart(std::chrono::system_clock::time_point time);
+    std::chrono::system_clock::time_point nextLocalDayStart(std::chrono::system_clock::time_point time);
+
+    // Start of the local day written as YYYY-MM-DD (the form of getCurrentDateString).
+    // Returns std::nullopt if the text is not such a date.
+    std::optional<std::chrono::system_clock::time_point> parseLocalDate(std::string_view text);
+
+    // CRC-32 (IEEE 802.3 polynomial) of length bytes. Pass a previous result as
+    // seed to checksum data that arrives in several pieces.
+    std::uint32_t crc32(const void* data, std::size_t length, std::uint32_t seed = 0);
+
 }
 } 
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace banking_system {
+
+enum class TraceOperationType : std::uint8_t {
+    DEPOSIT = 1,
+    WITHDRAW = 2,
+    TRANSFER = 3
+};
+
+// One recorded operation. Accounts are named by customer index, because account IDs
+// are drawn at random when customers register: the operation uses the checking
+// account of customer source (and of customer destination for a transfer).
+struct TraceOperation {
+    std::uint64_t offsetNanos = 0; // Arrival time since the start of the trace
+    std::uint32_t source = 0;
+    std::uint32_t destination = 0; // TRANSFER only
+    std::int64_t cents = 0;        // Positive
+    TraceOperationType type = TraceOperationType::DEPOSIT;
+};
+
+// The population an operation stream runs against. Replaying a trace first registers
+// customerCount customers, named namePrefix followed by their index, and deposits
+// initialDepositCents into each checking account.
+struct TraceHeader {
+    std::uint64_t customerCount = 0;
+    std::int64_t initialDepositCents = 0;
+    std::uint64_t seed = 0; // Of the generator, for the record
+    std::string namePrefix = "customer";
+    std::uint64_t operationCount = 0; // Set by WorkloadTraceWriter::finish
+};
+
+struct WorkloadTrace {
+    TraceHeader header;
+    std::vector<TraceOperation> operations;
+};
+
+// File: WorkloadTrace.hh
+// Purpose: Defines the workload trace format used by the bank_workload tool to record
+// an operation stream and replay it exactly. A trace is the header above followed by
+// variable-length records, eight to ten bytes per operation:
+//   u8 type | varint arrival delta (ns) | varint source | [varint destination] | varint cents
+// and a CRC-32 of the records. Integers in the header are little-endian; varints are
+// LEB128. The writer streams records, so a trace of any length takes constant memory to
+// produce.
+class WorkloadTraceWriter {
+public:
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    // Creates (or truncates) path and writes the header. Throws std::runtime_error if
+    // the file cannot be written.
+    WorkloadTraceWriter(const std::string& path, const TraceHeader& header);
+    ~WorkloadTraceWriter(); // Closes the file; call finish() first to keep the trace
+
+    WorkloadTraceWriter(const WorkloadTraceWriter&) = delete;
+    WorkloadTraceWriter& operator=(const WorkloadTraceWriter&) = delete;
+
+    // Operations must be appended in arrival order.
+    void append(const TraceOperation& operation);
+    // Writes the checksum and the operation count. Returns false on a write error.
+    bool finish();
+
+    std::uint64_t getOperationCount() const { return operationCount_; }
+    std::uint64_t getBytesWritten() const { return bytesWritten_ + buffer_.size(); }
+
+private:
+    bool flushBuffer();
+
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::string buffer_;
+    std::uint32_t crc_ = 0;
+    std::uint64_t lastOffsetNanos_ = 0;
+    std::uint64_t operationCount_ = 0;
+    std::uint64_t bytesWritten_ = 0;
+    bool failed_ = false;
+};
+
+// Reads a whole trace into memory. Throws std::runtime_error if the file cannot be
+// read, is not a trace, or fails its checksum.
+WorkloadTrace readWorkloadTrace(const std::string& path);
+
+// Name of customer index in a trace with header.
+std::string traceCustomerName(const TraceHeader& header, std::uint64_t index);
+
+} // namespace banking_system
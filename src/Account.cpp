@@ -1,68 +1,71 @@
 #include "Account.hh"
-#include <stdexcept> 
-#include <limits>    
-#include <iostream>  
+#include "Customer.hh"
+#include "ShardedBalance.hh"
+#include "Logger.hh"
+#include <stdexcept>
 
 namespace banking_system {
 
 // Constructor implementation
-Account::Account(const std::string& accountId, const std::string& ownerName, double initialBalance)
-    : accountId_(accountId), ownerName_(ownerName), balance_(0.0) {
-    if (accountId.empty()) {
+Account::Account(AccountId accountId, AccountType type, const Customer& owner, Money initialBalance, std::size_t slot)
+    : slot_(static_cast<std::uint32_t>(slot)), accountId_(accountId), owner_(&owner), type_(type) {
+    if (!accountId.isValid()) {
         throw std::invalid_argument("Account ID cannot be empty.");
     }
-    if (ownerName.empty()) {
-        throw std::invalid_argument("Owner name cannot be empty.");
-    }
-    if (initialBalance < 0.0) {
+    if (initialBalance.isNegative()) {
          throw std::invalid_argument("Initial balance cannot be negative.");
     }
     // Initial balance is set directly; in a real system, this might be via a transaction.
-    balance_ = initialBalance;
+    balance_.store(initialBalance.getCents(), std::memory_order_relaxed);
 }
 
-const std::string& Account::getAccountId() const {
-    return accountId_;
+Account::~Account() {
+    delete sharded_.load(std::memory_order_relaxed);
 }
 
 const std::string& Account::getOwnerName() const {
-    return ownerName_;
+    return owner_->getName();
 }
 
-double Account::getBalance() const {
-    return balance_;
+Money Account::getBalance() const {
+    const Money settled = Money::fromCents(balance_.load(std::memory_order_relaxed));
+    const ShardedBalance* sharded = sharded_.load(std::memory_order_acquire);
+    return sharded ? settled + sharded->getPendingCredits() : settled;
 }
 
-// Base class default implementation for deposit (not allowed)
-bool Account::deposit(double amount, const std::string& note) {
-    // std::cerr << "Debug: Base Account::deposit called for " << accountId_ << std::endl;
-    return false; 
+// Setter for balance_
+void Account::setBalance(Money newBalance) {
+    if (newBalance.isNegative()) {
+        // For this system, we don't allow negative balances directly through setBalance.
+        // Overdrafts would need specific handling.
+        MINIBANK_LOG_WARNING("Attempted to set negative balance for account " << accountId_ << ". Operation might be rejected by business logic.");
+    }
+    balance_.store(newBalance.getCents(), std::memory_order_relaxed);
 }
 
-bool Account::withdraw(double amount, const std::string& note) {
-    // std::cerr << "Debug: Base Account::withdraw called for " << accountId_ << std::endl;
-    return false; 
+// --- Hot-account support ---
+Money Account::getSettledBalance() const {
+    return Money::fromCents(balance_.load(std::memory_order_relaxed));
 }
 
-bool Account::transfer(Account* destinationAccount, double amount, const std::string& note) {
-    // std::cerr << "Debug: Base Account::transfer called for " << accountId_ << std::endl;
-    return false; 
+ShardedBalance* Account::getShardedBalance() const {
+    return sharded_.load(std::memory_order_acquire);
 }
 
-// Setter for balance_
-void Account::setBalance(double newBalance) {
-    if (newBalance < 0.0) {
-        // For this system, we don't allow negative balances directly through setBalance.
-        // Overdrafts would need specific handling.
-        std::cerr << "Warning: Attempted to set negative balance for account " << accountId_ << ". Operation might be rejected by business logic." << std::endl;
+void Account::enableShardedBalance() {
+    if (!sharded_.load(std::memory_order_relaxed)) {
+        sharded_.store(new ShardedBalance(balance_.load(std::memory_order_relaxed)), std::memory_order_release);
     }
-    balance_ = newBalance;
 }
 
-// Private helper to check if an amount is valid (positive)
-bool Account::isValidAmount(double amount) const {
-    return amount > 0.0 &&
-           amount <= std::numeric_limits<double>::max(); // Check against max value
+std::uint32_t Account::recordLockContention() {
+    return contentionScore_.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
-} 
+void Account::recordUncontendedLock() {
+    // Load first so the common uncontended case does not write the cache line.
+    std::uint32_t score = contentionScore_.load(std::memory_order_relaxed);
+    if (score > 0) contentionScore_.compare_exchange_weak(score, score - 1, std::memory_order_relaxed);
+}
+
+}
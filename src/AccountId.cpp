@@ -0,0 +1,307 @@
+#include "AccountId.hh"
+
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <emmintrin.h>
+    #define MINIBANK_ACCOUNTID_SSE2 1
+#endif
+
+namespace banking_system {
+
+namespace {
+
+constexpr unsigned kPrefix = 62; // Fixed "62" bank prefix in front of the type code.
+
+// "00".."99" as consecutive character pairs, used to emit two digits per lookup.
+struct DigitPairs {
+    char chars[200];
+    constexpr DigitPairs() : chars() {
+        for (int i = 0; i < 100; ++i) {
+            chars[2 * i] = static_cast<char>('0' + i / 10);
+            chars[2 * i + 1] = static_cast<char>('0' + i % 10);
+        }
+    }
+};
+constexpr DigitPairs kDigitPairs{};
+
+// Loads four characters as a little-endian 32-bit word (first character in the low byte).
+// Written byte-wise so it is endian-independent; compilers fold it into a single load.
+inline std::uint32_t loadGroup(const char* p) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(p[0])) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(p[1])) << 8) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(p[2])) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(p[3])) << 24);
+}
+
+// True if all four bytes are in '0'..'9'.
+inline bool isDigitGroup(std::uint32_t v) {
+    return ((v & 0xF0F0F0F0u) == 0x30303030u) &&
+           (((v + 0x06060606u) & 0xF0F0F0F0u) == 0x30303030u);
+}
+
+// Converts four ASCII digits to their value: pairs are combined first (d0*10+d1, d2*10+d3),
+// then the two pairs (p0*100+p1).
+inline unsigned groupValue(std::uint32_t v) {
+    v -= 0x30303030u;
+    v = (v * 10 + (v >> 8)) & 0x00FF00FFu;
+    return (v * 100 + (v >> 16)) & 0xFFFFu;
+}
+
+inline void storeGroup(char* out, unsigned value) {
+    const char* hi = &kDigitPairs.chars[2 * (value / 100)];
+    const char* lo = &kDigitPairs.chars[2 * (value % 100)];
+    out[0] = hi[0];
+    out[1] = hi[1];
+    out[2] = lo[0];
+    out[3] = lo[1];
+}
+
+#if defined(MINIBANK_ACCOUNTID_SSE2)
+// --- Batch kernels ---
+// A batch is kBatch IDs: eight 16-bit lanes when formatting, two vectors of four
+// 32-bit lanes when parsing. Group k of ID i is gathered into groups[k][i], so each
+// vector holds the same group of consecutive IDs and goes through the same steps as
+// isDigitGroup/groupValue or storeGroup, for all of them at once.
+constexpr std::size_t kBatch = 8;
+constexpr char kBlankText[AccountId::kTextLength + 1] = "                   ";
+
+std::size_t parseBatch(const std::string_view* texts, AccountId* out) {
+    alignas(16) std::uint32_t groups[4][kBatch];
+    unsigned shapeOk = 0;
+    for (std::size_t i = 0; i < kBatch; ++i) {
+        // Texts of the wrong length are read as kBlankText, which fails the dash test.
+        const bool sized = texts[i].size() == AccountId::kTextLength;
+        const char* p = sized ? texts[i].data() : kBlankText;
+        shapeOk |= static_cast<unsigned>(sized & (p[4] == '-') & (p[9] == '-') & (p[14] == '-')) << i;
+        groups[0][i] = loadGroup(p);
+        groups[1][i] = loadGroup(p + 5);
+        groups[2][i] = loadGroup(p + 10);
+        groups[3][i] = loadGroup(p + 15);
+    }
+
+    const __m128i zeroChars = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    const __m128i ten = _mm_set1_epi16(10);
+    const __m128i pairWeights = _mm_set1_epi32(0x00010064); // p0 * 100 + p1
+    const __m128i tenThousand = _mm_set1_epi32(10000);
+    const __m128i minHead = _mm_set1_epi32(kPrefix * 100);      // "6200", type code 0
+    const __m128i maxHead = _mm_set1_epi32(kPrefix * 100 + 100);
+    alignas(16) std::uint32_t head[kBatch];
+    alignas(16) std::uint32_t branch[kBatch];
+    alignas(16) std::uint32_t number[kBatch];
+    unsigned digitsOk = 0;
+    for (std::size_t first = 0; first < kBatch; first += 4) {
+        __m128i ok = _mm_set1_epi32(-1);
+        __m128i value[4];
+        for (std::size_t k = 0; k < 4; ++k) {
+            const __m128i digits =
+                _mm_sub_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(&groups[k][first])), zeroChars);
+            // Bytes below '0' wrap high, so a lane is all digits if no byte exceeds 9.
+            ok = _mm_and_si128(ok, _mm_cmpeq_epi32(_mm_subs_epu8(digits, nine), _mm_setzero_si128()));
+            const __m128i pairs =
+                _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(digits, lowBytes), ten), _mm_srli_epi16(digits, 8));
+            value[k] = _mm_madd_epi16(pairs, pairWeights);
+        }
+        ok = _mm_and_si128(ok, _mm_and_si128(_mm_cmpgt_epi32(value[0], minHead), _mm_cmplt_epi32(value[0], maxHead)));
+        digitsOk |= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(ok))) << first;
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(&head[first]), value[0]);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&branch[first]), value[1]);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&number[first]),
+                        _mm_add_epi32(_mm_madd_epi16(value[2], tenThousand), value[3]));
+    }
+
+    const unsigned valid = shapeOk & digitsOk;
+    std::size_t parsed = 0;
+    for (std::size_t i = 0; i < kBatch; ++i) {
+        const std::uint64_t packed = (static_cast<std::uint64_t>(head[i] - kPrefix * 100) << 48) |
+                                     (static_cast<std::uint64_t>(branch[i]) << 32) |
+                                     number[i];
+        const unsigned ok = (valid >> i) & 1u;
+        out[i] = AccountId::fromPacked(ok ? packed : 0);
+        parsed += ok;
+    }
+    return parsed;
+}
+
+// Splits the packed IDs of four consecutive AccountIds into 32-bit lanes of their four
+// group values: head ("62XX", or 0 for an invalid ID), branch, and the high and low
+// halves of the number. blank is all ones in the lanes of invalid IDs.
+void splitIds(const AccountId* ids, __m128i value[4], __m128i& blank) {
+    static_assert(sizeof(AccountId) == sizeof(std::uint64_t), "AccountId is its packed value");
+    const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids));
+    const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + 2));
+    // Low dwords (numbers) to the bottom half, high dwords (type code and branch) to the top.
+    const __m128i a = _mm_shuffle_epi32(first, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i b = _mm_shuffle_epi32(second, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i number = _mm_unpacklo_epi64(a, b);
+    const __m128i upper = _mm_unpackhi_epi64(a, b);
+    blank = _mm_cmpeq_epi32(_mm_or_si128(number, upper), _mm_setzero_si128());
+
+    value[0] = _mm_andnot_si128(blank, _mm_add_epi32(_mm_srli_epi32(upper, 16), _mm_set1_epi32(kPrefix * 100)));
+    value[1] = _mm_and_si128(upper, _mm_set1_epi32(0xFFFF));
+    // number / 10000 == (number * 0xD1B71759) >> 45 for any 32-bit number; even and odd
+    // lanes are multiplied separately, as _mm_mul_epu32 only reads the even ones.
+    const __m128i reciprocal = _mm_set1_epi32(static_cast<int>(0xD1B71759u));
+    const __m128i even = _mm_srli_epi64(_mm_mul_epu32(number, reciprocal), 45);
+    const __m128i odd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(number, 32), reciprocal), 45);
+    value[2] = _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+    value[3] = _mm_sub_epi32(number, _mm_madd_epi16(value[2], _mm_set1_epi32(10000)));
+}
+
+void formatBatch(const AccountId* ids, char* out) {
+    __m128i low[4];
+    __m128i high[4];
+    __m128i blankLow;
+    __m128i blankHigh;
+    splitIds(ids, low, blankLow);
+    splitIds(ids + 4, high, blankHigh);
+
+    // Division by multiplication: x / 100 == (x * 5243) >> 19 for x < 43699, and
+    // x / 10 == (x * 6554) >> 16 for x < 16384.
+    const __m128i byHundred = _mm_set1_epi16(5243);
+    const __m128i byTen = _mm_set1_epi16(6554);
+    const __m128i hundred = _mm_set1_epi16(100);
+    const __m128i ten = _mm_set1_epi16(10);
+    const __m128i zeroChars = _mm_set1_epi8('0');
+    const __m128i spaces = _mm_set1_epi8(' ');
+    alignas(16) std::uint32_t groups[4][kBatch];
+    for (std::size_t k = 0; k < 4; ++k) {
+        // Group values are below 10000, so they pack into eight 16-bit lanes unchanged.
+        const __m128i v = _mm_packs_epi32(low[k], high[k]);
+        const __m128i hi = _mm_srli_epi16(_mm_mulhi_epu16(v, byHundred), 3);
+        const __m128i lo = _mm_sub_epi16(v, _mm_mullo_epi16(hi, hundred));
+        const __m128i hiTens = _mm_mulhi_epu16(hi, byTen);
+        const __m128i loTens = _mm_mulhi_epu16(lo, byTen);
+        // Digit pairs as byte pairs (tens in the low byte), then interleaved into one
+        // "d0d1d2d3" word per ID; invalid IDs get spaces.
+        const __m128i hiPair = _mm_or_si128(hiTens, _mm_slli_epi16(_mm_sub_epi16(hi, _mm_mullo_epi16(hiTens, ten)), 8));
+        const __m128i loPair = _mm_or_si128(loTens, _mm_slli_epi16(_mm_sub_epi16(lo, _mm_mullo_epi16(loTens, ten)), 8));
+        const __m128i first = _mm_add_epi8(_mm_unpacklo_epi16(hiPair, loPair), zeroChars);
+        const __m128i second = _mm_add_epi8(_mm_unpackhi_epi16(hiPair, loPair), zeroChars);
+        _mm_store_si128(reinterpret_cast<__m128i*>(&groups[k][0]),
+                        _mm_or_si128(_mm_andnot_si128(blankLow, first), _mm_and_si128(blankLow, spaces)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(&groups[k][4]),
+                        _mm_or_si128(_mm_andnot_si128(blankHigh, second), _mm_and_si128(blankHigh, spaces)));
+    }
+
+    // SSE2 hosts are little-endian: the first character is the low byte of each word.
+    // Each text is two 8-byte stores and a 4-byte one overlapping the second:
+    //     g0 - g1[0..2] | g1[3] - g2 - g3[0] | g3
+    for (std::size_t i = 0; i < kBatch; ++i) {
+        char* text = out + i * AccountId::kTextLength;
+        const std::uint64_t dash = ids[i].isValid() ? '-' : ' ';
+        const std::uint64_t g1 = groups[1][i];
+        const std::uint64_t head = groups[0][i] | (dash << 32) | (g1 << 40);
+        const std::uint64_t middle = (g1 >> 24) | (dash << 8) | (static_cast<std::uint64_t>(groups[2][i]) << 16) |
+                                     (dash << 48) | (static_cast<std::uint64_t>(groups[3][i]) << 56);
+        std::memcpy(text, &head, 8);
+        std::memcpy(text + 8, &middle, 8);
+        std::memcpy(text + 15, &groups[3][i], 4);
+    }
+}
+#endif
+
+} // namespace
+
+AccountId AccountId::fromParts(unsigned typeCode, unsigned branch, std::uint32_t number) {
+    if (typeCode == 0 || typeCode > 99) {
+        throw std::invalid_argument("Account type code must be between 1 and 99.");
+    }
+    if (branch > kMaxBranch) {
+        throw std::invalid_argument("Account branch code must be at most 4 digits.");
+    }
+    if (number > kMaxNumber) {
+        throw std::invalid_argument("Account number must be at most 8 digits.");
+    }
+    return AccountId((static_cast<std::uint64_t>(typeCode) << 48) |
+                     (static_cast<std::uint64_t>(branch) << 32) |
+                     number);
+}
+
+std::optional<AccountId> AccountId::parse(std::string_view text) {
+    if (text.size() != kTextLength || text[4] != '-' || text[9] != '-' || text[14] != '-') {
+        return std::nullopt;
+    }
+    const char* p = text.data();
+    const std::uint32_t g0 = loadGroup(p);
+    const std::uint32_t g1 = loadGroup(p + 5);
+    const std::uint32_t g2 = loadGroup(p + 10);
+    const std::uint32_t g3 = loadGroup(p + 15);
+    if (!isDigitGroup(g0) || !isDigitGroup(g1) || !isDigitGroup(g2) || !isDigitGroup(g3)) {
+        return std::nullopt;
+    }
+
+    const unsigned head = groupValue(g0); // "62XX"
+    if (head / 100 != kPrefix || head % 100 == 0) {
+        return std::nullopt;
+    }
+    const unsigned typeCode = head % 100;
+    const unsigned branch = groupValue(g1);
+    const std::uint32_t number = groupValue(g2) * 10000u + groupValue(g3);
+    return AccountId((static_cast<std::uint64_t>(typeCode) << 48) |
+                     (static_cast<std::uint64_t>(branch) << 32) |
+                     number);
+}
+
+void AccountId::format(char* out) const {
+    if (!isValid()) {
+        for (std::size_t i = 0; i < kTextLength; ++i) out[i] = ' ';
+        return;
+    }
+    storeGroup(out, kPrefix * 100 + getTypeCode());
+    out[4] = '-';
+    storeGroup(out + 5, getBranch());
+    out[9] = '-';
+    storeGroup(out + 10, getNumber() / 10000);
+    out[14] = '-';
+    storeGroup(out + 15, getNumber() % 10000);
+}
+
+std::string AccountId::toString() const {
+    if (!isValid()) return std::string();
+    std::string text(kTextLength, '\0');
+    format(&text[0]);
+    return text;
+}
+
+std::ostream& operator<<(std::ostream& os, AccountId id) {
+    char buffer[AccountId::kTextLength];
+    id.format(buffer);
+    return os.write(buffer, id.isValid() ? AccountId::kTextLength : 0);
+}
+
+// --- Bulk conversion routines ---
+std::size_t parseAccountIds(const std::string_view* texts, std::size_t count, AccountId* out) {
+    std::size_t parsed = 0;
+    std::size_t i = 0;
+#if defined(MINIBANK_ACCOUNTID_SSE2)
+    for (; i + kBatch <= count; i += kBatch) {
+        parsed += parseBatch(texts + i, out + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        const auto id = AccountId::parse(texts[i]);
+        out[i] = id ? *id : AccountId();
+        parsed += id.has_value();
+    }
+    return parsed;
+}
+
+void formatAccountIds(const AccountId* ids, std::size_t count, char* out) {
+    std::size_t i = 0;
+#if defined(MINIBANK_ACCOUNTID_SSE2)
+    for (; i + kBatch <= count; i += kBatch) {
+        formatBatch(ids + i, out + i * AccountId::kTextLength);
+    }
+#endif
+    for (; i < count; ++i) {
+        ids[i].format(out + i * AccountId::kTextLength);
+    }
+}
+
+} // namespace banking_system
@@ -0,0 +1,64 @@
+#include "AccountIdAllocator.hh"
+
+#include <stdexcept>
+
+namespace banking_system {
+
+namespace {
+
+// SplitMix64 finalizer: a cheap bijective mix with full avalanche.
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+AccountIdAllocator::AccountIdAllocator(std::uint64_t key) {
+    std::uint64_t state = key;
+    for (auto& keys : roundKeys_) {
+        for (std::uint64_t& roundKey : keys) {
+            state += 0x9E3779B97F4A7C15ULL;
+            roundKey = mix(state);
+        }
+    }
+}
+
+AccountId AccountIdAllocator::next(AccountType type) {
+    std::uint64_t& allocated = allocated_[static_cast<std::size_t>(type)];
+    if (allocated >= kCapacity) {
+        throw std::runtime_error("All account IDs of this type have been allocated.");
+    }
+    return at(type, allocated++);
+}
+
+// Cycle walking: the permutation of [0, 2^40) restricted to [0, kCapacity) is still a
+// permutation, found by applying it again until the value lands inside.
+AccountId AccountIdAllocator::at(AccountType type, std::uint64_t index) const {
+    const auto& keys = roundKeys_[static_cast<std::size_t>(type)];
+    std::uint64_t value = index;
+    do {
+        value = permute(value, keys);
+    } while (value >= kCapacity);
+
+    const unsigned typeCode = (type == AccountType::SAVINGS) ? AccountId::kSavingsTypeCode : AccountId::kCheckingTypeCode;
+    return AccountId::fromParts(typeCode, static_cast<unsigned>(value / kNumberSpan),
+                                kMinNumber + static_cast<std::uint32_t>(value % kNumberSpan));
+}
+
+std::uint64_t AccountIdAllocator::permute(std::uint64_t value, const std::array<std::uint64_t, kRounds>& roundKeys) const {
+    constexpr std::uint64_t mask = (std::uint64_t(1) << kHalfBits) - 1;
+    std::uint64_t left = value >> kHalfBits;
+    std::uint64_t right = value & mask;
+    for (std::uint64_t roundKey : roundKeys) {
+        const std::uint64_t mixed = left ^ (mix(right ^ roundKey) & mask);
+        left = right;
+        right = mixed;
+    }
+    return (left << kHalfBits) | right;
+}
+
+} // namespace banking_system
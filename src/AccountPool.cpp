@@ -0,0 +1,66 @@
+#include "AccountPool.hh"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace banking_system {
+
+Account& AccountPool::add(AccountId accountId, AccountType type, const Customer& owner, Money balance) {
+    // Validated here because AppendLog elements must be constructed without throwing.
+    if (!accountId.isValid()) {
+        throw std::invalid_argument("Account ID cannot be empty.");
+    }
+    if (balance.isNegative()) {
+        throw std::invalid_argument("Initial balance cannot be negative.");
+    }
+    const std::size_t slot = records_.size();
+    if ((slot + 1) * 2 > buckets_.size()) {
+        rehash(std::max(buckets_.size() * 2, kMinBuckets));
+    }
+
+    const std::size_t mask = buckets_.size() - 1;
+    std::size_t bucket = bucketOf(accountId);
+    for (; buckets_[bucket] != kEmpty; bucket = (bucket + 1) & mask) {
+        if (records_[buckets_[bucket] - 1].getAccountId() == accountId) {
+            throw std::invalid_argument("Account ID " + accountId.toString() + " already exists.");
+        }
+    }
+    records_.emplace_back(accountId, type, owner, balance, slot);
+    buckets_[bucket] = static_cast<std::uint32_t>(slot + 1);
+    return records_[slot];
+}
+
+void AccountPool::reserve(std::size_t count) {
+    std::size_t bucketCount = std::max(buckets_.size(), kMinBuckets);
+    while (bucketCount < count * 2) bucketCount *= 2;
+    if (bucketCount > buckets_.size()) rehash(bucketCount);
+}
+
+Account* AccountPool::find(AccountId accountId) const {
+    if (buckets_.empty()) return nullptr;
+    const std::size_t mask = buckets_.size() - 1;
+    for (std::size_t bucket = bucketOf(accountId); buckets_[bucket] != kEmpty; bucket = (bucket + 1) & mask) {
+        const Account& account = records_[buckets_[bucket] - 1];
+        // A const pool only keeps its structure fixed; its accounts stay mutable.
+        if (account.getAccountId() == accountId) return const_cast<Account*>(&account);
+    }
+    return nullptr;
+}
+
+std::size_t AccountPool::bucketOf(AccountId accountId) const {
+    return std::hash<AccountId>{}(accountId) & (buckets_.size() - 1);
+}
+
+void AccountPool::rehash(std::size_t bucketCount) {
+    buckets_.assign(bucketCount, kEmpty);
+    const std::size_t mask = bucketCount - 1;
+    const std::size_t count = records_.size();
+    for (std::size_t slot = 0; slot < count; ++slot) {
+        std::size_t bucket = bucketOf(records_[slot].getAccountId());
+        while (buckets_[bucket] != kEmpty) bucket = (bucket + 1) & mask;
+        buckets_[bucket] = static_cast<std::uint32_t>(slot + 1);
+    }
+}
+
+} // namespace banking_system
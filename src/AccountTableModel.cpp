@@ -0,0 +1,165 @@
+#include "AccountTableModel.hh"
+#include "Bank.hh"
+#include "Transaction.hh"
+#include "TransactionQuery.hh"
+
+#include <algorithm>
+
+namespace banking_system {
+
+namespace {
+
+// Sorts the entries appended from index first on and merges them into the sorted
+// entries before them.
+template <typename T, typename Less>
+void mergeTail(std::vector<T>& order, std::size_t first, Less less) {
+    std::sort(order.begin() + first, order.end(), less);
+    std::inplace_merge(order.begin(), order.begin() + first, order.end(), less);
+}
+
+} // namespace
+
+void AccountTableModel::open(const Bank& bank) {
+    close();
+    bank_ = &bank;
+}
+
+void AccountTableModel::close() {
+    bank_ = nullptr;
+    accountTotal_ = 0;
+    watermark_ = 0;
+    std::vector<const Account*>().swap(accounts_);
+    std::unordered_map<AccountId, std::uint32_t>().swap(indexOf_);
+    std::vector<std::uint32_t>().swap(idOrder_);
+    std::vector<std::uint32_t>().swap(ownerOrder_);
+    std::vector<BalanceEntry>().swap(balanceOrder_);
+    std::vector<std::int64_t>().swap(placedCents_);
+}
+
+bool AccountTableModel::refresh() {
+    if (!bank_) return false;
+    // Balances of the accounts already listed first: an account added afterwards has
+    // its balance read when it is added, which covers every record before this point.
+    const bool moved = updateBalances();
+    accountTotal_ = bank_->getAccountCount();
+    const bool added = accounts_.size() < accountTotal_ && addAccounts();
+    return moved || added;
+}
+
+void AccountTableModel::setSortOrder(AccountSortKey key, bool descending) {
+    sortKey_ = key;
+    descending_ = descending;
+}
+
+bool AccountTableModel::isLoading() const {
+    return accounts_.size() < accountTotal_;
+}
+
+const Account& AccountTableModel::getAccount(std::size_t row) const {
+    const std::size_t rank = descending_ ? accounts_.size() - 1 - row : row;
+    switch (sortKey_) {
+        case AccountSortKey::OWNER: return *accounts_[ownerOrder_[rank]];
+        case AccountSortKey::BALANCE: return *accounts_[balanceOrder_[rank].index];
+        case AccountSortKey::ID:
+        default: return *accounts_[idOrder_[rank]];
+    }
+}
+
+// Appends up to kLoadBudget new accounts and merges them into every index.
+bool AccountTableModel::addAccounts() {
+    const std::size_t first = accounts_.size();
+    accounts_.resize(first + kLoadBudget);
+    accounts_.resize(first + bank_->getAccountsFrom(first, accounts_.data() + first, kLoadBudget));
+    if (accounts_.size() == first) return false;
+
+    for (std::size_t i = first; i < accounts_.size(); ++i) {
+        const auto index = static_cast<std::uint32_t>(i);
+        const std::int64_t cents = accounts_[i]->getBalance().getCents();
+        indexOf_[accounts_[i]->getAccountId()] = index;
+        placedCents_.push_back(cents);
+        idOrder_.push_back(index);
+        ownerOrder_.push_back(index);
+        balanceOrder_.push_back({cents, index});
+    }
+
+    mergeTail(idOrder_, first, [this](std::uint32_t a, std::uint32_t b) {
+        return accounts_[a]->getAccountId() < accounts_[b]->getAccountId();
+    });
+    mergeTail(ownerOrder_, first, [this](std::uint32_t a, std::uint32_t b) {
+        const int order = accounts_[a]->getOwnerName().compare(accounts_[b]->getOwnerName());
+        return order != 0 ? order < 0 : accounts_[a]->getAccountId() < accounts_[b]->getAccountId();
+    });
+    mergeTail(balanceOrder_, first, [this](const BalanceEntry& a, const BalanceEntry& b) {
+        return balanceLess(a, b);
+    });
+    return true;
+}
+
+// Moves the accounts named by ledger records since the last refresh to their place in
+// the balance index: stale entries are dropped in one pass and the re-read ones are
+// sorted and merged back in.
+bool AccountTableModel::updateBalances() {
+    const std::size_t count = bank_->getTransactionCount();
+    if (count == watermark_) return false;
+    if (count - watermark_ > accounts_.size() / 4 + 1024) {
+        watermark_ = count;
+        rebuildBalanceOrder();
+        return true;
+    }
+
+    TransactionCursor cursor = bank_->queryTransactions(TransactionQuery::all().positions(watermark_, count));
+    watermark_ = count;
+    changed_.clear();
+    const Transaction* page[256];
+    std::size_t read;
+    while ((read = cursor.next(page, sizeof(page) / sizeof(page[0]))) > 0) {
+        for (std::size_t i = 0; i < read; ++i) {
+            for (AccountId accountId : {page[i]->getSourceAccountId(), page[i]->getDestinationAccountId()}) {
+                auto it = indexOf_.find(accountId);
+                if (it != indexOf_.end()) changed_.push_back(it->second);
+            }
+        }
+    }
+    std::sort(changed_.begin(), changed_.end());
+    changed_.erase(std::unique(changed_.begin(), changed_.end()), changed_.end());
+
+    moved_.clear();
+    for (std::uint32_t index : changed_) {
+        const std::int64_t cents = accounts_[index]->getBalance().getCents();
+        if (cents != placedCents_[index]) {
+            placedCents_[index] = cents;
+            moved_.push_back({cents, index});
+        }
+    }
+    if (moved_.empty()) return false;
+
+    balanceOrder_.erase(std::remove_if(balanceOrder_.begin(), balanceOrder_.end(),
+                                       [this](const BalanceEntry& entry) {
+                                           return entry.cents != placedCents_[entry.index];
+                                       }),
+                        balanceOrder_.end());
+    const std::size_t first = balanceOrder_.size();
+    balanceOrder_.insert(balanceOrder_.end(), moved_.begin(), moved_.end());
+    mergeTail(balanceOrder_, first, [this](const BalanceEntry& a, const BalanceEntry& b) {
+        return balanceLess(a, b);
+    });
+    return true;
+}
+
+void AccountTableModel::rebuildBalanceOrder() {
+    balanceOrder_.clear();
+    for (std::size_t i = 0; i < accounts_.size(); ++i) {
+        placedCents_[i] = accounts_[i]->getBalance().getCents();
+        balanceOrder_.push_back({placedCents_[i], static_cast<std::uint32_t>(i)});
+    }
+    std::sort(balanceOrder_.begin(), balanceOrder_.end(), [this](const BalanceEntry& a, const BalanceEntry& b) {
+        return balanceLess(a, b);
+    });
+}
+
+bool AccountTableModel::balanceLess(const BalanceEntry& a, const BalanceEntry& b) const {
+    if (a.cents != b.cents) return a.cents < b.cents;
+    return accounts_[a.index]->getAccountId() < accounts_[b.index]->getAccountId();
+}
+
+} // namespace banking_system
@@ -0,0 +1,300 @@
+#include "BalanceKernels.hh"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define MINIBANK_KERNELS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <emmintrin.h>
+    #define MINIBANK_KERNELS_SSE2 1
+#endif
+
+namespace banking_system {
+namespace kernels {
+
+namespace {
+
+// Adding 2^63 (flipping the sign bit) maps int64 onto uint64 monotonically, so both
+// 32-bit halves of the biased value are unsigned and can be summed without sign handling.
+constexpr std::uint64_t kBias = 0x8000000000000000ULL;
+constexpr std::uint64_t kLow32 = 0xFFFFFFFFULL;
+
+// Elements per chunk. 2^30 values of at most 2^32 - 1 keep each half-sum below 2^62.
+constexpr std::size_t kChunk = std::size_t(1) << 30;
+
+// Sum of a chunk of biased values, kept as separate sums of their halves:
+// sum(v) = hi * 2^32 + lo - count * 2^63.
+struct SplitSum {
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+    std::uint64_t count = 0;
+};
+
+inline void accumulate(SplitSum& sum, std::int64_t value) {
+    const std::uint64_t biased = static_cast<std::uint64_t>(value) ^ kBias;
+    sum.hi += biased >> 32;
+    sum.lo += biased & kLow32;
+    ++sum.count;
+}
+
+// Recombines a split sum exactly, throwing std::overflow_error if it does not fit.
+Money combine(const SplitSum& sum) {
+    // hi - count * 2^31 is the signed high part once the bias is removed; its true value
+    // is within +/- 2^61, so the wrapping unsigned subtraction yields it exactly.
+    const std::int64_t high = static_cast<std::int64_t>(sum.hi - sum.count * (std::uint64_t(1) << 31));
+    // Fold the carry of the low sum into the high part so only a 32-bit remainder is left.
+    const std::int64_t folded = high + static_cast<std::int64_t>(sum.lo >> 32);
+    const std::int64_t remainder = static_cast<std::int64_t>(sum.lo & kLow32);
+    if (folded >= (std::int64_t(1) << 31) || folded < -(std::int64_t(1) << 31)) {
+        throw std::overflow_error("Balance total exceeds the representable range.");
+    }
+    // folded * 2^32 is in [-2^63, 2^63 - 2^32], so adding remainder < 2^32 cannot overflow.
+    return Money::fromCents(static_cast<std::int64_t>(static_cast<std::uint64_t>(folded) << 32) + remainder);
+}
+
+// Sums one chunk; when tags is non-null only values with a matching tag contribute.
+SplitSum sumChunk(const std::int64_t* cents, const std::uint8_t* tags, std::uint8_t tag, std::size_t count) {
+    SplitSum sum;
+    std::size_t i = 0;
+
+#if defined(MINIBANK_KERNELS_AVX2)
+    const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(kBias));
+    const __m256i low32 = _mm256_set1_epi64x(static_cast<long long>(kLow32));
+    const __m256i target = _mm256_set1_epi64x(tag);
+    __m256i hiAcc = _mm256_setzero_si256();
+    __m256i loAcc = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cents + i));
+        if (tags) {
+            std::int32_t packedTags;
+            std::memcpy(&packedTags, tags + i, sizeof(packedTags));
+            const __m256i laneTags = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packedTags));
+            v = _mm256_and_si256(v, _mm256_cmpeq_epi64(laneTags, target));
+        }
+        const __m256i u = _mm256_xor_si256(v, bias);
+        hiAcc = _mm256_add_epi64(hiAcc, _mm256_srli_epi64(u, 32));
+        loAcc = _mm256_add_epi64(loAcc, _mm256_and_si256(u, low32));
+    }
+    alignas(32) std::uint64_t hiLanes[4];
+    alignas(32) std::uint64_t loLanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hiLanes), hiAcc);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(loLanes), loAcc);
+    for (int lane = 0; lane < 4; ++lane) {
+        sum.hi += hiLanes[lane];
+        sum.lo += loLanes[lane];
+    }
+    sum.count = i;
+#elif defined(MINIBANK_KERNELS_SSE2)
+    const __m128i bias = _mm_set1_epi64x(static_cast<long long>(kBias));
+    const __m128i low32 = _mm_set1_epi64x(static_cast<long long>(kLow32));
+    const __m128i target = _mm_set1_epi64x(tag);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i hiAcc = _mm_setzero_si128();
+    __m128i loAcc = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cents + i));
+        if (tags) {
+            // Widen two tag bytes to two 64-bit lanes. SSE2 has no 64-bit compare, but the
+            // upper halves are zero, so a 32-bit compare ANDed with its half-swap is equivalent.
+            const int packedTags = tags[i] | (tags[i + 1] << 8);
+            __m128i laneTags = _mm_cvtsi32_si128(packedTags);
+            laneTags = _mm_unpacklo_epi8(laneTags, zero);
+            laneTags = _mm_unpacklo_epi16(laneTags, zero);
+            laneTags = _mm_unpacklo_epi32(laneTags, zero);
+            const __m128i eq32 = _mm_cmpeq_epi32(laneTags, target);
+            const __m128i eq64 = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_and_si128(v, eq64);
+        }
+        const __m128i u = _mm_xor_si128(v, bias);
+        hiAcc = _mm_add_epi64(hiAcc, _mm_srli_epi64(u, 32));
+        loAcc = _mm_add_epi64(loAcc, _mm_and_si128(u, low32));
+    }
+    alignas(16) std::uint64_t hiLanes[2];
+    alignas(16) std::uint64_t loLanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(hiLanes), hiAcc);
+    _mm_store_si128(reinterpret_cast<__m128i*>(loLanes), loAcc);
+    sum.hi = hiLanes[0] + hiLanes[1];
+    sum.lo = loLanes[0] + loLanes[1];
+    sum.count = i;
+#endif
+
+    for (; i < count; ++i) {
+        const bool selected = !tags || tags[i] == tag;
+        accumulate(sum, selected ? cents[i] : 0);
+    }
+    return sum;
+}
+
+Money sumColumn(const std::int64_t* cents, const std::uint8_t* tags, std::uint8_t tag, std::size_t count) {
+    Money total;
+    for (std::size_t begin = 0; begin < count; begin += kChunk) {
+        const std::size_t length = (count - begin < kChunk) ? (count - begin) : kChunk;
+        total += combine(sumChunk(cents + begin, tags ? tags + begin : nullptr, tag, length));
+    }
+    return total;
+}
+
+// --- Tiered accrual ---
+// Accrual of one balance; the vector loops below compute the same sums lane by lane.
+// A part is split into 32-bit halves so each product with a factor fits in 64 bits:
+// the high half's products are whole cents, and the low half's are summed as their
+// own high and low halves, whose total carries into the result.
+std::int64_t accrueOne(std::int64_t balance, const AccrualTier* tiers, std::size_t tierCount) {
+    if (balance <= 0) return 0;
+    std::uint64_t whole = 0;
+    std::uint64_t highSum = 0;
+    std::uint64_t lowSum = 0;
+    for (std::size_t k = 0; k < tierCount; ++k) {
+        std::int64_t part = balance - tiers[k].floor;
+        if (part <= 0) break; // Bands ascend, so no later band holds any of the balance
+        if (k + 1 < tierCount && part > tiers[k].width) part = tiers[k].width;
+        const auto unsignedPart = static_cast<std::uint64_t>(part);
+        whole += (unsignedPart >> 32) * tiers[k].dailyFactor;
+        const std::uint64_t product = (unsignedPart & kLow32) * tiers[k].dailyFactor;
+        highSum += product >> 32;
+        lowSum += product & kLow32;
+    }
+    return static_cast<std::int64_t>(whole + highSum + (lowSum >> 32));
+}
+
+#if defined(MINIBANK_KERNELS_AVX2)
+// All-ones in the 64-bit lanes of v that are negative. There is no 64-bit arithmetic
+// shift before AVX-512, so the sign of each high 32-bit half is copied across its lane.
+inline __m256i negativeLanes(__m256i v) {
+    return _mm256_shuffle_epi32(_mm256_srai_epi32(v, 31), _MM_SHUFFLE(3, 3, 1, 1));
+}
+inline __m256i positivePart(__m256i v) {
+    return _mm256_andnot_si256(negativeLanes(v), v);
+}
+#elif defined(MINIBANK_KERNELS_SSE2)
+inline __m128i negativeLanes(__m128i v) {
+    return _mm_shuffle_epi32(_mm_srai_epi32(v, 31), _MM_SHUFFLE(3, 3, 1, 1));
+}
+inline __m128i positivePart(__m128i v) {
+    return _mm_andnot_si128(negativeLanes(v), v);
+}
+#endif
+
+} // namespace
+
+Money sumBalances(const std::int64_t* cents, std::size_t count) {
+    return sumColumn(cents, nullptr, 0, count);
+}
+
+Money sumBalancesWhere(const std::int64_t* cents, const std::uint8_t* tags,
+                       std::uint8_t tag, std::size_t count) {
+    return sumColumn(cents, tags, tag, count);
+}
+
+std::vector<Money> sumBalancesByKey(const std::int64_t* cents, const std::uint16_t* keys,
+                                    std::size_t count, std::size_t keyCount) {
+    // Scatter-adds do not vectorize, but the split accumulators keep the loop branch-free
+    // and exact; keyCount * 24 bytes of accumulators stays cache-resident for branch codes.
+    std::vector<Money> totals(keyCount);
+    std::vector<SplitSum> sums(keyCount);
+    for (std::size_t begin = 0; begin < count; begin += kChunk) {
+        const std::size_t end = (count - begin < kChunk) ? count : begin + kChunk;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (keys[i] < keyCount) accumulate(sums[keys[i]], cents[i]);
+        }
+        for (std::size_t key = 0; key < keyCount; ++key) {
+            if (sums[key].count != 0) {
+                totals[key] += combine(sums[key]);
+                sums[key] = SplitSum();
+            }
+        }
+    }
+    return totals;
+}
+
+void accrueTiered(const std::int64_t* cents, const std::uint8_t* tags, std::uint8_t tag,
+                  const AccrualTier* tiers, std::size_t tierCount, std::size_t count, std::int64_t* out) {
+    std::size_t i = 0;
+
+#if defined(MINIBANK_KERNELS_AVX2)
+    const __m256i low32 = _mm256_set1_epi64x(static_cast<long long>(kLow32));
+    const __m256i target = _mm256_set1_epi64x(tag);
+    __m256i floors[kMaxAccrualTiers];
+    __m256i widths[kMaxAccrualTiers];
+    __m256i factors[kMaxAccrualTiers];
+    for (std::size_t k = 0; k < tierCount; ++k) {
+        floors[k] = _mm256_set1_epi64x(tiers[k].floor);
+        widths[k] = _mm256_set1_epi64x(tiers[k].width);
+        factors[k] = _mm256_set1_epi64x(tiers[k].dailyFactor);
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cents + i));
+        if (tags) {
+            std::int32_t packedTags;
+            std::memcpy(&packedTags, tags + i, sizeof(packedTags));
+            const __m256i laneTags = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packedTags));
+            v = _mm256_and_si256(v, _mm256_cmpeq_epi64(laneTags, target));
+        }
+        v = positivePart(v);
+        __m256i whole = _mm256_setzero_si256();
+        __m256i highSum = _mm256_setzero_si256();
+        __m256i lowSum = _mm256_setzero_si256();
+        for (std::size_t k = 0; k < tierCount; ++k) {
+            __m256i part = positivePart(_mm256_sub_epi64(v, floors[k]));
+            if (k + 1 < tierCount) part = _mm256_sub_epi64(part, positivePart(_mm256_sub_epi64(part, widths[k])));
+            // _mm256_mul_epu32 multiplies the low 32 bits of each lane.
+            whole = _mm256_add_epi64(whole, _mm256_mul_epu32(_mm256_srli_epi64(part, 32), factors[k]));
+            const __m256i product = _mm256_mul_epu32(part, factors[k]);
+            highSum = _mm256_add_epi64(highSum, _mm256_srli_epi64(product, 32));
+            lowSum = _mm256_add_epi64(lowSum, _mm256_and_si256(product, low32));
+        }
+        const __m256i accrual = _mm256_add_epi64(_mm256_add_epi64(whole, highSum), _mm256_srli_epi64(lowSum, 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), accrual);
+    }
+#elif defined(MINIBANK_KERNELS_SSE2)
+    const __m128i low32 = _mm_set1_epi64x(static_cast<long long>(kLow32));
+    const __m128i target = _mm_set1_epi64x(tag);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i floors[kMaxAccrualTiers];
+    __m128i widths[kMaxAccrualTiers];
+    __m128i factors[kMaxAccrualTiers];
+    for (std::size_t k = 0; k < tierCount; ++k) {
+        floors[k] = _mm_set1_epi64x(tiers[k].floor);
+        widths[k] = _mm_set1_epi64x(tiers[k].width);
+        factors[k] = _mm_set1_epi64x(tiers[k].dailyFactor);
+    }
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cents + i));
+        if (tags) {
+            // Same tag widening and 64-bit compare as in sumChunk.
+            const int packedTags = tags[i] | (tags[i + 1] << 8);
+            __m128i laneTags = _mm_cvtsi32_si128(packedTags);
+            laneTags = _mm_unpacklo_epi8(laneTags, zero);
+            laneTags = _mm_unpacklo_epi16(laneTags, zero);
+            laneTags = _mm_unpacklo_epi32(laneTags, zero);
+            const __m128i eq32 = _mm_cmpeq_epi32(laneTags, target);
+            const __m128i eq64 = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            v = _mm_and_si128(v, eq64);
+        }
+        v = positivePart(v);
+        __m128i whole = zero;
+        __m128i highSum = zero;
+        __m128i lowSum = zero;
+        for (std::size_t k = 0; k < tierCount; ++k) {
+            __m128i part = positivePart(_mm_sub_epi64(v, floors[k]));
+            if (k + 1 < tierCount) part = _mm_sub_epi64(part, positivePart(_mm_sub_epi64(part, widths[k])));
+            // _mm_mul_epu32 multiplies the low 32 bits of each lane.
+            whole = _mm_add_epi64(whole, _mm_mul_epu32(_mm_srli_epi64(part, 32), factors[k]));
+            const __m128i product = _mm_mul_epu32(part, factors[k]);
+            highSum = _mm_add_epi64(highSum, _mm_srli_epi64(product, 32));
+            lowSum = _mm_add_epi64(lowSum, _mm_and_si128(product, low32));
+        }
+        const __m128i accrual = _mm_add_epi64(_mm_add_epi64(whole, highSum), _mm_srli_epi64(lowSum, 32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), accrual);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const bool selected = !tags || tags[i] == tag;
+        out[i] = selected ? accrueOne(cents[i], tiers, tierCount) : 0;
+    }
+}
+
+} // namespace kernels
+} // namespace banking_system
@@ -1,69 +1,146 @@
 #include "Bank.hh"
 #include "Customer.hh"
 #include "Account.hh"
-#include "SavingsAccount.hh"
-#include "CheckingAccount.hh"
 #include "Transaction.hh"
 #include "Utils.hh"
+#include "BalanceKernels.hh"
+#include "Snapshot.hh"
+#include "ShardedBalance.hh"
+#include "Logger.hh"
+#include "ReportWriter.hh"
 
 #include <stdexcept>
-#include <iostream>
+#include <filesystem>
 #include <fstream>
+#include <random>
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
+#include <bitset>
+#include <deque>
 #include <chrono>
+#include <thread>
+#include <system_error>
+#include <tuple>
+#include <utility>
 
 namespace banking_system {
 
-// Constructor: Initializes random number distributions and seeds the engine.
-// Initializes branchDist_ and accountNumDist_ in the member initializer list.
-Bank::Bank() : branchDist_(0, 9999), accountNumDist_(10000000LL, 99999999LL) { // Adjusted accountNumDist_ range to ensure 8 digits
-    // randomEngine_ is already initialized in-class using std::random_device
-    // If you want to seed it here as well (e.g. for more variability or specific seed):
-    // auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    // randomEngine_.seed(seed);
-    std::cout << "Random engine initialized for Bank operations." << std::endl;
+namespace {
+
+// Makes room for count elements. Growth at least doubles the capacity, so a series of
+// small bulk registrations stays amortized O(1) per element instead of reallocating or
+// rehashing everything on every call.
+template <typename T>
+void reserveAtLeast(std::vector<T>& container, std::size_t count) {
+    if (count > container.capacity()) container.reserve(std::max(count, container.capacity() * 2));
 }
 
-// --- Customer Management Implementations ---
-Customer* Bank::registerCustomer(const std::string& name) {
-    if (customerExists(name)) {
-        std::cerr << "Error: Customer '" << name << "' already exists." << std::endl;
-        return nullptr;
+template <typename Key, typename Value>
+void reserveAtLeast(std::unordered_map<Key, Value>& container, std::size_t count) {
+    const auto capacity = static_cast<std::size_t>(static_cast<float>(container.bucket_count()) * container.max_load_factor());
+    if (count > capacity) container.reserve(std::max(count, container.size() * 2));
+}
+
+// Copies the digits of text to out, up to SearchIndex::kMaxKeyLength, and returns how
+// many there were. Account IDs are indexed by their digits alone.
+std::size_t accountIdDigits(std::string_view text, char* out) {
+    std::size_t count = 0;
+    for (const char c : text) {
+        if (c >= '0' && c <= '9' && count < SearchIndex::kMaxKeyLength) out[count++] = c;
     }
+    return count;
+}
 
-    auto newCustomer = std::make_unique<Customer>(name);
-    Customer* customerPtr = newCustomer.get();
+// Key of the account ID permutation. Each bank numbers its accounts differently.
+std::uint64_t randomAllocatorKey() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+}
 
-    std::string savingsAccountId = generateUniqueAccountId(AccountType::SAVINGS);
-    auto savingsAccount = std::make_unique<SavingsAccount>(savingsAccountId, name, 0.0);
-    customerPtr->addAccountId(savingsAccountId);
+} // namespace
 
-    std::string checkingAccountId = generateUniqueAccountId(AccountType::CHECKING);
-    auto checkingAccount = std::make_unique<CheckingAccount>(checkingAccountId, name, 0.0);
-    customerPtr->addAccountId(checkingAccountId);
+Bank::Bank() : accountIdAllocator_(randomAllocatorKey()) {
+}
 
-    accounts_[savingsAccountId] = std::move(savingsAccount);
-    accounts_[checkingAccountId] = std::move(checkingAccount);
+Bank::~Bank() {
+    // The snapshot writer reads the ledger and customers, so they must outlive it.
+    if (snapshotTask_.valid()) snapshotTask_.wait();
+}
 
-    customers_.push_back(std::move(newCustomer));
-    customerIndex_[name] = customerPtr;
+// --- Customer Management Implementations ---
+Customer* Bank::registerCustomer(const std::string& name) {
+    Customer* customerPtr = nullptr;
+    AccountId savingsAccountId;
+    AccountId checkingAccountId;
+    std::uint64_t sequence = 0;
+    {
+        std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+        if (customerExists(name)) {
+            MINIBANK_LOG_ERROR("Customer '" << name << "' already exists.");
+            return nullptr;
+        }
 
-    std::cout << "Customer [" << name << "] registered. Accounts created:\n"
-              << "- Savings: " << savingsAccountId << "\n"
-              << "- Checking: " << checkingAccountId << std::endl;
+        savingsAccountId = generateUniqueAccountId(AccountType::SAVINGS);
+        checkingAccountId = generateUniqueAccountId(AccountType::CHECKING);
+
+        customerPtr = addCustomer(name);
+        const auto ownerIndex = static_cast<std::uint32_t>(customers_.size() - 1);
+        addAccount(AccountType::SAVINGS, savingsAccountId, ownerIndex, Money::zero());
+        addAccount(AccountType::CHECKING, checkingAccountId, ownerIndex, Money::zero());
+
+        if (journal_) {
+            sequence = journal_->appendCustomerRegistered(name, savingsAccountId, checkingAccountId);
+        }
+    }
+    commitJournal(sequence);
+
+    MINIBANK_LOG_INFO("Customer [" << name << "] registered. Accounts created: Savings " << savingsAccountId
+                      << ", Checking " << checkingAccountId << ".");
     return customerPtr;
 }
 
+std::vector<Customer*> Bank::registerCustomers(const std::vector<std::string>& names) {
+    std::vector<Customer*> registered(names.size(), nullptr);
+    std::size_t added = 0;
+    std::uint64_t sequence = 0;
+    // The lock is released between chunks so lookups and operations are not shut out
+    // for the whole batch.
+    for (std::size_t first = 0; first < names.size(); first += kRegistrationChunk) {
+        const std::size_t last = std::min(names.size(), first + kRegistrationChunk);
+        std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+        if (first == 0) reserveRegistry(names.size(), names.size() * 2);
+        for (std::size_t i = first; i < last; ++i) {
+            const std::string& name = names[i];
+            if (customerExists(name)) {
+                MINIBANK_LOG_ERROR("Customer '" << name << "' already exists.");
+                continue;
+            }
+            const AccountId savingsAccountId = generateUniqueAccountId(AccountType::SAVINGS);
+            const AccountId checkingAccountId = generateUniqueAccountId(AccountType::CHECKING);
+            registered[i] = addCustomer(name);
+            const auto ownerIndex = static_cast<std::uint32_t>(customers_.size() - 1);
+            addAccount(AccountType::SAVINGS, savingsAccountId, ownerIndex, Money::zero());
+            addAccount(AccountType::CHECKING, checkingAccountId, ownerIndex, Money::zero());
+            if (journal_) {
+                sequence = journal_->appendCustomerRegistered(name, savingsAccountId, checkingAccountId);
+            }
+            ++added;
+        }
+    }
+    // The journal is ordered, so the last record's durability covers the batch.
+    commitJournal(sequence);
+
+    MINIBANK_LOG_INFO(added << " of " << names.size() << " customers registered.");
+    return registered;
+}
+
 Customer* Bank::findCustomer(const std::string& name) {
-    auto it = customerIndex_.find(name);
-    return (it != customerIndex_.end()) ? it->second : nullptr;
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    return lookupCustomer(name);
 }
 
 const Customer* Bank::findCustomer(const std::string& name) const {
-    auto it = customerIndex_.find(name);
-    return (it != customerIndex_.end()) ? it->second : nullptr;
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    return lookupCustomer(name);
 }
 
 const std::vector<std::unique_ptr<Customer>>& Bank::getAllCustomers() const {
@@ -71,18 +148,17 @@ const std::vector<std::unique_ptr<Customer>>& Bank::getAllCustomers() const {
 }
 
 // --- Account Management Implementations ---
-Account* Bank::findAccount(const std::string& accountId) {
-    auto it = accounts_.find(accountId);
-    return (it != accounts_.end()) ? it->second.get() : nullptr;
+Account* Bank::findAccount(AccountId accountId) {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    return lookupAccount(accountId);
 }
 
-const Account* Bank::findAccount(const std::string& accountId) const {
-    auto it = accounts_.find(accountId);
-    return (it != accounts_.end()) ? it->second.get() : nullptr;
+const Account* Bank::findAccount(AccountId accountId) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    return lookupAccount(accountId);
 }
 
-// *** Changed to std::unordered_map to match private member and header declaration ***
-const std::unordered_map<std::string, std::unique_ptr<Account>>& Bank::getAllAccounts() const {
+const AccountPool& Bank::getAllAccounts() const {
     return accounts_;
 }
 
@@ -90,7 +166,7 @@ std::vector<Account*> Bank::getCustomerAccounts(const std::string& customerName)
     std::vector<Account*> customerAccountsVec;
     Customer* customer = findCustomer(customerName);
     if (customer) {
-        for (const std::string& id : customer->getAccountIds()) {
+        for (AccountId id : customer->getAccountIds()) {
             Account* acc = findAccount(id);
             if (acc) customerAccountsVec.push_back(acc);
         }
@@ -102,7 +178,7 @@ std::vector<const Account*> Bank::getCustomerAccounts(const std::string& custome
     std::vector<const Account*> customerAccountsVec;
     const Customer* customer = findCustomer(customerName);
     if (customer) {
-        for (const std::string& id : customer->getAccountIds()) {
+        for (AccountId id : customer->getAccountIds()) {
             const Account* acc = findAccount(id);
             if (acc) customerAccountsVec.push_back(acc);
         }
@@ -110,237 +186,1733 @@ std::vector<const Account*> Bank::getCustomerAccounts(const std::string& custome
     return customerAccountsVec;
 }
 
+std::size_t Bank::getAccountCount() const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    return idColumn_.size();
+}
 
-// --- Transaction Operation Implementations ---
-std::optional<Transaction> Bank::performDeposit(const std::string& accountId, double amount, const std::string& note) {
-    Account* account = findAccount(accountId);
-    if (!account) {
-        std::cerr << "Error: Deposit failed, account " << accountId << " not found." << std::endl;
-        return std::nullopt;
-    }
-    if (account->getType() != AccountType::CHECKING) {
-        std::cerr << "Error: Deposit failed, account " << accountId << " is not a checking account." << std::endl;
-        return std::nullopt;
+std::size_t Bank::getAccountCount(AccountType type) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    return typeCounts_[static_cast<std::size_t>(type)];
+}
+
+std::size_t Bank::getAccountsFrom(std::size_t firstSlot, const Account** out, std::size_t capacity) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    std::size_t count = 0;
+    for (std::size_t slot = firstSlot; slot < idColumn_.size() && count < capacity; ++slot) {
+        out[count++] = &accounts_[slot];
     }
-    if (amount <= 0) {
-         std::cerr << "Error: Deposit amount must be positive." << std::endl;
-        return std::nullopt;
+    return count;
+}
+
+// --- Search Implementations ---
+std::vector<SearchSuggestion> Bank::suggestCustomers(const std::string& text, std::size_t limit) const {
+    std::vector<SearchSuggestion> suggestions;
+    if (text.empty()) return suggestions;
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    for (const SearchMatch& match : customerSearch_.find(text, limit, SearchIndex::editsFor(text.size()))) {
+        SearchSuggestion suggestion;
+        suggestion.customerName = customers_[match.entry]->getName();
+        suggestion.edits = match.edits;
+        suggestions.push_back(std::move(suggestion));
     }
+    return suggestions;
+}
 
-    double newBalance = account->getBalance() + amount;
-    account->setBalance(newBalance);
+std::vector<SearchSuggestion> Bank::suggestAccounts(const std::string& text, std::size_t limit) const {
+    std::vector<SearchSuggestion> suggestions;
+    char digits[SearchIndex::kMaxKeyLength];
+    const std::size_t digitCount = accountIdDigits(text, digits);
+    if (digitCount == 0) return suggestions;
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    // Digit strings are dense, so typos turn up many unrelated IDs: they are only
+    // allowed, one of them, when no ID starts with the digits.
+    const std::string_view query(digits, digitCount);
+    std::vector<SearchMatch> matches = accountSearch_.find(query, limit, 0);
+    if (matches.empty()) matches = accountSearch_.find(query, limit, std::min(SearchIndex::editsFor(digitCount), 1u));
+    for (const SearchMatch& match : matches) {
+        SearchSuggestion suggestion;
+        suggestion.customerName = customers_[ownerColumn_[match.entry]]->getName();
+        suggestion.accountId = AccountId::fromPacked(idColumn_[match.entry]);
+        suggestion.edits = match.edits;
+        suggestions.push_back(std::move(suggestion));
+    }
+    return suggestions;
+}
 
-    std::string txId = generateUniqueTransactionId();
-    Transaction depositTx(txId, TransactionType::DEPOSIT, amount, "", accountId, note);
-    recordTransaction(depositTx);
+// --- Balance Aggregate Implementations ---
+// Totals take the registry lock exclusively: no transfer is half-applied while the
+// stripe totals or columns are read, so the sum is an exact point-in-time figure. Both
+// hold settled balances; credits pending in hot accounts' shards are added separately.
+// getLiveTotalBalance skips the exclusive lock for displays that refresh every frame.
+Money Bank::getTotalBalance() const {
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+    Money total = sumStripeTotals(AccountType::SAVINGS) + sumStripeTotals(AccountType::CHECKING);
+    std::lock_guard<std::mutex> hotLock(hotAccountsMutex_);
+    for (const Account* account : hotAccounts_) {
+        total += account->getShardedBalance()->getPendingCredits();
+    }
+    return total;
+}
 
-    std::cout << "Deposit successful to " << accountId << ". New balance: $" << std::fixed << std::setprecision(2) << newBalance << ". TX ID: " << txId << std::endl;
-    return depositTx;
+Money Bank::getTotalBalance(AccountType type) const {
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+    Money total = sumStripeTotals(type);
+    std::lock_guard<std::mutex> hotLock(hotAccountsMutex_);
+    for (const Account* account : hotAccounts_) {
+        if (account->getType() == type) total += account->getShardedBalance()->getPendingCredits();
+    }
+    return total;
 }
 
-std::optional<Transaction> Bank::performWithdraw(const std::string& accountId, double amount, const std::string& note) {
-    Account* account = findAccount(accountId);
-    if (!account) {
-        std::cerr << "Error: Withdrawal failed, account " << accountId << " not found." << std::endl;
-        return std::nullopt;
+Money Bank::getLiveTotalBalance(AccountType type) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    Money total = sumStripeTotals(type);
+    std::lock_guard<std::mutex> hotLock(hotAccountsMutex_);
+    for (const Account* account : hotAccounts_) {
+        if (account->getType() == type) total += account->getShardedBalance()->getPendingCredits();
     }
-    if (account->getType() != AccountType::CHECKING) {
-        std::cerr << "Error: Withdrawal failed, account " << accountId << " is not a checking account." << std::endl;
-        return std::nullopt;
+    return total;
+}
+
+std::vector<Money> Bank::getBranchTotals() const {
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+    std::vector<Money> totals = kernels::sumBalancesByKey(balanceColumn_.data(), branchColumn_.data(),
+                                                          balanceColumn_.size(), AccountId::kMaxBranch + 1);
+    std::lock_guard<std::mutex> hotLock(hotAccountsMutex_);
+    for (const Account* account : hotAccounts_) {
+        totals[account->getAccountId().getBranch()] += account->getShardedBalance()->getPendingCredits();
     }
-    if (amount <= 0) {
-         std::cerr << "Error: Withdrawal amount must be positive." << std::endl;
-        return std::nullopt;
+    return totals;
+}
+
+// --- Hot Account Implementations ---
+bool Bank::promoteHotAccount(AccountId accountId) {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    Account* account = lookupAccount(accountId);
+    if (!account) {
+        MINIBANK_LOG_ERROR("Cannot promote account " << accountId << ", account not found.");
+        return false;
     }
-    if (account->getBalance() < amount) {
-        std::cerr << "Error: Withdrawal failed, account " << accountId << " insufficient balance." << std::endl;
-        return std::nullopt;
+    std::lock_guard<std::mutex> accountLock(lockStripes_[stripeIndex(accountId)].mutex);
+    promoteLocked(*account);
+    return true;
+}
+
+
+// --- Transaction Operation Implementations ---
+// Each operation validates and applies its balance changes and records its transactions
+// while holding the locks of the accounts involved, then releases them before waiting
+// for the journal, so the fsync wait never blocks other operations on those accounts.
+std::optional<Transaction> Bank::performDeposit(AccountId accountId, Money amount, const std::string& note) {
+    std::optional<Transaction> depositTx;
+    const NoteArena::Note storedNote = notes_.intern(note); // Before anything changes
+    Money newBalance;
+    std::uint64_t sequence = 0;
+    {
+        std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+        Account* account = lookupAccount(accountId);
+        if (!account) {
+            MINIBANK_LOG_ERROR("Deposit failed, account " << accountId << " not found.");
+            return std::nullopt;
+        }
+        if (account->getType() != AccountType::CHECKING) {
+            MINIBANK_LOG_ERROR("Deposit failed, account " << accountId << " is not a checking account.");
+            return std::nullopt;
+        }
+        if (!amount.isPositive()) {
+             MINIBANK_LOG_ERROR("Deposit amount must be positive.");
+            return std::nullopt;
+        }
+
+        // Hot accounts take credits through a shard, without the account lock.
+        if (ShardedBalance* sharded = account->getShardedBalance()) {
+            ShardedBalance::Shard& shard = sharded->localShard();
+            std::lock_guard<std::mutex> shardLock(shard.mutex);
+            if (sharded->tryCredit(shard, amount)) {
+                depositTx.emplace(generateTransactionNumber(), TransactionType::DEPOSIT, amount, AccountId(), accountId, storedNote);
+                sequence = recordTransaction(*depositTx, &shard.postings);
+            }
+        }
+        if (!depositTx) {
+            CreditLock accountLock = lockCreditTarget(*account);
+            if (!adjustBalanceLocked(*account, amount)) {
+                MINIBANK_LOG_ERROR("Deposit failed, account " << accountId << " balance would overflow.");
+                return std::nullopt;
+            }
+            depositTx.emplace(generateTransactionNumber(), TransactionType::DEPOSIT, amount, AccountId(), accountId, storedNote);
+            sequence = recordTransaction(*depositTx);
+        }
+        newBalance = account->getBalance();
     }
+    extendLedgerSegments();
+    commitJournal(sequence);
 
-    double newBalance = account->getBalance() - amount;
-    account->setBalance(newBalance);
+    MINIBANK_LOG_INFO("Deposit successful to " << accountId << ". New balance: $" << newBalance << ". TX ID: " << depositTx->getTransactionId());
+    return depositTx;
+}
 
-    std::string txId = generateUniqueTransactionId();
-    Transaction withdrawTx(txId, TransactionType::WITHDRAWAL, amount, accountId, "", note);
-    recordTransaction(withdrawTx);
+std::optional<Transaction> Bank::performWithdraw(AccountId accountId, Money amount, const std::string& note) {
+    std::optional<Transaction> withdrawTx;
+    const NoteArena::Note storedNote = notes_.intern(note); // Before anything changes
+    Money newBalance;
+    std::uint64_t sequence = 0;
+    {
+        std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+        Account* account = lookupAccount(accountId);
+        if (!account) {
+            MINIBANK_LOG_ERROR("Withdrawal failed, account " << accountId << " not found.");
+            return std::nullopt;
+        }
+        if (account->getType() != AccountType::CHECKING) {
+            MINIBANK_LOG_ERROR("Withdrawal failed, account " << accountId << " is not a checking account.");
+            return std::nullopt;
+        }
+        if (!amount.isPositive()) {
+             MINIBANK_LOG_ERROR("Withdrawal amount must be positive.");
+            return std::nullopt;
+        }
+
+        std::lock_guard<std::mutex> accountLock(lockStripes_[stripeIndex(accountId)].mutex);
+        if (!adjustBalanceLocked(*account, -amount)) {
+            MINIBANK_LOG_ERROR("Withdrawal failed, account " << accountId << " insufficient balance.");
+            return std::nullopt;
+        }
+        newBalance = account->getBalance();
+
+        withdrawTx.emplace(generateTransactionNumber(), TransactionType::WITHDRAWAL, amount, accountId, AccountId(), storedNote);
+        sequence = recordTransaction(*withdrawTx);
+    }
+    extendLedgerSegments();
+    commitJournal(sequence);
 
-    std::cout << "Withdrawal successful from " << accountId << ". New balance: $" << std::fixed << std::setprecision(2) << newBalance << ". TX ID: " << txId << std::endl;
+    MINIBANK_LOG_INFO("Withdrawal successful from " << accountId << ". New balance: $" << newBalance << ". TX ID: " << withdrawTx->getTransactionId());
     return withdrawTx;
 }
 
-std::optional<Transaction> Bank::performTransfer(const std::string& sourceAccountId, const std::string& destinationAccountId, double amount, const std::string& note) {
-    Account* sourceAccount = findAccount(sourceAccountId);
-    Account* destinationAccount = findAccount(destinationAccountId);
+std::optional<Transaction> Bank::performTransfer(AccountId sourceAccountId, AccountId destinationAccountId, Money amount, const std::string& note) {
+    std::optional<Transaction> transferOutTx;
+    const NoteArena::Note storedNote = notes_.intern(note); // Before anything changes
+    std::uint64_t sequence = 0;
+    {
+        std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+        Account* sourceAccount = lookupAccount(sourceAccountId);
+        Account* destinationAccount = lookupAccount(destinationAccountId);
+
+        if (!sourceAccount) {
+            MINIBANK_LOG_ERROR("Transfer failed, source account " << sourceAccountId << " not found.");
+            return std::nullopt;
+        }
+        if (!destinationAccount) {
+            MINIBANK_LOG_ERROR("Transfer failed, destination account " << destinationAccountId << " not found.");
+            return std::nullopt;
+        }
+        if (!amount.isPositive()) {
+             MINIBANK_LOG_ERROR("Transfer amount must be positive.");
+            return std::nullopt;
+        }
+        if (sourceAccountId == destinationAccountId) {
+             MINIBANK_LOG_ERROR("Cannot transfer to the same account.");
+            return std::nullopt;
+        }
+
+        if (sourceAccount->getType() == AccountType::SAVINGS) {
+            if (destinationAccount->getType() != AccountType::CHECKING || &sourceAccount->getOwner() != &destinationAccount->getOwner()) {
+                MINIBANK_LOG_ERROR("Transfer failed. Savings account can only transfer to own Checking account.");
+                return std::nullopt;
+            }
+        }
+
+        auto recordTransfer = [&](std::vector<std::size_t>* destinationPostings) {
+            transferOutTx.emplace(generateTransactionNumber(), TransactionType::TRANSFER_OUT, amount, sourceAccountId, destinationAccountId, storedNote);
+            recordTransaction(*transferOutTx, destinationPostings);
+
+            Transaction transferInTx(generateTransactionNumber(), TransactionType::TRANSFER_IN, amount, sourceAccountId, destinationAccountId, storedNote);
+            // One commit covers both halves: the journal is ordered, so the later record's
+            // durability implies the earlier one's.
+            sequence = recordTransaction(transferInTx, destinationPostings);
+        };
+
+        const std::size_t sourceStripe = stripeIndex(sourceAccountId);
+        const std::size_t destinationStripe = stripeIndex(destinationAccountId);
+
+        // A hot destination is credited through a shard, so only the source is locked.
+        if (ShardedBalance* sharded = destinationAccount->getShardedBalance()) {
+            std::lock_guard<std::mutex> sourceLock(lockStripes_[sourceStripe].mutex);
+            if (!adjustBalanceLocked(*sourceAccount, -amount)) {
+                MINIBANK_LOG_ERROR("Transfer failed, source account " << sourceAccountId << " insufficient balance.");
+                return std::nullopt;
+            }
+            ShardedBalance::Shard& shard = sharded->localShard();
+            std::lock_guard<std::mutex> shardLock(shard.mutex);
+            if (sharded->tryCredit(shard, amount)) {
+                recordTransfer(&shard.postings);
+            } else {
+                adjustBalanceLocked(*sourceAccount, amount); // Undo; the debit made room for it.
+            }
+        }
 
-    if (!sourceAccount) {
-        std::cerr << "Error: Transfer failed, source account " << sourceAccountId << " not found." << std::endl;
-        return std::nullopt;
+        if (!transferOutTx) {
+            // Lock both accounts in stripe order; accounts sharing a stripe take it once.
+            std::unique_lock<std::mutex> sourceLock;
+            CreditLock destinationLock;
+            if (destinationStripe < sourceStripe) {
+                destinationLock = lockCreditTarget(*destinationAccount);
+                sourceLock = std::unique_lock<std::mutex>(lockStripes_[sourceStripe].mutex);
+            } else {
+                sourceLock = std::unique_lock<std::mutex>(lockStripes_[sourceStripe].mutex);
+                if (destinationStripe != sourceStripe) destinationLock = lockCreditTarget(*destinationAccount);
+            }
+
+            if (!adjustBalanceLocked(*sourceAccount, -amount)) {
+                MINIBANK_LOG_ERROR("Transfer failed, source account " << sourceAccountId << " insufficient balance.");
+                return std::nullopt;
+            }
+            if (!adjustBalanceLocked(*destinationAccount, amount)) {
+                adjustBalanceLocked(*sourceAccount, amount); // Undo; the debit made room for it.
+                MINIBANK_LOG_ERROR("Transfer failed, destination account " << destinationAccountId << " balance would overflow.");
+                return std::nullopt;
+            }
+            recordTransfer(nullptr);
+        }
     }
-    if (!destinationAccount) {
-        std::cerr << "Error: Transfer failed, destination account " << destinationAccountId << " not found." << std::endl;
-        return std::nullopt;
+    extendLedgerSegments();
+    commitJournal(sequence);
+
+    MINIBANK_LOG_INFO("Transfer successful from " << sourceAccountId << " to " << destinationAccountId << ". Amount: $" << amount << ". TX ID (Out): " << transferOutTx->getTransactionId());
+    return transferOutTx;
+}
+
+
+// --- Batch Operation Implementations ---
+namespace {
+
+// Orders the applied operations of an all-or-nothing batch for recording. The batch
+// was only checked as a whole, so its records go deposits first, then transfers, then
+// withdrawals, and each transfer waits until the records before it fund its source.
+// Replaying the ledger then keeps every account at or above zero, unless the last
+// transfers only fund each other in a cycle (A pays B, B pays A, neither holding the
+// amount); no order avoids a dip for those, and they are recorded in operation order.
+// Caller holds the stripes of every account involved, with the batch applied.
+std::vector<std::size_t> replayOrder(const std::vector<BatchOperation>& operations,
+                                     const std::vector<Account*>& sources,
+                                     const std::vector<Account*>& destinations,
+                                     const std::vector<BatchStatus>& statuses) {
+    std::vector<std::size_t> order;
+    order.reserve(operations.size());
+
+    // Balance each account has in the replay once the deposits are recorded: its balance
+    // now, with the transfers and withdrawals not yet recorded taken back out.
+    std::unordered_map<const Account*, std::int64_t> running;
+    auto balanceOf = [&](const Account* account) -> std::int64_t& {
+        auto inserted = running.try_emplace(account, 0);
+        if (inserted.second) inserted.first->second = account->getSettledBalance().getCents();
+        return inserted.first->second;
+    };
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        if (statuses[i] != BatchStatus::APPLIED) continue;
+        const std::int64_t cents = operations[i].amount.getCents();
+        switch (operations[i].type) {
+            case BatchOperationType::DEPOSIT:
+                order.push_back(i);
+                break;
+            case BatchOperationType::WITHDRAW:
+                balanceOf(sources[i]) += cents;
+                break;
+            case BatchOperationType::TRANSFER:
+                balanceOf(sources[i]) += cents;
+                balanceOf(destinations[i]) -= cents;
+                break;
+        }
     }
-    if (amount <= 0) {
-         std::cerr << "Error: Transfer amount must be positive." << std::endl;
-        return std::nullopt;
+
+    // Transfers wait per source, in operation order, until the source can cover them.
+    // Recording one may release the queue of its destination.
+    std::unordered_map<const Account*, std::deque<std::size_t>> waiting;
+    std::vector<bool> recorded(operations.size(), false);
+    auto record = [&](std::size_t i) {
+        order.push_back(i);
+        recorded[i] = true;
+        balanceOf(sources[i]) -= operations[i].amount.getCents();
+        balanceOf(destinations[i]) += operations[i].amount.getCents();
+    };
+    auto release = [&](const Account* account) {
+        std::vector<const Account*> funded{account};
+        while (!funded.empty()) {
+            auto queue = waiting.find(funded.back());
+            funded.pop_back();
+            if (queue == waiting.end()) continue;
+            std::deque<std::size_t>& pending = queue->second;
+            while (!pending.empty() && balanceOf(sources[pending.front()]) >= operations[pending.front()].amount.getCents()) {
+                const std::size_t i = pending.front();
+                pending.pop_front();
+                record(i);
+                funded.push_back(destinations[i]);
+            }
+        }
+    };
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        if (statuses[i] != BatchStatus::APPLIED || operations[i].type != BatchOperationType::TRANSFER) continue;
+        std::deque<std::size_t>& pending = waiting[sources[i]];
+        if (!pending.empty() || balanceOf(sources[i]) < operations[i].amount.getCents()) {
+            pending.push_back(i);
+            continue;
+        }
+        record(i);
+        release(destinations[i]);
     }
-    if (sourceAccount->getBalance() < amount) {
-        std::cerr << "Error: Transfer failed, source account " << sourceAccountId << " insufficient balance." << std::endl;
-        return std::nullopt;
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        if (statuses[i] == BatchStatus::APPLIED && operations[i].type == BatchOperationType::TRANSFER && !recorded[i]) {
+            order.push_back(i);
+        }
     }
-    if (sourceAccountId == destinationAccountId) {
-         std::cerr << "Error: Cannot transfer to the same account." << std::endl;
-        return std::nullopt;
+
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        if (statuses[i] == BatchStatus::APPLIED && operations[i].type == BatchOperationType::WITHDRAW) order.push_back(i);
     }
+    return order;
+}
 
-    if (sourceAccount->getType() == AccountType::SAVINGS) {
-        if (destinationAccount->getType() != AccountType::CHECKING || sourceAccount->getOwnerName() != destinationAccount->getOwnerName()) {
-            std::cerr << "Error: Transfer failed. Savings account can only transfer to own Checking account." << std::endl;
-            return std::nullopt;
+} // namespace
+
+// A batch resolves every account once, then locks the stripes of all accounts it
+// touches in index order, the same order single operations use, so batches and single
+// operations cannot deadlock. Transactions get one block of IDs and one timestamp, and
+// the journal is waited on once for the last record.
+std::vector<BatchStatus> Bank::executeBatch(const std::vector<BatchOperation>& operations, BatchMode mode) {
+    const std::size_t count = operations.size();
+    std::vector<BatchStatus> statuses(count, BatchStatus::APPLIED);
+    std::size_t applied = 0;
+    std::uint64_t sequence = 0;
+    {
+        std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+
+        std::vector<Account*> sources(count, nullptr);
+        std::vector<Account*> destinations(count, nullptr);
+        std::bitset<kLockStripes> stripes;
+        bool allValid = true;
+        for (std::size_t i = 0; i < count; ++i) {
+            statuses[i] = validateBatchOperation(operations[i], sources[i], destinations[i]);
+            if (statuses[i] != BatchStatus::APPLIED) {
+                allValid = false;
+                continue;
+            }
+            if (sources[i]) stripes.set(stripeIndex(operations[i].sourceAccountId));
+            if (destinations[i]) stripes.set(stripeIndex(operations[i].destinationAccountId));
+        }
+
+        if (mode == BatchMode::ALL_OR_NOTHING && !allValid) {
+            for (BatchStatus& status : statuses) {
+                if (status == BatchStatus::APPLIED) status = BatchStatus::NOT_APPLIED;
+            }
+            MINIBANK_LOG_ERROR("Batch rejected, some of its " << count << " operations are invalid.");
+            return statuses;
+        }
+
+        // Notes are stored before any balance changes, so a full arena fails cleanly.
+        std::vector<NoteArena::Note> notes(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (statuses[i] == BatchStatus::APPLIED) notes[i] = notes_.intern(operations[i].note);
         }
+
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(std::min(stripes.count(), count * 2));
+        for (std::size_t stripe = 0; stripe < kLockStripes; ++stripe) {
+            if (stripes.test(stripe)) locks.emplace_back(lockStripes_[stripe].mutex);
+        }
+
+        if (mode == BatchMode::ALL_OR_NOTHING) {
+            if (!applyNetEffects(operations, sources, destinations, statuses)) {
+                MINIBANK_LOG_ERROR("Batch rejected, the net effect of its " << count
+                                   << " operations does not fit the account balances.");
+                return statuses;
+            }
+        } else {
+            applyInOrder(operations, sources, destinations, statuses);
+        }
+
+        std::size_t records = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (statuses[i] != BatchStatus::APPLIED) continue;
+            records += (operations[i].type == BatchOperationType::TRANSFER) ? 2 : 1;
+        }
+        std::uint64_t nextNumber = nextTransactionNumber_.fetch_add(records, std::memory_order_relaxed);
+        const auto timestamp = std::chrono::system_clock::now();
+        auto record = [&](TransactionType type, std::size_t i, AccountId source, AccountId destination) {
+            Transaction transaction(nextNumber++, type, operations[i].amount, source, destination,
+                                    notes[i], timestamp);
+            sequence = recordTransaction(transaction);
+        };
+        // Best-effort batches are recorded in operation order, matching how they were
+        // applied; all-or-nothing batches in replayOrder.
+        std::vector<std::size_t> order;
+        if (mode == BatchMode::ALL_OR_NOTHING) {
+            order = replayOrder(operations, sources, destinations, statuses);
+        } else {
+            order.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (statuses[i] == BatchStatus::APPLIED) order.push_back(i);
+            }
+        }
+        for (std::size_t i : order) {
+            const BatchOperation& operation = operations[i];
+            switch (operation.type) {
+                case BatchOperationType::DEPOSIT:
+                    record(TransactionType::DEPOSIT, i, AccountId(), operation.destinationAccountId);
+                    break;
+                case BatchOperationType::WITHDRAW:
+                    record(TransactionType::WITHDRAWAL, i, operation.sourceAccountId, AccountId());
+                    break;
+                case BatchOperationType::TRANSFER:
+                    record(TransactionType::TRANSFER_OUT, i, operation.sourceAccountId, operation.destinationAccountId);
+                    record(TransactionType::TRANSFER_IN, i, operation.sourceAccountId, operation.destinationAccountId);
+                    break;
+            }
+        }
+        applied = order.size();
     }
+    extendLedgerSegments();
+    commitJournal(sequence);
 
-    sourceAccount->setBalance(sourceAccount->getBalance() - amount);
-    destinationAccount->setBalance(destinationAccount->getBalance() + amount);
+    MINIBANK_LOG_INFO("Batch executed: " << applied << " of " << count << " operations applied.");
+    return statuses;
+}
 
-    std::string txIdOut = generateUniqueTransactionId();
-    Transaction transferOutTx(txIdOut, TransactionType::TRANSFER_OUT, amount, sourceAccountId, destinationAccountId, note);
-    recordTransaction(transferOutTx);
 
-    std::string txIdIn = generateUniqueTransactionId();
-    Transaction transferInTx(txIdIn, TransactionType::TRANSFER_IN, amount, sourceAccountId, destinationAccountId, note);
-    recordTransaction(transferInTx);
+// --- Bulk Import Implementations ---
+namespace {
 
-    std::cout << "Transfer successful from " << sourceAccountId << " to " << destinationAccountId << ". Amount: $" << amount << ". TX ID (Out): " << txIdOut << std::endl;
-    return transferOutTx;
+ImportStatus toImportStatus(BatchStatus status) {
+    switch (status) {
+        case BatchStatus::APPLIED: return ImportStatus::APPLIED;
+        case BatchStatus::ACCOUNT_NOT_FOUND: return ImportStatus::ACCOUNT_NOT_FOUND;
+        case BatchStatus::NOT_CHECKING_ACCOUNT: return ImportStatus::NOT_CHECKING_ACCOUNT;
+        case BatchStatus::SAME_ACCOUNT: return ImportStatus::SAME_ACCOUNT;
+        case BatchStatus::TRANSFER_NOT_ALLOWED: return ImportStatus::TRANSFER_NOT_ALLOWED;
+        case BatchStatus::INSUFFICIENT_FUNDS: return ImportStatus::INSUFFICIENT_FUNDS;
+        case BatchStatus::BALANCE_OVERFLOW: return ImportStatus::BALANCE_OVERFLOW;
+        default: return ImportStatus::INVALID_AMOUNT;
+    }
+}
+
+} // namespace
+
+// An import holds the registry lock exclusively, which keeps every operation out, so
+// balances are changed without taking account stripes and the records are not
+// interleaved with live ones.
+std::vector<ImportStatus> Bank::importRecords(const std::vector<ImportRecord>& records) {
+    std::vector<ImportStatus> statuses(records.size(), ImportStatus::APPLIED);
+    std::uint64_t sequence = 0;
+    {
+        std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+        const auto customerCount = static_cast<std::size_t>(std::count_if(records.begin(), records.end(),
+            [](const ImportRecord& record) { return record.type == ImportRecordType::CUSTOMER; }));
+        reserveRegistry(customerCount, customerCount * 2);
+
+        // Future timestamps are refused too: live operations stamp now() and would
+        // otherwise land before them.
+        const auto now = std::chrono::system_clock::now();
+        auto latest = transactions_.empty() ? std::chrono::system_clock::time_point::min()
+                                            : transactions_[transactions_.size() - 1].getTimePoint();
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            statuses[i] = (records[i].type == ImportRecordType::CUSTOMER)
+                              ? importCustomer(records[i], sequence)
+                              : importTransaction(records[i], latest, now, sequence);
+        }
+    }
+    extendLedgerSegments();
+    commitJournal(sequence);
+    return statuses;
+}
+
+// Registers an imported customer under the IDs it had in the old book, or under new
+// ones if it has none. Caller holds registryMutex_ exclusively.
+ImportStatus Bank::importCustomer(const ImportRecord& record, std::uint64_t& sequence) {
+    std::string name(record.text);
+    if (customerExists(name)) return ImportStatus::CUSTOMER_EXISTS;
+
+    AccountId savingsAccountId = record.accountId;
+    AccountId checkingAccountId = record.secondAccountId;
+    if (savingsAccountId.isValid() || checkingAccountId.isValid()) {
+        if (savingsAccountId.getTypeCode() != AccountId::kSavingsTypeCode ||
+            checkingAccountId.getTypeCode() != AccountId::kCheckingTypeCode) {
+            return ImportStatus::INVALID_ACCOUNT_ID;
+        }
+        if (accountExists(savingsAccountId) || accountExists(checkingAccountId)) return ImportStatus::ACCOUNT_EXISTS;
+        restoredAccounts_ = true; // New IDs must now avoid the imported ones
+    } else {
+        savingsAccountId = generateUniqueAccountId(AccountType::SAVINGS);
+        checkingAccountId = generateUniqueAccountId(AccountType::CHECKING);
+    }
+
+    addCustomer(name);
+    const auto ownerIndex = static_cast<std::uint32_t>(customers_.size() - 1);
+    addAccount(AccountType::SAVINGS, savingsAccountId, ownerIndex, Money::zero());
+    addAccount(AccountType::CHECKING, checkingAccountId, ownerIndex, Money::zero());
+    if (journal_) {
+        sequence = journal_->appendCustomerRegistered(name, savingsAccountId, checkingAccountId);
+    }
+    return ImportStatus::APPLIED;
 }
 
+// Applies an imported balance, deposit, withdrawal or transfer under the same rules as
+// the live operations, except that an opening balance may go to any account, and
+// records it with its original timestamp. Caller holds registryMutex_ exclusively.
+ImportStatus Bank::importTransaction(const ImportRecord& record, std::chrono::system_clock::time_point& latest,
+                                     std::chrono::system_clock::time_point now, std::uint64_t& sequence) {
+    if (!record.amount.isPositive()) return ImportStatus::INVALID_AMOUNT;
+    if (record.timestamp < latest || record.timestamp > now) return ImportStatus::OUT_OF_ORDER;
+
+    Account* source = nullptr;
+    Account* destination = nullptr;
+    if (record.type == ImportRecordType::BALANCE) {
+        destination = lookupAccount(record.accountId);
+        if (!destination) return ImportStatus::ACCOUNT_NOT_FOUND;
+    } else {
+        BatchOperation operation;
+        operation.amount = record.amount;
+        if (record.type == ImportRecordType::DEPOSIT) {
+            operation.type = BatchOperationType::DEPOSIT;
+            operation.destinationAccountId = record.accountId;
+        } else if (record.type == ImportRecordType::WITHDRAW) {
+            operation.type = BatchOperationType::WITHDRAW;
+            operation.sourceAccountId = record.accountId;
+        } else {
+            operation.type = BatchOperationType::TRANSFER;
+            operation.sourceAccountId = record.accountId;
+            operation.destinationAccountId = record.secondAccountId;
+        }
+        const BatchStatus status = validateBatchOperation(operation, source, destination);
+        if (status != BatchStatus::APPLIED) return toImportStatus(status);
+    }
+
+    // The note is stored before any balance changes, so a full arena fails cleanly.
+    const NoteArena::Note note = notes_.intern((record.type == ImportRecordType::BALANCE && record.text.empty())
+                                                   ? std::string_view("Opening balance")
+                                                   : std::string_view(record.text));
+    if (source && !adjustBalanceLocked(*source, -record.amount)) return ImportStatus::INSUFFICIENT_FUNDS;
+    if (destination && !adjustBalanceLocked(*destination, record.amount)) {
+        if (source) adjustBalanceLocked(*source, record.amount); // Undo; the debit made room for it.
+        return ImportStatus::BALANCE_OVERFLOW;
+    }
+
+    const AccountId sourceId = source ? source->getAccountId() : AccountId();
+    const AccountId destinationId = destination ? destination->getAccountId() : AccountId();
+    auto recordAs = [&](TransactionType type) {
+        Transaction transaction(generateTransactionNumber(), type, record.amount, sourceId, destinationId, note,
+                                record.timestamp);
+        sequence = recordTransaction(transaction);
+    };
+    switch (record.type) {
+        case ImportRecordType::WITHDRAW:
+            recordAs(TransactionType::WITHDRAWAL);
+            break;
+        case ImportRecordType::TRANSFER:
+            recordAs(TransactionType::TRANSFER_OUT);
+            recordAs(TransactionType::TRANSFER_IN);
+            break;
+        default:
+            recordAs(TransactionType::DEPOSIT);
+            break;
+    }
+    latest = record.timestamp;
+    return ImportStatus::APPLIED;
+}
 
 // --- Transaction Record and Reporting Implementations ---
-void Bank::recordTransaction(const Transaction& transaction) {
-    transactions_.push_back(transaction);
+// Appends a transaction to the ledger and its indexes. Returns the journal sequence of
+// the record (0 without a journal); callers pass it to commitJournal once the whole
+// operation is recorded and its locks are released. The caller holds the registry lock
+// and the locks of the accounts involved, which guard their posting lists; the ledger
+// append itself takes no lock, only waiting for earlier appends to publish.
+// Credits taken through a hot account's shard pass that shard's posting list as
+// destinationPostings; the shard lock, held by the caller, guards it instead.
+std::uint64_t Bank::recordTransaction(const Transaction& transaction, std::vector<std::size_t>* destinationPostings) {
+    const std::size_t position = transactions_.push_back(transaction);
+
+    // Index the record under every account it touches. Postings of one account are
+    // appended under its lock, so each list stays in ledger order.
+    const AccountId sourceId = transaction.getSourceAccountId();
+    const AccountId destinationId = transaction.getDestinationAccountId();
+    if (sourceId.isValid()) {
+        accountPostings_[lookupAccount(sourceId)->getSlot()].push_back(position);
+    }
+    if (destinationId.isValid() && destinationId != sourceId) {
+        if (destinationPostings) {
+            destinationPostings->push_back(position);
+        } else {
+            accountPostings_[lookupAccount(destinationId)->getSlot()].push_back(position);
+        }
+    }
+
+    updateCustomerAggregates(transaction);
+    return journal_ ? journal_->appendTransaction(transaction, transaction.getNote(notes_)) : 0;
 }
 
-std::vector<Transaction> Bank::getAllTransactionsChronological() const {
-    return transactions_;
+// Never waits for the segments: if another thread is extending them, the records
+// appended meanwhile are left to the next operation or query.
+void Bank::extendLedgerSegments() const {
+    std::unique_lock<std::mutex> segmentsLock(segmentsMutex_, std::try_to_lock);
+    if (!segmentsLock.owns_lock()) return;
+    ledgerSegments_.extend(transactions_, transactions_.size(), accounts_.size());
 }
 
-std::vector<Transaction> Bank::getCustomerTransactionsChronological(const std::string& customerName) const {
-    std::vector<Transaction> customerTxns;
-    const Customer* customer = findCustomer(customerName);
-    if (!customer) return customerTxns;
+void Bank::commitJournal(std::uint64_t sequence) {
+    if (journal_ && sequence != 0) {
+        journal_->waitDurable(sequence);
+    }
+}
+
+// Calls visit(customer, balanceDelta) once for every customer a record touches. Each
+// half of a transfer is a separate record, so the balance effect is taken from the
+// side the record represents: TRANSFER_OUT debits the source owner, TRANSFER_IN credits
+// the destination owner.
+template <typename Visitor>
+void Bank::forEachCustomerEffect(const Transaction& transaction, Visitor&& visit) const {
+    Customer* sourceOwner = lookupOwner(transaction.getSourceAccountId());
+    Customer* destinationOwner = lookupOwner(transaction.getDestinationAccountId());
 
-    const auto& custAccountIds = customer->getAccountIds();
-    for (const auto& tx : transactions_) {
-        bool isSource = !tx.getSourceAccountId().empty() &&
-                        (std::find(custAccountIds.begin(), custAccountIds.end(), tx.getSourceAccountId()) != custAccountIds.end());
-        bool isDest = !tx.getDestinationAccountId().empty() &&
-                      (std::find(custAccountIds.begin(), custAccountIds.end(), tx.getDestinationAccountId()) != custAccountIds.end());
-        if (isSource || isDest) {
-            customerTxns.push_back(tx);
+    Money sourceDelta;
+    Money destinationDelta;
+    switch (transaction.getType()) {
+        case TransactionType::DEPOSIT:
+        case TransactionType::TRANSFER_IN:
+        case TransactionType::INTEREST:
+            destinationDelta = transaction.getAmount();
+            break;
+        case TransactionType::WITHDRAWAL:
+        case TransactionType::TRANSFER_OUT:
+            sourceDelta = -transaction.getAmount();
+            break;
+    }
+
+    if (sourceOwner && sourceOwner == destinationOwner) {
+        visit(sourceOwner, sourceDelta + destinationDelta);
+        return;
+    }
+    if (sourceOwner) visit(sourceOwner, sourceDelta);
+    if (destinationOwner) visit(destinationOwner, destinationDelta);
+}
+
+// Applies a recorded transaction to the running aggregates of every customer it touches.
+void Bank::updateCustomerAggregates(const Transaction& transaction) {
+    forEachCustomerEffect(transaction, [&](Customer* customer, Money delta) {
+        customer->recordActivity(delta, transaction.getTimestamp());
+    });
+}
+
+// --- Transaction Query Implementations ---
+namespace {
+
+// Range [begin, end) of the count entries of a stream whose ledger positions lie in
+// [firstPosition, lastPosition), where positionAt(i) is the position of the i-th entry.
+// Posting lists hold ascending positions, so positionAt is monotonic.
+template <typename PositionAt>
+std::pair<std::size_t, std::size_t> queryBounds(std::size_t count, PositionAt positionAt,
+                                                std::size_t firstPosition, std::size_t lastPosition) {
+    auto firstAtOrAfter = [&](std::size_t position) {
+        std::size_t low = 0;
+        std::size_t high = count;
+        while (low < high) {
+            const std::size_t middle = low + (high - low) / 2;
+            if (positionAt(middle) < position) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
         }
+        return low;
+    };
+    return {firstAtOrAfter(firstPosition), firstAtOrAfter(lastPosition)};
+}
+
+std::vector<Transaction> copyRecords(TransactionCursor cursor) {
+    std::vector<const Transaction*> records(cursor.remainingUpperBound());
+    records.resize(cursor.next(records.data(), records.size()));
+    std::vector<Transaction> copies;
+    copies.reserve(records.size());
+    for (const Transaction* record : records) {
+        copies.push_back(*record);
     }
-    return customerTxns;
+    return copies;
 }
 
-std::vector<Transaction> Bank::getAccountTransactionsChronological(const std::string& accountId) const {
-    std::vector<Transaction> accountTxns;
-    if (!accountExists(accountId)) return accountTxns;
+} // namespace
+
+TransactionCursor Bank::queryTransactions(const TransactionQuery& query) const {
+    TransactionCursor cursor;
+    cursor.ledger_ = &transactions_;
+    cursor.order_ = query.order;
+    cursor.remaining_ = query.limit;
+    if (query.from >= query.to || query.firstPosition >= query.lastPosition) return cursor;
 
-    for (const auto& tx : transactions_) {
-        if (tx.getSourceAccountId() == accountId || tx.getDestinationAccountId() == accountId) {
-            accountTxns.push_back(tx);
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    // A time range is turned into a range of ledger positions once, through the daily
+    // segments, so streams are then bounded by position alone and an account's stream
+    // is skipped when the filters show it has no records in the range.
+    std::size_t firstPosition = query.firstPosition;
+    std::size_t lastPosition = query.lastPosition;
+    const bool timeBounded = query.from != std::chrono::system_clock::time_point::min() ||
+                             query.to != std::chrono::system_clock::time_point::max();
+    std::unique_lock<std::mutex> segmentsLock(segmentsMutex_, std::defer_lock);
+    if (timeBounded) {
+        segmentsLock.lock();
+        // Catches up on the records appended since the last operation's extension.
+        ledgerSegments_.extend(transactions_, transactions_.size(), accounts_.size());
+        const auto range = ledgerSegments_.positionRange(transactions_, query.from, query.to);
+        firstPosition = std::max(firstPosition, range.first);
+        lastPosition = std::min(lastPosition, range.second);
+        if (firstPosition >= lastPosition) return cursor;
+    }
+    auto addAccount = [&](AccountId accountId) {
+        if (timeBounded && !ledgerSegments_.mayContain(accountId, firstPosition, lastPosition)) return;
+        addAccountStreams(cursor, accountId, firstPosition, lastPosition);
+    };
+
+    switch (query.scope) {
+        case TransactionQuery::Scope::ALL: {
+            auto identity = [](std::size_t i) { return i; };
+            TransactionCursor::Stream ledger;
+            std::tie(ledger.begin, ledger.end) = queryBounds(transactions_.size(), identity, firstPosition, lastPosition);
+            cursor.addStream(ledger);
+            break;
         }
+        case TransactionQuery::Scope::CUSTOMER:
+            if (const Customer* customer = lookupCustomer(query.customerName)) {
+                for (AccountId accountId : customer->getAccountIds()) {
+                    addAccount(accountId);
+                }
+            }
+            break;
+        case TransactionQuery::Scope::ACCOUNT:
+            addAccount(query.accountId);
+            break;
     }
-    return accountTxns;
+    cursor.skip(query.offset);
+    return cursor;
+}
+
+// A record is published to the ledger while its accounts' locks (or its shard's) are
+// held, and its postings are appended before they are released. A query locks each
+// list before bounding it, so it finds every record below an earlier count.
+std::size_t Bank::getTransactionCount() const {
+    return transactions_.size();
+}
+
+const NoteArena& Bank::getNotes() const {
+    return notes_;
+}
+
+std::vector<Transaction> Bank::getAllTransactionsChronological() const {
+    return copyRecords(queryTransactions(TransactionQuery::all()));
+}
+
+std::vector<Transaction> Bank::getCustomerTransactionsChronological(const std::string& customerName) const {
+    return copyRecords(queryTransactions(TransactionQuery::forCustomer(customerName)));
+}
+
+std::vector<Transaction> Bank::getAccountTransactionsChronological(AccountId accountId) const {
+    return copyRecords(queryTransactions(TransactionQuery::forAccount(accountId)));
 }
 
-// Helper for writing reports (assuming it's defined or moved to Utils)
-bool writeReportToFile(const std::string& filename, const std::vector<Transaction>& transactions) {
-     std::ofstream outFile(filename);
-    if (!outFile.is_open()) {
-        std::cerr << "Error: Cannot open report file " << filename << std::endl;
+// Writes a report of count transactions, fetched in order by recordAt (see
+// ReportWriter::writeTransactions), framed by a header and a totals footer.
+template <typename RecordAt>
+bool writeReportToFile(const std::string& filename, const NoteArena& notes, std::size_t count, RecordAt recordAt) {
+    try {
+        ReportTotals totals;
+        for (std::size_t i = 0; i < count; ++i) totals.add(recordAt(i));
+        ReportWriter writer(filename);
+        writer.writeHeader();
+        if (count == 0) {
+            writer.writeText("No transaction records.\n");
+        } else {
+            writer.writeTransactions(count, recordAt, notes);
+        }
+        writer.writeFooter(totals);
+        writer.close();
+    } catch (const std::runtime_error& e) {
+        MINIBANK_LOG_ERROR(e.what());
         return false;
     }
-    outFile << "Transaction Report - Generated: " << banking_system::utils::getCurrentDateString() << "\n";
-    outFile << "--------------------------------------------------\n";
-    if (transactions.empty()) {
-        outFile << "No transaction records.\n";
-    } else {
-        for (const auto& tx : transactions) {
-            outFile << tx.toString() << "\n";
+    MINIBANK_LOG_INFO("Report successfully generated to file: " << filename);
+    return true;
+}
+
+// Reports a cursor's records. The writer needs random access, so only pointers to the
+// records are gathered first; the records themselves are not copied.
+bool writeReportToFile(const std::string& filename, const NoteArena& notes, TransactionCursor cursor) {
+    std::vector<const Transaction*> records(cursor.remainingUpperBound());
+    records.resize(cursor.next(records.data(), records.size()));
+    return writeReportToFile(filename, notes, records.size(),
+                             [&records](std::size_t i) -> const Transaction& { return *records[i]; });
+}
+
+namespace {
+
+// Key of a report file in reportJobs_, so "r.txt" and "./r.txt" name one file.
+std::string reportPathKey(const std::string& filename) {
+    std::error_code error;
+    const std::filesystem::path path = std::filesystem::absolute(filename, error);
+    return error ? filename : path.lexically_normal().string();
+}
+
+} // namespace
+
+// Runs the job that owns the path, creating it when the path is new or was last written
+// for another scope. The map lock is held only for the lookup, so reports to different
+// files are written concurrently.
+bool Bank::updateReport(const std::string& scopeKey, const TransactionQuery& scope, const std::string& filename) const {
+    std::shared_ptr<ReportJob> job;
+    {
+        std::lock_guard<std::mutex> lock(reportJobsMutex_);
+        ReportJobEntry& entry = reportJobs_[reportPathKey(filename)];
+        if (!entry.job || entry.scopeKey != scopeKey) {
+            entry.scopeKey = scopeKey;
+            entry.job = std::make_shared<ReportJob>(scope);
+        }
+        entry.lastUse = ++reportJobClock_;
+        job = entry.job;
+        if (reportJobs_.size() > kMaxReportJobs) {
+            auto oldest = std::min_element(reportJobs_.begin(), reportJobs_.end(),
+                [](const auto& a, const auto& b) { return a.second.lastUse < b.second.lastUse; });
+            reportJobs_.erase(oldest);
         }
     }
-    outFile << "--------------------------------------------------\n";
-    outFile.close();
-    std::cout << "Report successfully generated to file: " << filename << std::endl;
+    try {
+        const std::size_t written = job->update(*this, filename);
+        MINIBANK_LOG_INFO("Report successfully generated to file: " << filename << " (" << written << " records written)");
+    } catch (const std::runtime_error& e) {
+        MINIBANK_LOG_ERROR(e.what());
+        return false;
+    }
     return true;
 }
 
 bool Bank::generateGlobalReport(const std::string& filename) const {
-    return writeReportToFile(filename, getAllTransactionsChronological());
+    return updateReport("*", TransactionQuery::all(), filename);
 }
 
 bool Bank::generateCustomerReport(const std::string& customerName, const std::string& filename) const {
     const Customer* customer = findCustomer(customerName);
     if (!customer) {
-        std::cerr << "Error: Customer " << customerName << " not found. Cannot generate report." << std::endl;
+        MINIBANK_LOG_ERROR("Customer " << customerName << " not found. Cannot generate report.");
         return false;
     }
-    return writeReportToFile(filename, getCustomerTransactionsChronological(customerName));
+    return updateReport("C:" + customerName, TransactionQuery::forCustomer(customerName), filename);
 }
 
-bool Bank::generateAccountReport(const std::string& accountId, const std::string& filename) const {
-    if (!accountExists(accountId)) {
-        std::cerr << "Error: Account " << accountId << " not found. Cannot generate report." << std::endl;
+bool Bank::generateAccountReport(AccountId accountId, const std::string& filename) const {
+    if (!findAccount(accountId)) {
+        MINIBANK_LOG_ERROR("Account " << accountId << " not found. Cannot generate report.");
         return false;
     }
-    return writeReportToFile(filename, getAccountTransactionsChronological(accountId));
+    return updateReport("A:" + std::to_string(accountId.getPacked()), TransactionQuery::forAccount(accountId), filename);
+}
+
+// Forgets the job of a file about to be overwritten by other means.
+void Bank::releaseReportPath(const std::string& filename) const {
+    std::lock_guard<std::mutex> lock(reportJobsMutex_);
+    reportJobs_.erase(reportPathKey(filename));
+}
+
+bool Bank::generateReport(const TransactionQuery& query, const std::string& filename) const {
+    releaseReportPath(filename);
+    return writeReportToFile(filename, notes_, queryTransactions(query));
+}
+
+std::vector<LedgerSegment> Bank::getLedgerSegments() const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMutex_);
+    std::lock_guard<std::mutex> segmentsLock(segmentsMutex_);
+    ledgerSegments_.extend(transactions_, transactions_.size(), accounts_.size());
+    return ledgerSegments_.getSegments();
+}
+
+
+// --- Persistence Implementations ---
+namespace {
+
+// Below this many records, recovery indexing runs on the calling thread.
+constexpr std::size_t kParallelIndexThreshold = std::size_t(1) << 14;
+constexpr unsigned kMaxIndexThreads = 64;
+constexpr std::uint8_t kNoPartition = 0xFF;
+constexpr std::size_t kSnapshotBatch = 4096;
+const char kZeroChunk[NoteArena::kChunkSize] = {}; // Pads the open note chunk in images
+
+// Customer aggregate changes collected by one recovery partition.
+struct PendingActivity {
+    std::uint64_t delta = 0; // Modulo 2^64, like Customer's total
+    std::size_t count = 0;
+    std::time_t latest = 0;
+};
+
+bool fileExists(const std::string& path) {
+    return std::ifstream(path, std::ios::binary).good();
+}
+
+std::int64_t toNanos(std::chrono::system_clock::time_point timePoint) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromNanos(std::int64_t nanos) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+}
+
+// Runs work(0) .. work(partitions - 1), each on its own thread when there is more than
+// one, and rethrows the first failure once all of them have finished.
+template <typename Work>
+void runPartitions(unsigned partitions, Work&& work) {
+    if (partitions == 1) {
+        work(0u);
+        return;
+    }
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(partitions);
+    for (unsigned partition = 0; partition < partitions; ++partition) {
+        tasks.push_back(std::async(std::launch::async, [&work, partition] { work(partition); }));
+    }
+    for (auto& task : tasks) task.wait();
+    for (auto& task : tasks) task.get();
+}
+
+} // namespace
+
+void Bank::enableJournal(const std::string& path, const JournalOptions& options) {
+    // A running snapshot may still flush the current journal.
+    if (snapshotTask_.valid()) snapshotTask_.wait();
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+    journal_ = std::make_unique<Journal>(path, options);
 }
 
+Journal* Bank::getJournal() const {
+    return journal_.get();
+}
+
+bool Bank::recover(const std::string& snapshotPath, const std::string& journalPath, unsigned replayThreads) {
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+    if (!customers_.empty() || !transactions_.empty() || journal_) {
+        MINIBANK_LOG_ERROR("Recovery requires an empty bank without a journal.");
+        return false;
+    }
+    if (replayThreads == 0) replayThreads = std::max(1u, std::thread::hardware_concurrency());
+    replayThreads = std::min(replayThreads, kMaxIndexThreads);
+
+    const auto started = std::chrono::steady_clock::now();
+    restoredAccounts_ = true; // Even a failed recovery may leave accounts behind
+    try {
+        std::uint64_t journalSequence = 0;
+        if (fileExists(snapshotPath)) {
+            loadSnapshot(snapshotPath, replayThreads, journalSequence);
+        }
+        replayJournal(journalPath, journalSequence, replayThreads);
+        extendLedgerSegments(); // Here, not in the first time-bounded query
+    } catch (const std::exception& e) {
+        MINIBANK_LOG_ERROR("Recovery failed: " << e.what());
+        return false;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started);
+    MINIBANK_LOG_INFO("Recovered " << customers_.size() << " customers, " << accounts_.size() << " accounts and "
+                      << transactions_.size() << " transactions in " << elapsed.count() << " ms.");
+    return true;
+}
+
+std::shared_future<bool> Bank::writeSnapshotAsync(const std::string& path) {
+    if (snapshotTask_.valid()) snapshotTask_.wait();
+
+    // --- The cut ---
+    // Taken under the exclusive registry lock, so no operation is half-applied.
+    // Customers and ledger records are append-only and never change once added, so the
+    // writer only needs their current counts; balances change in place and are copied.
+    std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+    std::vector<const Customer*> customers;
+    customers.reserve(customers_.size());
+    for (const auto& customer : customers_) {
+        customers.push_back(customer.get());
+    }
+    std::vector<SnapshotAccount> accounts(balanceColumn_.size());
+    for (std::size_t slot = 0; slot < accounts.size(); ++slot) {
+        SnapshotAccount& record = accounts[slot];
+        record.id = idColumn_[slot];
+        record.balanceCents = balanceColumn_[slot];
+        record.ownerIndex = ownerColumn_[slot];
+        record.type = typeColumn_[slot];
+    }
+    {
+        std::lock_guard<std::mutex> hotLock(hotAccountsMutex_);
+        for (const Account* account : hotAccounts_) {
+            accounts[account->getSlot()].balanceCents = account->getBalance().getCents();
+        }
+    }
+    const std::size_t transactionCount = transactions_.size();
+    const NoteArena::Cut noteCut = notes_.cut();
+    Journal* journal = journal_.get();
+    const std::uint64_t journalSequence = journal ? journal->getLastSequence() : 0;
+    const std::uint64_t nextTransactionNumber = nextTransactionNumber_.load();
+    registryLock.unlock();
+    const auto createdAt = static_cast<std::uint64_t>(toNanos(std::chrono::system_clock::now()));
+
+    snapshotTask_ = std::async(std::launch::async,
+        [this, path, customers = std::move(customers), accounts = std::move(accounts),
+         transactionCount, noteCut, journal, journalSequence, nextTransactionNumber, createdAt]() -> bool {
+        try {
+            SnapshotWriter writer(path);
+
+            std::vector<SnapshotCustomer> customerRecords(customers.size());
+            for (std::size_t i = 0; i < customers.size(); ++i) {
+                const std::string& name = customers[i]->getName();
+                customerRecords[i].nameOffset = writer.addString(name);
+                customerRecords[i].nameLength = static_cast<std::uint32_t>(name.size());
+            }
+            writer.beginSection(SnapshotSectionKind::CUSTOMERS);
+            writer.appendRecords(customerRecords.data(), customerRecords.size() * sizeof(SnapshotCustomer),
+                                 customerRecords.size());
+            writer.endSection();
+
+            writer.beginSection(SnapshotSectionKind::ACCOUNTS);
+            writer.appendRecords(accounts.data(), accounts.size() * sizeof(SnapshotAccount), accounts.size());
+            writer.endSection();
+
+            writer.beginSection(SnapshotSectionKind::TRANSACTIONS);
+            std::vector<SnapshotTransaction> batch;
+            batch.reserve(kSnapshotBatch);
+            for (std::size_t position = 0; position < transactionCount; ++position) {
+                const Transaction& transaction = transactions_[position];
+                SnapshotTransaction record = {};
+                record.number = transaction.getNumber();
+                record.amountCents = transaction.getAmount().getCents();
+                record.sourceId = transaction.getSourceAccountId().getPacked();
+                record.destinationId = transaction.getDestinationAccountId().getPacked();
+                record.timestampNanos = toNanos(transaction.getTimePoint());
+                record.noteOffset = transaction.getNoteRef().offset;
+                record.noteLength = transaction.getNoteRef().length;
+                record.type = static_cast<std::uint8_t>(transaction.getType());
+                batch.push_back(record);
+                if (batch.size() == kSnapshotBatch) {
+                    writer.appendRecords(batch.data(), batch.size() * sizeof(SnapshotTransaction), batch.size());
+                    batch.clear();
+                }
+            }
+            writer.appendRecords(batch.data(), batch.size() * sizeof(SnapshotTransaction), batch.size());
+            writer.endSection();
+
+            // Records keep their note offsets, so the arena is written as one image.
+            writer.beginSection(SnapshotSectionKind::NOTES);
+            for (std::size_t chunk = 0; chunk < noteCut.chunks; ++chunk) {
+                const std::string_view image = notes_.chunkImage(noteCut, chunk);
+                writer.appendRecords(image.data(), image.size(), image.size());
+                const std::size_t padding = NoteArena::kChunkSize - image.size();
+                writer.appendRecords(kZeroChunk, padding, padding);
+            }
+            writer.endSection();
+
+            // The snapshot vouches for every journal record up to journalSequence. Those
+            // must be on disk in the journal as well, or a crash could drop them there and
+            // the reopened journal would hand out their sequence numbers again.
+            if (journal) journal->flush();
+            writer.commit(journalSequence, nextTransactionNumber, createdAt);
+            MINIBANK_LOG_INFO("Snapshot written to " << path << " (" << accounts.size() << " accounts, "
+                              << transactionCount << " transactions).");
+            return true;
+        } catch (const std::exception& e) {
+            MINIBANK_LOG_ERROR("Snapshot to " << path << " failed: " << e.what());
+            return false;
+        }
+    }).share();
+    return snapshotTask_;
+}
+
+// Restores customers, accounts and the ledger from a snapshot file.
+void Bank::loadSnapshot(const std::string& path, unsigned threads, std::uint64_t& journalSequence) {
+    const SnapshotReader snapshot(path);
+
+    const SnapshotCustomer* customers = snapshot.getCustomers();
+    const std::size_t customerCount = snapshot.getCustomerCount();
+    const SnapshotAccount* accounts = snapshot.getAccounts();
+    const std::size_t accountCount = snapshot.getAccountCount();
+    reserveRegistry(customerCount, accountCount);
+    for (std::size_t i = 0; i < customerCount; ++i) {
+        std::string name(snapshot.getString(customers[i].nameOffset, customers[i].nameLength));
+        if (customerExists(name)) {
+            throw std::runtime_error("Snapshot lists customer '" + name + "' twice.");
+        }
+        addCustomer(name);
+    }
+
+    for (std::size_t i = 0; i < accountCount; ++i) {
+        const SnapshotAccount& record = accounts[i];
+        const AccountId accountId = AccountId::fromPacked(record.id);
+        if (record.ownerIndex >= customers_.size() || accountExists(accountId) ||
+            record.type > static_cast<std::uint8_t>(AccountType::CHECKING)) {
+            throw std::runtime_error("Snapshot account record " + std::to_string(i) + " is invalid.");
+        }
+        addAccount(static_cast<AccountType>(record.type), accountId, record.ownerIndex,
+                   Money::fromCents(record.balanceCents));
+    }
+
+    const std::string_view noteImage = snapshot.getNoteImage();
+    if (noteImage.size() % NoteArena::kChunkSize != 0 ||
+        noteImage.size() > NoteArena::kMaxChunks * NoteArena::kChunkSize) {
+        throw std::runtime_error("Snapshot note image has an invalid size.");
+    }
+    notes_.loadImage(noteImage.data(), noteImage.size());
+
+    const SnapshotTransaction* transactions = snapshot.getTransactions();
+    const std::size_t transactionCount = snapshot.getTransactionCount();
+    for (std::size_t i = 0; i < transactionCount; ++i) {
+        const SnapshotTransaction& record = transactions[i];
+        if (record.type > static_cast<std::uint8_t>(TransactionType::INTEREST)) {
+            throw std::runtime_error("Snapshot transaction record " + std::to_string(i) + " has an unknown type.");
+        }
+        if (record.noteOffset > noteImage.size() || record.noteLength > noteImage.size() - record.noteOffset) {
+            throw std::runtime_error("Snapshot transaction record " + std::to_string(i) + " references a note out of bounds.");
+        }
+        NoteArena::Note note;
+        note.offset = static_cast<std::uint32_t>(record.noteOffset);
+        note.length = record.noteLength;
+        try {
+            transactions_.emplace_back(record.number,
+                                       static_cast<TransactionType>(record.type),
+                                       Money::fromCents(record.amountCents),
+                                       AccountId::fromPacked(record.sourceId),
+                                       AccountId::fromPacked(record.destinationId),
+                                       note,
+                                       fromNanos(record.timestampNanos));
+        } catch (const std::invalid_argument& e) {
+            throw std::runtime_error("Snapshot transaction record " + std::to_string(i) + " is invalid: " + e.what());
+        }
+    }
+    // Balances in the snapshot are final; only the indexes need rebuilding.
+    indexTransactions(0, transactions_.size(), threads, false);
+
+    nextTransactionNumber_.store(snapshot.getHeader().nextTransactionId);
+    journalSequence = snapshot.getHeader().journalSequence;
+}
+
+// Applies the journal records newer than afterSequence on top of the current state.
+void Bank::replayJournal(const std::string& path, std::uint64_t afterSequence, unsigned threads) {
+    std::vector<JournalRecord> records = Journal::readRecords(path, notes_, afterSequence);
+
+    // Registrations only add customers and accounts, so applying all of them first lets
+    // the transactions be replayed as one batch.
+    for (const JournalRecord& record : records) {
+        if (record.type != JournalRecordType::CUSTOMER_REGISTERED) continue;
+        if (customerExists(record.customerName) || accountExists(record.savingsId) ||
+            accountExists(record.checkingId)) {
+            throw std::runtime_error("Journal record " + std::to_string(record.sequence) +
+                                     " registers an existing customer or account.");
+        }
+        addCustomer(record.customerName);
+        const auto ownerIndex = static_cast<std::uint32_t>(customers_.size() - 1);
+        addAccount(AccountType::SAVINGS, record.savingsId, ownerIndex, Money::zero());
+        addAccount(AccountType::CHECKING, record.checkingId, ownerIndex, Money::zero());
+    }
+
+    const std::size_t begin = transactions_.size();
+    for (JournalRecord& record : records) {
+        if (record.type != JournalRecordType::TRANSACTION) continue;
+        nextTransactionNumber_.store(std::max(nextTransactionNumber_.load(), record.transaction->getNumber() + 1));
+        transactions_.push_back(std::move(*record.transaction));
+    }
+    indexTransactions(begin, transactions_.size(), threads, true);
+}
+
+// Indexes ledger records [begin, end) as recordTransaction would have: posting lists,
+// customer aggregates and, with applyBalances, account balances. The work is split by
+// account: the partition owning an account appends its postings and applies its balance
+// changes, and the partition owning a record's first account applies the record's
+// customer aggregates. Partitions therefore write disjoint state and need no locks, and
+// each walks the records in ledger order, which keeps every posting list chronological.
+void Bank::indexTransactions(std::size_t begin, std::size_t end, unsigned threads, bool applyBalances) {
+    const std::size_t count = end - begin;
+    if (count == 0) return;
+    const unsigned partitions = (count < kParallelIndexThreshold) ? 1u : std::max(1u, threads);
+
+    // Partition of each record's accounts, so partitions skip foreign records without
+    // touching the much larger Transaction objects.
+    std::vector<std::uint8_t> sourcePartition(count);
+    std::vector<std::uint8_t> destinationPartition(count);
+    auto partitionOf = [partitions](AccountId accountId) -> std::uint8_t {
+        return accountId.isValid() ? static_cast<std::uint8_t>(std::hash<AccountId>{}(accountId) % partitions)
+                                   : kNoPartition;
+    };
+    runPartitions(partitions, [&](unsigned partition) {
+        const std::size_t first = count * partition / partitions;
+        const std::size_t last = count * (partition + 1) / partitions;
+        for (std::size_t i = first; i < last; ++i) {
+            const Transaction& transaction = transactions_[begin + i];
+            sourcePartition[i] = partitionOf(transaction.getSourceAccountId());
+            destinationPartition[i] = partitionOf(transaction.getDestinationAccountId());
+        }
+    });
+
+    std::vector<std::unordered_map<Customer*, PendingActivity>> activity(partitions);
+    runPartitions(partitions, [&](unsigned partition) {
+        auto postingsOf = [this](AccountId accountId, std::size_t position) -> std::vector<std::size_t>& {
+            const Account* account = lookupAccount(accountId);
+            if (!account) {
+                throw std::runtime_error("Transaction " + transactions_[position].getTransactionId() +
+                                         " references unknown account " + accountId.toString() + ".");
+            }
+            return accountPostings_[account->getSlot()];
+        };
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint8_t source = sourcePartition[i];
+            const std::uint8_t destination = destinationPartition[i];
+            if (source != partition && destination != partition) continue;
+
+            const std::size_t position = begin + i;
+            const Transaction& transaction = transactions_[position];
+            const AccountId sourceId = transaction.getSourceAccountId();
+            const AccountId destinationId = transaction.getDestinationAccountId();
+            if (source == partition) {
+                postingsOf(sourceId, position).push_back(position);
+            }
+            if (destination == partition && destinationId != sourceId) {
+                postingsOf(destinationId, position).push_back(position);
+            }
+
+            if (applyBalances) {
+                const bool credit = transaction.getType() == TransactionType::DEPOSIT ||
+                                    transaction.getType() == TransactionType::TRANSFER_IN ||
+                                    transaction.getType() == TransactionType::INTEREST;
+                if ((credit ? destination : source) == partition) {
+                    Account& account = *accounts_.find(credit ? destinationId : sourceId);
+                    setAccountBalance(account, credit ? account.getBalance() + transaction.getAmount()
+                                                      : account.getBalance() - transaction.getAmount());
+                }
+            }
+
+            if ((source != kNoPartition ? source : destination) == partition) {
+                forEachCustomerEffect(transaction, [&](Customer* customer, Money delta) {
+                    PendingActivity& pending = activity[partition][customer];
+                    pending.delta = Customer::addWrapping(pending.delta, delta);
+                    ++pending.count;
+                    pending.latest = std::max(pending.latest, transaction.getTimestamp());
+                });
+            }
+        }
+    });
+
+    for (const auto& partitionActivity : activity) {
+        for (const auto& entry : partitionActivity) {
+            entry.first->recordActivity(entry.second.delta, entry.second.count, entry.second.latest);
+        }
+    }
+}
+
+
+// --- End-of-Day Interest ---
+// Each interest record touches one account, so partitions of the record range touch
+// disjoint accounts and postings. Their customers may be shared, but customer
+// aggregates are atomic.
+InterestRun Bank::accrueInterest(const InterestEngine& engine) {
+    InterestRun run;
+    std::uint64_t sequence = 0;
+    {
+        std::unique_lock<std::shared_mutex> registryLock(registryMutex_);
+        // Settle pending shard credits so the column holds every account's full
+        // balance. No new credit can reach a shard while the lock is held.
+        for (Account* account : hotAccounts_) adjustBalanceLocked(*account, Money());
+
+        const std::size_t accountCount = accounts_.size();
+        std::vector<std::int64_t> accruals(accountCount);
+        engine.accrue(balanceColumn_.data(), typeColumn_.data(), static_cast<std::uint8_t>(AccountType::SAVINGS),
+                      accountCount, accruals.data());
+
+        std::vector<std::uint32_t> credited;
+        for (std::size_t slot = 0; slot < accountCount; ++slot) {
+            if (accruals[slot] == 0) continue;
+            if (accruals[slot] > Money::max().getCents() - balanceColumn_[slot]) {
+                throw std::overflow_error("Interest would overflow the balance of account " +
+                                          accounts_[slot].getAccountId().toString() + ".");
+            }
+            credited.push_back(static_cast<std::uint32_t>(slot));
+            run.totalInterest += Money::fromCents(accruals[slot]);
+        }
+        if (credited.empty()) return run;
+
+        const std::uint64_t firstNumber = nextTransactionNumber_.fetch_add(credited.size());
+        const auto timestamp = std::chrono::system_clock::now();
+        run.accountsCredited = credited.size();
+        run.firstPosition = transactions_.size();
+        for (std::size_t i = 0; i < credited.size(); ++i) {
+            const std::uint32_t slot = credited[i];
+            transactions_.emplace_back(firstNumber + i, TransactionType::INTEREST, Money::fromCents(accruals[slot]),
+                                       AccountId(), accounts_[slot].getAccountId(), NoteArena::Note(), timestamp);
+        }
+
+        const unsigned partitions = (credited.size() < kParallelIndexThreshold) ? 1u : engine.getThreads();
+        const std::time_t time = std::chrono::system_clock::to_time_t(timestamp);
+        runPartitions(partitions, [&](unsigned partition) {
+            const std::size_t first = credited.size() * partition / partitions;
+            const std::size_t last = credited.size() * (partition + 1) / partitions;
+            for (std::size_t i = first; i < last; ++i) {
+                const std::uint32_t slot = credited[i];
+                const Money interest = Money::fromCents(accruals[slot]);
+                adjustBalanceLocked(accounts_[slot], interest);
+                accountPostings_[slot].push_back(run.firstPosition + i);
+                customers_[ownerColumn_[slot]]->recordActivity(interest, time);
+            }
+        });
+
+        if (journal_) {
+            for (std::size_t i = 0; i < credited.size(); ++i) {
+                sequence = journal_->appendTransaction(transactions_[run.firstPosition + i], std::string_view());
+            }
+        }
+    }
+    extendLedgerSegments();
+    commitJournal(sequence);
+    MINIBANK_LOG_INFO("Interest of $" << run.totalInterest << " credited to " << run.accountsCredited
+                      << " savings accounts.");
+    return run;
+}
 
 // --- Internal Helper Method Implementations ---
-std::string Bank::generateUniqueAccountId(AccountType type) {
-    std::string prefix = "62";
-    std::string typeCode = (type == AccountType::SAVINGS) ? "21" : "22";
-    std::string accountId;
-    int maxRetries = 100;
-    int retries = 0;
+std::size_t Bank::stripeIndex(AccountId accountId) const {
+    return std::hash<AccountId>{}(accountId) & (kLockStripes - 1);
+}
 
-    do {
-        int randomBranch = branchDist_(randomEngine_); // Uses member randomEngine_
-        long long randomAccNum = accountNumDist_(randomEngine_); // Uses member randomEngine_
+Account* Bank::lookupAccount(AccountId accountId) const {
+    return accounts_.find(accountId);
+}
 
-        std::stringstream ssBranch;
-        ssBranch << std::setw(4) << std::setfill('0') << randomBranch;
-        std::string branchCodeStr = ssBranch.str();
+Customer* Bank::lookupOwner(AccountId accountId) const {
+    const Account* account = accountId.isValid() ? lookupAccount(accountId) : nullptr;
+    return account ? customers_[ownerColumn_[account->getSlot()]].get() : nullptr;
+}
+
+Customer* Bank::lookupCustomer(const std::string& name) const {
+    auto it = customerIndex_.find(name);
+    return (it != customerIndex_.end()) ? it->second : nullptr;
+}
 
-        std::stringstream ssAccNum;
-        // *** Ensure accountNumDist_ generates 8 digits for ZZZZAAAA ***
-       
-        ssAccNum << std::setw(8) << std::setfill('0') << randomAccNum;
-        std::string accNumStr = ssAccNum.str();
+// Creates and indexes a customer without accounts; the caller adds them with addAccount.
+Customer* Bank::addCustomer(const std::string& name) {
+    customers_.push_back(std::make_unique<Customer>(name));
+    Customer* customer = customers_.back().get();
+    customerIndex_[name] = customer;
+    customerSearch_.add(name);
+    return customer;
+}
 
-        std::string accountNumPart1 = accNumStr.substr(0, 4);
-        std::string accountNumPart2 = accNumStr.substr(4, 4);
+// Sizes the registry containers for customerCount more customers and accountCount more
+// accounts, so adding them rehashes and reallocates nothing. Caller holds registryMutex_.
+void Bank::reserveRegistry(std::size_t customerCount, std::size_t accountCount) {
+    const std::size_t customerTotal = customers_.size() + customerCount;
+    const std::size_t accountTotal = idColumn_.size() + accountCount;
+    reserveAtLeast(customers_, customerTotal);
+    reserveAtLeast(customerIndex_, customerTotal);
+    accounts_.reserve(accountTotal);
+    reserveAtLeast(balanceColumn_, accountTotal);
+    reserveAtLeast(typeColumn_, accountTotal);
+    reserveAtLeast(branchColumn_, accountTotal);
+    reserveAtLeast(idColumn_, accountTotal);
+    reserveAtLeast(ownerColumn_, accountTotal);
+    customerSearch_.reserve(customerCount);
+    accountSearch_.reserve(accountCount);
+}
+
+// Creates an account for customers_[ownerIndex] and appends it to the balance columns.
+void Bank::addAccount(AccountType type, AccountId accountId, std::uint32_t ownerIndex, Money balance) {
+    Customer* owner = customers_[ownerIndex].get();
+    accounts_.add(accountId, type, *owner, balance);
+    owner->addAccountId(accountId);
+
+    balanceColumn_.push_back(balance.getCents());
+    typeColumn_.push_back(static_cast<std::uint8_t>(type));
+    branchColumn_.push_back(static_cast<std::uint16_t>(accountId.getBranch()));
+    idColumn_.push_back(accountId.getPacked());
+    ownerColumn_.push_back(ownerIndex);
+    ++typeCounts_[static_cast<std::size_t>(type)];
+    lockStripes_[stripeIndex(accountId)].typeCents[static_cast<std::size_t>(type)]
+        .fetch_add(balance.getCents(), std::memory_order_relaxed);
+    accountPostings_.emplace_back();
+
+    char text[AccountId::kTextLength];
+    accountId.format(text);
+    char digits[SearchIndex::kMaxKeyLength];
+    accountSearch_.add(std::string_view(digits, accountIdDigits(std::string_view(text, sizeof(text)), digits)));
+}
 
-        accountId = prefix + typeCode + "-" + branchCodeStr + "-" + accountNumPart1 + "-" + accountNumPart2;
+// Applies delta to an account whose lock the caller holds. A hot account folds its
+// pending credits in first. Returns false, leaving the balance unchanged, if the
+// result would be negative or exceed Money::max().
+bool Bank::adjustBalanceLocked(Account& account, Money delta) {
+    std::int64_t settled = account.getSettledBalance().getCents();
+    if (ShardedBalance* sharded = account.getShardedBalance()) {
+        const bool accepted = sharded->settle(settled, delta.getCents());
+        setAccountBalance(account, Money::fromCents(settled));
+        return accepted;
+    }
+    const bool accepted = delta.isNegative() ? settled >= -delta.getCents()
+                                             : delta.getCents() <= Money::max().getCents() - settled;
+    if (accepted) setAccountBalance(account, Money::fromCents(settled + delta.getCents()));
+    return accepted;
+}
 
-        retries++;
-        if (retries > maxRetries) {
-            throw std::runtime_error("Failed to generate a unique account ID after multiple attempts.");
+// Locks an account that is about to be credited. A stripe is shared by many accounts,
+// so a failed try_lock only raises the account's contention score when the holder is
+// crediting this same account; waits behind a busy neighbour are not counted. Past
+// kHotAccountThreshold the account is promoted, so later credits go through shards
+// instead of this lock.
+Bank::CreditLock Bank::lockCreditTarget(Account& account) {
+    LockStripe& stripe = lockStripes_[stripeIndex(account.getAccountId())];
+    std::unique_lock<std::mutex> lock(stripe.mutex, std::try_to_lock);
+    bool hot = false;
+    if (lock.owns_lock()) {
+        account.recordUncontendedLock();
+    } else {
+        if (stripe.creditHolder.load(std::memory_order_relaxed) == &account) {
+            hot = account.recordLockContention() >= kHotAccountThreshold;
         }
-    } while (accountExists(accountId));
+        lock.lock();
+    }
+    stripe.creditHolder.store(&account, std::memory_order_relaxed);
+    if (hot) promoteLocked(account);
+    return CreditLock(stripe, std::move(lock));
+}
+
+Bank::CreditLock::CreditLock(LockStripe& stripe, std::unique_lock<std::mutex> lock)
+    : stripe_(&stripe), lock_(std::move(lock)) {}
+
+Bank::CreditLock::CreditLock(CreditLock&& other) noexcept
+    : stripe_(std::exchange(other.stripe_, nullptr)), lock_(std::move(other.lock_)) {}
+
+Bank::CreditLock& Bank::CreditLock::operator=(CreditLock&& other) noexcept {
+    if (this != &other) {
+        release();
+        stripe_ = std::exchange(other.stripe_, nullptr);
+        lock_ = std::move(other.lock_);
+    }
+    return *this;
+}
 
+Bank::CreditLock::~CreditLock() {
+    release();
+}
+
+void Bank::CreditLock::release() {
+    if (!lock_.owns_lock()) return;
+    stripe_->creditHolder.store(nullptr, std::memory_order_relaxed);
+    lock_.unlock();
+}
+
+void Bank::promoteLocked(Account& account) {
+    if (account.getShardedBalance()) return;
+    account.enableShardedBalance();
+    std::lock_guard<std::mutex> hotLock(hotAccountsMutex_);
+    hotAccounts_.push_back(&account);
+}
+
+// Adds the posting lists of one account to a cursor, bounded to the query's ranges
+// while each list's lock is held. A hot account contributes its shard lists as well.
+// Caller holds registryMutex_.
+void Bank::addAccountStreams(TransactionCursor& cursor, AccountId accountId,
+                             std::size_t firstPosition, std::size_t lastPosition) const {
+    const Account* account = lookupAccount(accountId);
+    if (!account) return;
+    const std::vector<std::size_t>& postings = accountPostings_[account->getSlot()];
+
+    auto addList = [&](const std::vector<std::size_t>& positions, std::mutex& mutex) {
+        auto positionAt = [&positions](std::size_t i) { return positions[i]; };
+        TransactionCursor::Stream stream;
+        stream.positions = &positions;
+        stream.mutex = &mutex;
+        std::tie(stream.begin, stream.end) = queryBounds(positions.size(), positionAt, firstPosition, lastPosition);
+        cursor.addStream(stream);
+    };
+
+    const ShardedBalance* sharded = nullptr;
+    {
+        std::mutex& accountMutex = lockStripes_[stripeIndex(accountId)].mutex;
+        std::lock_guard<std::mutex> accountLock(accountMutex);
+        addList(postings, accountMutex);
+        // Promotion happens under this lock, so credits before the cut are in the
+        // base list or in shards that already exist.
+        sharded = account->getShardedBalance();
+    }
+    if (sharded) {
+        for (std::size_t i = 0; i < sharded->getShardCount(); ++i) {
+            ShardedBalance::Shard& shard = sharded->getShard(i);
+            std::lock_guard<std::mutex> shardLock(shard.mutex);
+            addList(shard.postings, shard.mutex);
+        }
+    }
+}
+
+// Checks an operation against the same rules as performDeposit, performWithdraw and
+// performTransfer, resolving the accounts it names. Caller holds registryMutex_.
+BatchStatus Bank::validateBatchOperation(const BatchOperation& operation, Account*& source, Account*& destination) const {
+    if (!operation.amount.isPositive()) return BatchStatus::INVALID_AMOUNT;
+    switch (operation.type) {
+        case BatchOperationType::DEPOSIT:
+            destination = lookupAccount(operation.destinationAccountId);
+            if (!destination) return BatchStatus::ACCOUNT_NOT_FOUND;
+            if (destination->getType() != AccountType::CHECKING) return BatchStatus::NOT_CHECKING_ACCOUNT;
+            return BatchStatus::APPLIED;
+        case BatchOperationType::WITHDRAW:
+            source = lookupAccount(operation.sourceAccountId);
+            if (!source) return BatchStatus::ACCOUNT_NOT_FOUND;
+            if (source->getType() != AccountType::CHECKING) return BatchStatus::NOT_CHECKING_ACCOUNT;
+            return BatchStatus::APPLIED;
+        case BatchOperationType::TRANSFER:
+            source = lookupAccount(operation.sourceAccountId);
+            destination = lookupAccount(operation.destinationAccountId);
+            if (!source || !destination) return BatchStatus::ACCOUNT_NOT_FOUND;
+            if (source == destination) return BatchStatus::SAME_ACCOUNT;
+            if (source->getType() == AccountType::SAVINGS &&
+                (destination->getType() != AccountType::CHECKING || &source->getOwner() != &destination->getOwner())) {
+                return BatchStatus::TRANSFER_NOT_ALLOWED;
+            }
+            return BatchStatus::APPLIED;
+    }
+    return BatchStatus::INVALID_AMOUNT;
+}
+
+// All-or-nothing application: sums each account's credits and debits, checks every net
+// result against [0, Money::max()], then applies one adjustment per account. Credits
+// are applied before debits: only a hot account can change under the batch's locks, and
+// only upwards through its shards, so debits cannot fail once checked, while a credit
+// rejected by a hot account's escrow is undone by debits that cannot fail either. On
+// failure nothing is applied, the operations touching the failing account get its
+// status and all others NOT_APPLIED. Caller holds the stripes of every account involved.
+bool Bank::applyNetEffects(const std::vector<BatchOperation>& operations,
+                           const std::vector<Account*>& sources,
+                           const std::vector<Account*>& destinations,
+                           std::vector<BatchStatus>& statuses) {
+    struct NetEffect {
+        Money delta;
+        bool creditOverflow = false;
+        bool debitOverflow = false;
+    };
+    std::unordered_map<Account*, NetEffect> effects;
+    effects.reserve(operations.size());
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        const Money amount = operations[i].amount;
+        if (sources[i]) {
+            NetEffect& effect = effects[sources[i]];
+            try { effect.delta -= amount; } catch (const std::overflow_error&) { effect.debitOverflow = true; }
+        }
+        if (destinations[i]) {
+            NetEffect& effect = effects[destinations[i]];
+            try { effect.delta += amount; } catch (const std::overflow_error&) { effect.creditOverflow = true; }
+        }
+    }
+
+    std::unordered_map<Account*, BatchStatus> failures;
+    for (auto& entry : effects) {
+        Account& account = *entry.first;
+        const NetEffect& effect = entry.second;
+        if (effect.debitOverflow || effect.creditOverflow) {
+            failures[&account] = effect.debitOverflow ? BatchStatus::INSUFFICIENT_FUNDS : BatchStatus::BALANCE_OVERFLOW;
+            continue;
+        }
+        if (account.getShardedBalance()) adjustBalanceLocked(account, Money()); // Fold pending credits
+        const std::int64_t settled = account.getSettledBalance().getCents();
+        const std::int64_t delta = effect.delta.getCents();
+        if (delta < 0 && settled < -delta) {
+            failures[&account] = BatchStatus::INSUFFICIENT_FUNDS;
+        } else if (delta > 0 && delta > Money::max().getCents() - settled) {
+            failures[&account] = BatchStatus::BALANCE_OVERFLOW;
+        }
+    }
+
+    if (failures.empty()) {
+        std::vector<Account*> credited;
+        for (auto& entry : effects) {
+            if (!entry.second.delta.isPositive()) continue;
+            if (!adjustBalanceLocked(*entry.first, entry.second.delta)) {
+                failures[entry.first] = BatchStatus::BALANCE_OVERFLOW;
+                break;
+            }
+            credited.push_back(entry.first);
+        }
+        if (failures.empty()) {
+            for (auto& entry : effects) {
+                if (entry.second.delta.isNegative()) adjustBalanceLocked(*entry.first, entry.second.delta);
+            }
+            return true;
+        }
+        for (Account* account : credited) {
+            adjustBalanceLocked(*account, -effects[account].delta);
+        }
+    }
+
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        statuses[i] = BatchStatus::NOT_APPLIED;
+        auto source = failures.find(sources[i]);
+        auto destination = failures.find(destinations[i]);
+        if (source != failures.end()) {
+            statuses[i] = source->second;
+        } else if (destination != failures.end()) {
+            statuses[i] = destination->second;
+        }
+    }
+    return false;
+}
+
+// Best-effort application: each operation is applied against the running balances, in
+// order, exactly as the single operations would; those that fail keep their failure
+// status. Caller holds the stripes of every account involved.
+void Bank::applyInOrder(const std::vector<BatchOperation>& operations,
+                        const std::vector<Account*>& sources,
+                        const std::vector<Account*>& destinations,
+                        std::vector<BatchStatus>& statuses) {
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        if (statuses[i] != BatchStatus::APPLIED) continue;
+        const Money amount = operations[i].amount;
+        if (sources[i] && !adjustBalanceLocked(*sources[i], -amount)) {
+            statuses[i] = BatchStatus::INSUFFICIENT_FUNDS;
+            continue;
+        }
+        if (destinations[i] && !adjustBalanceLocked(*destinations[i], amount)) {
+            if (sources[i]) adjustBalanceLocked(*sources[i], amount); // Undo; the debit made room for it.
+            statuses[i] = BatchStatus::BALANCE_OVERFLOW;
+        }
+    }
+}
+
+// Single write path for balances, keeping the account, its column entry and its
+// stripe's type total in step.
+void Bank::setAccountBalance(Account& account, Money newBalance) {
+    const std::int64_t delta = newBalance.getCents() - balanceColumn_[account.getSlot()];
+    account.setBalance(newBalance);
+    balanceColumn_[account.getSlot()] = newBalance.getCents();
+    lockStripes_[stripeIndex(account.getAccountId())].typeCents[static_cast<std::size_t>(account.getType())]
+        .fetch_add(delta, std::memory_order_relaxed);
+}
+
+// Settled balance of every account of a type. Caller holds registryMutex_ exclusively.
+// Stripe totals wrap like the atomic adds that keep them, so the sum is taken modulo
+// 2^64 too; it is exact whenever the total itself fits in Money.
+Money Bank::sumStripeTotals(AccountType type) const {
+    std::uint64_t cents = 0;
+    for (const LockStripe& stripe : lockStripes_) {
+        cents += static_cast<std::uint64_t>(stripe.typeCents[static_cast<std::size_t>(type)].load(std::memory_order_relaxed));
+    }
+    return Money::fromCents(static_cast<std::int64_t>(cents));
+}
+
+// The allocator never repeats an ID, so it is only checked against accounts restored
+// by recover(), which were numbered by another bank's allocator.
+AccountId Bank::generateUniqueAccountId(AccountType type) {
+    if (!restoredAccounts_) return accountIdAllocator_.next(type);
+    AccountId accountId;
+    do {
+        accountId = accountIdAllocator_.next(type);
+    } while (accountExists(accountId));
     return accountId;
 }
 
-std::string Bank::generateUniqueTransactionId() {
-    return "T" + std::to_string(nextTransactionId_++);
+std::uint64_t Bank::generateTransactionNumber() {
+    return nextTransactionNumber_.fetch_add(1, std::memory_order_relaxed);
 }
 
-bool Bank::accountExists(const std::string& accountId) const {
-    return accounts_.count(accountId) > 0;
+bool Bank::accountExists(AccountId accountId) const {
+    return accounts_.find(accountId) != nullptr;
 }
 
 bool Bank::customerExists(const std::string& name) const {
@@ -0,0 +1,50 @@
+#include "BatchOperation.hh"
+
+namespace banking_system {
+
+BatchOperation BatchOperation::deposit(AccountId accountId, Money amount, const std::string& note) {
+    BatchOperation operation;
+    operation.type = BatchOperationType::DEPOSIT;
+    operation.destinationAccountId = accountId;
+    operation.amount = amount;
+    operation.note = note;
+    return operation;
+}
+
+BatchOperation BatchOperation::withdraw(AccountId accountId, Money amount, const std::string& note) {
+    BatchOperation operation;
+    operation.type = BatchOperationType::WITHDRAW;
+    operation.sourceAccountId = accountId;
+    operation.amount = amount;
+    operation.note = note;
+    return operation;
+}
+
+BatchOperation BatchOperation::transfer(AccountId sourceAccountId, AccountId destinationAccountId,
+                                        Money amount, const std::string& note) {
+    BatchOperation operation;
+    operation.type = BatchOperationType::TRANSFER;
+    operation.sourceAccountId = sourceAccountId;
+    operation.destinationAccountId = destinationAccountId;
+    operation.amount = amount;
+    operation.note = note;
+    return operation;
+}
+
+// Helper function to convert BatchStatus to string
+std::string batchStatusToString(BatchStatus status) {
+    switch (status) {
+        case BatchStatus::APPLIED: return "Applied";
+        case BatchStatus::NOT_APPLIED: return "Not applied";
+        case BatchStatus::ACCOUNT_NOT_FOUND: return "Account not found";
+        case BatchStatus::NOT_CHECKING_ACCOUNT: return "Not a checking account";
+        case BatchStatus::INVALID_AMOUNT: return "Invalid amount";
+        case BatchStatus::SAME_ACCOUNT: return "Same account";
+        case BatchStatus::TRANSFER_NOT_ALLOWED: return "Transfer not allowed";
+        case BatchStatus::INSUFFICIENT_FUNDS: return "Insufficient funds";
+        case BatchStatus::BALANCE_OVERFLOW: return "Balance overflow";
+        default: return "Unknown";
+    }
+}
+
+} // namespace banking_system
@@ -0,0 +1,499 @@
+#include "BulkImport.hh"
+#include "Bank.hh"
+#include "MappedFile.hh"
+#include "Logger.hh"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <thread>
+
+namespace banking_system {
+
+namespace {
+
+constexpr std::size_t kMaxCsvFields = 6; // T,<timestamp>,<source>,<destination>,<amount>,<note>
+constexpr std::size_t kMinChunkBytes = 64 << 10;
+constexpr std::size_t kLinesPerIdBlock = 256; // Lines whose account IDs are parsed in one batch
+constexpr unsigned kMaxParseThreads = 64;
+
+// The fields of one line, whatever its format, before conversion.
+struct RawFields {
+    char kind = 0;
+    std::string_view timestamp;
+    std::string_view account;
+    std::string_view secondAccount;
+    std::string_view amount;
+    std::string_view text;
+};
+
+// One chunk of the file, parsed. Lines are counted from the chunk's first line; the
+// applying thread, which knows how many lines came before, makes them absolute.
+struct ParsedChunk {
+    std::vector<ImportRecord> records;
+    std::vector<std::uint64_t> recordLines;
+    std::vector<ImportError> errors;
+    // Quoted fields that contained "" are unescaped here; other text points into the
+    // mapping. A deque, so earlier strings stay put while later ones are added.
+    std::deque<std::string> unescaped;
+    std::uint64_t lines = 0;
+    std::size_t bytes = 0;
+
+    // Up to kLinesPerIdBlock split lines awaiting conversion, and their account ID
+    // texts, two per line, which are parsed in one parseAccountIds call.
+    std::vector<RawFields> fields;
+    std::vector<std::uint64_t> fieldLines;
+    std::vector<std::string_view> idTexts;
+    std::vector<AccountId> ids;
+
+    void clear() {
+        records.clear();
+        recordLines.clear();
+        errors.clear();
+        unescaped.clear();
+        fields.clear();
+        fieldLines.clear();
+        idTexts.clear();
+        lines = 0;
+        bytes = 0;
+    }
+};
+
+// --- Field helpers ---
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+// Start of the first line that begins at or after offset.
+std::size_t lineStart(const unsigned char* data, std::size_t size, std::size_t offset) {
+    if (offset == 0 || offset >= size) return std::min(offset, size);
+    const void* newline = std::memchr(data + offset - 1, '\n', size - offset + 1);
+    return newline ? static_cast<std::size_t>(static_cast<const unsigned char*>(newline) - data) + 1 : size;
+}
+
+bool parseDigits(std::string_view text, unsigned& value) {
+    if (text.empty()) return false;
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<unsigned>(c - '0');
+    }
+    return true;
+}
+
+// Days from 1970-01-01 to the given civil date (proleptic Gregorian calendar).
+std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+}
+
+unsigned daysInMonth(unsigned year, unsigned month) {
+    static const unsigned kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return (month == 2 && leap) ? 29 : kDays[month - 1];
+}
+
+// Splits a CSV line into fields. Quoted fields are unquoted, unescaping "" into
+// unescaped when needed. Returns false, with error set, if the line is malformed.
+bool splitCsv(std::string_view line, std::array<std::string_view, kMaxCsvFields>& fields, std::size_t& count,
+              std::deque<std::string>& unescaped, std::string& error) {
+    count = 0;
+    std::size_t i = 0;
+    while (true) {
+        if (count == kMaxCsvFields) {
+            error = "too many fields";
+            return false;
+        }
+        std::string_view field;
+        std::size_t start = i;
+        while (start < line.size() && (line[start] == ' ' || line[start] == '\t')) ++start;
+        if (start < line.size() && line[start] == '"') {
+            std::size_t close = start + 1;
+            bool escaped = false;
+            while (true) {
+                close = line.find('"', close);
+                if (close == std::string_view::npos) {
+                    error = "unterminated quoted field";
+                    return false;
+                }
+                if (close + 1 < line.size() && line[close + 1] == '"') {
+                    escaped = true;
+                    close += 2;
+                    continue;
+                }
+                break;
+            }
+            field = line.substr(start + 1, close - start - 1);
+            if (escaped) {
+                std::string text;
+                text.reserve(field.size());
+                for (std::size_t j = 0; j < field.size(); ++j) {
+                    text.push_back(field[j]);
+                    if (field[j] == '"') ++j;
+                }
+                unescaped.push_back(std::move(text));
+                field = unescaped.back();
+            }
+            i = close + 1;
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i;
+            if (i < line.size() && line[i] != ',') {
+                error = "text after a quoted field";
+                return false;
+            }
+        } else {
+            const std::size_t comma = line.find(',', i);
+            const std::size_t end = (comma == std::string_view::npos) ? line.size() : comma;
+            field = trim(line.substr(i, end - i));
+            i = end;
+        }
+        fields[count++] = field;
+        if (i >= line.size()) return true;
+        ++i; // Past the comma
+    }
+}
+
+bool csvFields(std::string_view line, RawFields& raw, std::deque<std::string>& unescaped, std::string& error) {
+    std::array<std::string_view, kMaxCsvFields> fields;
+    std::size_t count = 0;
+    if (!splitCsv(line, fields, count, unescaped, error)) return false;
+    if (fields[0].size() != 1) {
+        error = "unknown record kind '" + std::string(fields[0]) + "'";
+        return false;
+    }
+    raw.kind = fields[0][0];
+    switch (raw.kind) {
+        case 'C':
+            if (count != 2 && count != 4) {
+                error = "a customer needs a name and optionally two account IDs";
+                return false;
+            }
+            raw.text = fields[1];
+            if (count == 4) {
+                raw.account = fields[2];
+                raw.secondAccount = fields[3];
+            }
+            return true;
+        case 'B':
+        case 'D':
+        case 'W':
+            if (count != 4 && count != 5) {
+                error = "expected a timestamp, an account, an amount and optionally a note";
+                return false;
+            }
+            raw.timestamp = fields[1];
+            raw.account = fields[2];
+            raw.amount = fields[3];
+            if (count == 5) raw.text = fields[4];
+            return true;
+        case 'T':
+            if (count != 5 && count != 6) {
+                error = "expected a timestamp, two accounts, an amount and optionally a note";
+                return false;
+            }
+            raw.timestamp = fields[1];
+            raw.account = fields[2];
+            raw.secondAccount = fields[3];
+            raw.amount = fields[4];
+            if (count == 6) raw.text = fields[5];
+            return true;
+        default:
+            error = std::string("unknown record kind '") + raw.kind + "'";
+            return false;
+    }
+}
+
+bool fixedWidthFields(std::string_view line, RawFields& raw, std::string& error) {
+    auto column = [&line](std::size_t begin, std::size_t end) {
+        if (begin >= line.size()) return std::string_view();
+        return trim(line.substr(begin, end - begin));
+    };
+    raw.kind = line[FixedWidthLayout::kKind];
+    if (raw.kind != 'C' && raw.kind != 'B' && raw.kind != 'D' && raw.kind != 'W' && raw.kind != 'T') {
+        error = std::string("unknown record kind '") + raw.kind + "'";
+        return false;
+    }
+    raw.timestamp = column(FixedWidthLayout::kTimestamp, FixedWidthLayout::kAccount);
+    raw.account = column(FixedWidthLayout::kAccount, FixedWidthLayout::kSecondAccount);
+    raw.secondAccount = column(FixedWidthLayout::kSecondAccount, FixedWidthLayout::kAmount);
+    raw.amount = column(FixedWidthLayout::kAmount, FixedWidthLayout::kText);
+    raw.text = column(FixedWidthLayout::kText, line.size());
+    return true;
+}
+
+// Converts and validates the fields of a line, given its account IDs as parsed from
+// raw.account and raw.secondAccount (invalid if malformed or absent). Checks that need
+// the bank (existence, balances, ordering) are left to Bank::importRecords.
+bool toRecord(const RawFields& raw, const AccountId* ids, ImportRecord& record, std::string& error) {
+    auto accountId = [&](std::string_view text, AccountId parsed, AccountId& id) {
+        if (!parsed.isValid()) {
+            error = "malformed account ID '" + std::string(text) + "'";
+            return false;
+        }
+        id = parsed;
+        return true;
+    };
+
+    if (raw.kind == 'C') {
+        record.type = ImportRecordType::CUSTOMER;
+        if (raw.text.empty()) {
+            error = "missing customer name";
+            return false;
+        }
+        record.text = raw.text;
+        if (raw.account.empty() != raw.secondAccount.empty()) {
+            error = "a customer needs both account IDs or neither";
+            return false;
+        }
+        return raw.account.empty() ||
+               (accountId(raw.account, ids[0], record.accountId) &&
+                accountId(raw.secondAccount, ids[1], record.secondAccountId));
+    }
+
+    switch (raw.kind) {
+        case 'B': record.type = ImportRecordType::BALANCE; break;
+        case 'D': record.type = ImportRecordType::DEPOSIT; break;
+        case 'W': record.type = ImportRecordType::WITHDRAW; break;
+        default: record.type = ImportRecordType::TRANSFER; break;
+    }
+    if (!parseImportTimestamp(raw.timestamp, record.timestamp)) {
+        error = "malformed timestamp '" + std::string(raw.timestamp) + "'";
+        return false;
+    }
+    if (!accountId(raw.account, ids[0], record.accountId)) return false;
+    if (record.type == ImportRecordType::TRANSFER &&
+        !accountId(raw.secondAccount, ids[1], record.secondAccountId)) {
+        return false;
+    }
+    const auto amount = Money::parse(raw.amount);
+    if (!amount || !amount->isPositive()) {
+        error = "invalid amount '" + std::string(raw.amount) + "'";
+        return false;
+    }
+    record.amount = *amount;
+    record.text = raw.text;
+    return true;
+}
+
+// Converts the lines split so far: their account IDs in one batch, then line by line.
+void convertFields(ParsedChunk& chunk, std::string& error) {
+    chunk.ids.resize(chunk.idTexts.size());
+    parseAccountIds(chunk.idTexts.data(), chunk.idTexts.size(), chunk.ids.data());
+    for (std::size_t i = 0; i < chunk.fields.size(); ++i) {
+        ImportRecord record;
+        if (toRecord(chunk.fields[i], &chunk.ids[2 * i], record, error)) {
+            chunk.records.push_back(record);
+            chunk.recordLines.push_back(chunk.fieldLines[i]);
+        } else {
+            chunk.errors.push_back({chunk.fieldLines[i], error});
+        }
+    }
+    chunk.fields.clear();
+    chunk.fieldLines.clear();
+    chunk.idTexts.clear();
+}
+
+// Lines are split into fields and converted a block at a time, so a block's fields are
+// still in cache when converted. Errors of both steps carry their line; the applying
+// thread puts them in order.
+void parseChunk(const char* data, std::size_t size, ImportFormat format, ParsedChunk& chunk) {
+    chunk.clear();
+    chunk.bytes = size;
+    std::string error;
+    std::size_t position = 0;
+    while (position < size) {
+        const void* newline = std::memchr(data + position, '\n', size - position);
+        const std::size_t end = newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - data) : size;
+        std::string_view line(data + position, end - position);
+        position = end + 1;
+        ++chunk.lines;
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (trim(line).empty() || line.front() == '#') continue;
+
+        RawFields raw;
+        const bool parsed = (format == ImportFormat::CSV) ? csvFields(line, raw, chunk.unescaped, error)
+                                                          : fixedWidthFields(line, raw, error);
+        if (!parsed) {
+            chunk.errors.push_back({chunk.lines, error});
+            continue;
+        }
+        chunk.fields.push_back(raw);
+        chunk.fieldLines.push_back(chunk.lines);
+        chunk.idTexts.push_back(raw.account);
+        chunk.idTexts.push_back(raw.secondAccount);
+        if (chunk.fields.size() == kLinesPerIdBlock) convertFields(chunk, error);
+    }
+    convertFields(chunk, error);
+}
+
+} // namespace
+
+// --- Import Pipeline ---
+// The same sliding window as ReportWriter::writeTransactions: chunk c parses into
+// slot c % window while the calling thread applies the chunks before it, and its slot
+// is handed to chunk c + window once applied. Chunk boundaries are found by each
+// worker independently: a chunk owns the lines that start within its byte range.
+ImportReport importFile(Bank& bank, const std::string& path, const ImportOptions& options) {
+    const auto started = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    file.prefetch();
+    const unsigned char* data = file.data();
+    const std::size_t size = file.size();
+
+    const std::size_t chunkBytes = std::max(options.chunkBytes, kMinChunkBytes);
+    const std::size_t chunks = (size + chunkBytes - 1) / chunkBytes;
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>({threads, kMaxParseThreads, std::max<std::size_t>(chunks, 1)}));
+
+    ImportReport report;
+    report.bytes = size;
+    const std::size_t window = threads + 1;
+    std::vector<ParsedChunk> parsed(window);
+    std::vector<std::future<void>> pending(window);
+    auto launch = [&](std::size_t chunk) {
+        pending[chunk % window] = std::async(std::launch::async, [&, chunk] {
+            const std::size_t begin = lineStart(data, size, chunk * chunkBytes);
+            const std::size_t end = lineStart(data, size, std::min(size, (chunk + 1) * chunkBytes));
+            parseChunk(reinterpret_cast<const char*>(data) + begin, end - begin, options.format,
+                       parsed[chunk % window]);
+        });
+    };
+    for (std::size_t chunk = 0; chunk < std::min(window, chunks); ++chunk) {
+        launch(chunk);
+    }
+
+    std::uint64_t bytesDone = 0;
+    std::vector<ImportError> chunkErrors;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        pending[chunk % window].get();
+        ParsedChunk& current = parsed[chunk % window];
+        const std::vector<ImportStatus> statuses = bank.importRecords(current.records);
+
+        chunkErrors.clear();
+        for (std::size_t i = 0; i < statuses.size(); ++i) {
+            if (statuses[i] == ImportStatus::APPLIED) {
+                ++(current.records[i].type == ImportRecordType::CUSTOMER ? report.customers : report.transactions);
+                continue;
+            }
+            ++report.rejected;
+            if (report.errors.size() + chunkErrors.size() < options.maxReportedErrors) {
+                chunkErrors.push_back({report.lines + current.recordLines[i], importStatusToString(statuses[i])});
+            }
+        }
+        report.parseErrors += current.errors.size();
+        for (const ImportError& error : current.errors) {
+            chunkErrors.push_back({report.lines + error.line, error.message});
+        }
+        // Parse and apply errors of a chunk arrive separately; keep the report in line order.
+        std::sort(chunkErrors.begin(), chunkErrors.end(),
+                  [](const ImportError& a, const ImportError& b) { return a.line < b.line; });
+        for (ImportError& error : chunkErrors) {
+            if (report.errors.size() == options.maxReportedErrors) break;
+            report.errors.push_back(std::move(error));
+        }
+        report.lines += current.lines;
+        bytesDone += current.bytes;
+
+        if (chunk + window < chunks) launch(chunk + window);
+        if (options.onProgress) {
+            ImportProgress progress;
+            progress.bytesDone = bytesDone;
+            progress.bytesTotal = size;
+            progress.recordsApplied = report.customers + report.transactions;
+            progress.errorCount = report.getErrorCount();
+            progress.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            options.onProgress(progress);
+        }
+    }
+
+    report.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    MINIBANK_LOG_INFO("Imported " << path << ": " << report.customers << " customers and " << report.transactions
+                      << " transactions from " << report.lines << " lines in "
+                      << static_cast<long long>(report.elapsedSeconds * 1000) << " ms, "
+                      << report.getErrorCount() << " errors.");
+    return report;
+}
+
+// --- Timestamps ---
+bool parseImportTimestamp(std::string_view text, std::chrono::system_clock::time_point& timestamp) {
+    using std::chrono::system_clock;
+    // The nanosecond clock spans 1678 to 2261; timestamps are accepted from 1700 to 2200.
+    constexpr unsigned kMinYear = 1700;
+    constexpr unsigned kMaxYear = 2200;
+    auto toTimePoint = [&timestamp](std::int64_t seconds, std::int64_t nanos) {
+        timestamp = system_clock::time_point(std::chrono::duration_cast<system_clock::duration>(
+            std::chrono::nanoseconds(seconds * 1000000000 + nanos)));
+    };
+
+    // Whole seconds since the epoch.
+    if (!text.empty() && text.size() <= 10 && text.find_first_not_of("0123456789") == std::string_view::npos) {
+        std::int64_t seconds = 0;
+        for (char c : text) seconds = seconds * 10 + (c - '0');
+        if (seconds >= daysFromCivil(kMaxYear + 1, 1, 1) * 86400) return false;
+        toTimePoint(seconds, 0);
+        return true;
+    }
+
+    // YYYY-MM-DD HH:MM:SS
+    if (text.size() < 19 || text[4] != '-' || text[7] != '-' || (text[10] != ' ' && text[10] != 'T') ||
+        text[13] != ':' || text[16] != ':') {
+        return false;
+    }
+    unsigned year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (!parseDigits(text.substr(0, 4), year) || !parseDigits(text.substr(5, 2), month) ||
+        !parseDigits(text.substr(8, 2), day) || !parseDigits(text.substr(11, 2), hour) ||
+        !parseDigits(text.substr(14, 2), minute) || !parseDigits(text.substr(17, 2), second)) {
+        return false;
+    }
+    if (year < kMinYear || year > kMaxYear || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) ||
+        hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    text.remove_prefix(19);
+    std::int64_t nanos = 0;
+    if (!text.empty() && text.front() == '.') {
+        text.remove_prefix(1);
+        std::size_t digits = 0;
+        while (digits < text.size() && text[digits] >= '0' && text[digits] <= '9') ++digits;
+        if (digits == 0 || digits > 9) return false;
+        for (std::size_t i = 0; i < 9; ++i) {
+            nanos = nanos * 10 + (i < digits ? text[i] - '0' : 0);
+        }
+        text.remove_prefix(digits);
+    }
+    if (!text.empty() && text.front() == 'Z') text.remove_prefix(1);
+    if (!text.empty()) return false;
+
+    toTimePoint(daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second, nanos);
+    return true;
+}
+
+// Helper function to convert ImportStatus to string
+std::string importStatusToString(ImportStatus status) {
+    switch (status) {
+        case ImportStatus::APPLIED: return "Applied";
+        case ImportStatus::CUSTOMER_EXISTS: return "Customer already exists";
+        case ImportStatus::ACCOUNT_EXISTS: return "Account already exists";
+        case ImportStatus::INVALID_ACCOUNT_ID: return "Invalid customer account IDs";
+        case ImportStatus::ACCOUNT_NOT_FOUND: return "Account not found";
+        case ImportStatus::NOT_CHECKING_ACCOUNT: return "Not a checking account";
+        case ImportStatus::INVALID_AMOUNT: return "Invalid amount";
+        case ImportStatus::SAME_ACCOUNT: return "Same account";
+        case ImportStatus::TRANSFER_NOT_ALLOWED: return "Transfer not allowed";
+        case ImportStatus::INSUFFICIENT_FUNDS: return "Insufficient funds";
+        case ImportStatus::BALANCE_OVERFLOW: return "Balance overflow";
+        case ImportStatus::OUT_OF_ORDER: return "Timestamp out of order";
+        default: return "Unknown";
+    }
+}
+
+} // namespace banking_system
@@ -17,13 +17,13 @@ const std::string& Customer::getName() const {
 }
 
 // Getter for the list of account IDs
-const std::vector<std::string>& Customer::getAccountIds() const {
+const std::vector<AccountId>& Customer::getAccountIds() const {
     return accountIds_;
 }
 
 // Adds an account ID to the customer's list
-void Customer::addAccountId(const std::string& accountId) {
-    if (accountId.empty()) {
+void Customer::addAccountId(AccountId accountId) {
+    if (!accountId.isValid()) {
         throw std::invalid_argument("Account ID cannot be empty when adding to customer.");
     }
     // Prevent duplicate account IDs for the same customer
@@ -32,4 +32,35 @@ void Customer::addAccountId(const std::string& accountId) {
     }
 }
 
+// --- Running aggregates ---
+Money Customer::getTotalBalance() const {
+    const std::uint64_t cents = totalBalanceCents_.load(std::memory_order_relaxed);
+    const auto max = static_cast<std::uint64_t>(Money::max().getCents());
+    return Money::fromCents(static_cast<std::int64_t>(cents > max ? max : cents));
+}
+
+std::size_t Customer::getTransactionCount() const {
+    return transactionCount_.load(std::memory_order_relaxed);
+}
+
+std::time_t Customer::getLastActivity() const {
+    return lastActivity_.load(std::memory_order_relaxed);
+}
+
+void Customer::recordActivity(Money balanceDelta, std::time_t timestamp) {
+    recordActivity(addWrapping(0, balanceDelta), 1, timestamp);
+}
+
+void Customer::recordActivity(std::uint64_t balanceDeltaCents, std::size_t transactionCount, std::time_t latestTimestamp) {
+    // Wrapping add: the total is exact modulo 2^64 and cannot fail halfway through an
+    // operation that has already changed balances.
+    totalBalanceCents_.fetch_add(balanceDeltaCents, std::memory_order_relaxed);
+    transactionCount_.fetch_add(transactionCount, std::memory_order_relaxed);
+
+    std::time_t last = lastActivity_.load(std::memory_order_relaxed);
+    while (latestTimestamp > last &&
+           !lastActivity_.compare_exchange_weak(last, latestTimestamp, std::memory_order_relaxed)) {
+    }
+}
+
 } // namespace banking_system
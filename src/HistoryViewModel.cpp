@@ -0,0 +1,63 @@
+#include "HistoryViewModel.hh"
+#include "Bank.hh"
+
+#include <algorithm>
+
+namespace banking_system {
+
+void HistoryViewModel::open(const Bank& bank, const TransactionQuery& query) {
+    close();
+    bank_ = &bank;
+    formatter_.emplace(bank.getNotes());
+    query_ = query;
+    query_.order = QueryOrder::OLDEST_FIRST;
+    query_.page(0, std::numeric_limits<std::size_t>::max());
+    rowCache_.resize(kCachedRows);
+    for (CachedRow& cached : rowCache_) {
+        cached.row = std::numeric_limits<std::size_t>::max();
+    }
+}
+
+void HistoryViewModel::close() {
+    bank_ = nullptr;
+    formatter_.reset();
+    pending_ = TransactionCursor();
+    watermark_ = 0;
+    std::deque<const Transaction*>().swap(records_);
+}
+
+bool HistoryViewModel::refresh() {
+    if (!bank_) return false;
+    if (pending_.atEnd()) {
+        // Nothing new is one atomic load; otherwise only the new positions are queried.
+        const std::size_t count = bank_->getTransactionCount();
+        if (count == watermark_) return false;
+        pending_ = bank_->queryTransactions(TransactionQuery(query_).positions(watermark_, count));
+        watermark_ = count;
+    }
+
+    const std::size_t before = records_.size();
+    const Transaction* page[1024];
+    std::size_t budget = kLoadBudget;
+    while (budget > 0) {
+        const std::size_t count = pending_.next(page, std::min(budget, sizeof(page) / sizeof(page[0])));
+        if (count == 0) break;
+        records_.insert(records_.end(), page, page + count);
+        budget -= count;
+    }
+    return records_.size() > before;
+}
+
+const std::string& HistoryViewModel::getRowText(std::size_t row) {
+    CachedRow& cached = rowCache_[row % kCachedRows];
+    if (cached.row != row) {
+        // Records never change, so a cached row only goes stale when its slot is reused.
+        const Transaction& record = *records_[row];
+        formatBuffer_.resize(std::max(formatBuffer_.size(), TransactionFormatter::maxLength(record)));
+        cached.text.assign(formatBuffer_.data(), formatter_->format(record, formatBuffer_.data()));
+        cached.row = row;
+    }
+    return cached.text;
+}
+
+} // namespace banking_system
@@ -0,0 +1,81 @@
+#include "InterestEngine.hh"
+
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace banking_system {
+
+// --- InterestSchedule ---
+InterestSchedule::InterestSchedule(std::vector<InterestTier> tiers, unsigned daysPerYear)
+    : tiers_(std::move(tiers)), daysPerYear_(daysPerYear) {
+    if (tiers_.empty() || tiers_.size() > kMaxTiers) {
+        throw std::invalid_argument("An interest schedule needs 1 to " + std::to_string(kMaxTiers) + " tiers.");
+    }
+    if (!tiers_.front().floor.isZero()) {
+        throw std::invalid_argument("The first interest tier must start at zero.");
+    }
+    if (daysPerYear_ == 0 || daysPerYear_ > 366) {
+        throw std::invalid_argument("Days per year must be 1 to 366.");
+    }
+    const std::uint64_t denominator = std::uint64_t(1000000) * daysPerYear_;
+    for (std::size_t k = 0; k < tiers_.size(); ++k) {
+        if (k > 0 && tiers_[k].floor <= tiers_[k - 1].floor) {
+            throw std::invalid_argument("Interest tier floors must ascend.");
+        }
+        // ppm * 2^32 <= 2^64 - 2^32, and half the denominator is below 2^28.
+        const std::uint64_t factor =
+            ((static_cast<std::uint64_t>(tiers_[k].annualRatePpm) << 32) + denominator / 2) / denominator;
+        if (factor > 0xFFFFFFFFULL) {
+            throw std::invalid_argument("Interest tier rates must be below 100% a day.");
+        }
+        kernels::AccrualTier tier;
+        tier.floor = tiers_[k].floor.getCents();
+        tier.width = (k + 1 < tiers_.size()) ? tiers_[k + 1].floor.getCents() - tier.floor : 0;
+        tier.dailyFactor = static_cast<std::uint32_t>(factor);
+        accrualTiers_.push_back(tier);
+    }
+}
+
+Money InterestSchedule::dailyAccrual(Money balance) const {
+    const std::int64_t cents = balance.getCents();
+    std::int64_t accrual = 0;
+    kernels::accrueTiered(&cents, nullptr, 0, accrualTiers_.data(), accrualTiers_.size(), 1, &accrual);
+    return Money::fromCents(accrual);
+}
+
+// --- InterestEngine ---
+InterestEngine::InterestEngine(InterestSchedule schedule, unsigned threads)
+    : schedule_(std::move(schedule)),
+      threads_(std::min(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency()), kMaxThreads)) {}
+
+void InterestEngine::accrue(const std::int64_t* cents, const std::uint8_t* tags, std::uint8_t tag,
+                            std::size_t count, std::int64_t* out) const {
+    const std::vector<kernels::AccrualTier>& tiers = schedule_.getAccrualTiers();
+    auto accrueRange = [&](std::size_t first, std::size_t last) {
+        kernels::accrueTiered(cents + first, tags ? tags + first : nullptr, tag,
+                              tiers.data(), tiers.size(), last - first, out + first);
+    };
+    const auto threads = static_cast<unsigned>(
+        std::min<std::size_t>(threads_, std::max<std::size_t>(1, count / kMinBalancesPerThread)));
+    if (threads <= 1) {
+        accrueRange(0, count);
+        return;
+    }
+
+    // Ranges are whole cache lines of balances, so no two threads write one line of out.
+    auto boundary = [&](unsigned part) { return (count * part / threads) & ~std::size_t(7); };
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(threads - 1);
+    for (unsigned part = 1; part < threads; ++part) {
+        const std::size_t last = (part + 1 == threads) ? count : boundary(part + 1);
+        tasks.push_back(std::async(std::launch::async, accrueRange, boundary(part), last));
+    }
+    accrueRange(0, boundary(1));
+    for (auto& task : tasks) task.get();
+}
+
+} // namespace banking_system
@@ -0,0 +1,441 @@
+#include "Journal.hh"
+#include "MappedFile.hh"
+#include "Transaction.hh"
+#include "Utils.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace banking_system {
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'B', 'J', '1'};
+constexpr std::size_t kFileHeaderSize = 8;     // magic + u32 version
+constexpr std::size_t kRecordHeaderSize = 17;  // u32 length + u32 crc + u64 sequence + u8 type
+
+// --- Little-endian encoding helpers ---
+void putU32(std::string& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void putU64(std::string& out, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void putString(std::string& out, std::string_view s) {
+    putU32(out, static_cast<std::uint32_t>(s.size()));
+    out.append(s.data(), s.size());
+}
+
+std::uint32_t readU32(const unsigned char* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+std::uint64_t readU64(const unsigned char* p) {
+    return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+// --- Platform file primitives ---
+int openForAppend(const std::string& path) {
+#ifdef _WIN32
+    return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+}
+
+bool writeAll(int fd, const char* data, std::size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        const int chunk = length > 0x40000000 ? 0x40000000 : static_cast<int>(length);
+        const int written = _write(fd, data, chunk);
+#else
+        const ssize_t written = ::write(fd, data, length);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        length -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool syncFile(int fd) {
+#ifdef _WIN32
+    return _commit(fd) == 0;
+#elif defined(__linux__)
+    return ::fdatasync(fd) == 0; // Metadata other than size is irrelevant for an append-only log.
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+void closeFile(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+bool truncateFile(const std::string& path, std::uint64_t size) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_WRONLY | _O_BINARY);
+    if (fd < 0) return false;
+    const bool ok = _chsize_s(fd, static_cast<long long>(size)) == 0;
+    _close(fd);
+    return ok;
+#else
+    return ::truncate(path.c_str(), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+bool fileExists(const std::string& path) {
+    return std::ifstream(path, std::ios::binary).good();
+}
+
+// Walks the intact records of a mapped journal, calling visit(sequence, type, payload,
+// length) for each, and returns the length of the intact prefix. A torn record at the
+// tail (from a crash in the middle of a write) ends the prefix.
+template <typename Visitor>
+std::uint64_t walkRecords(const MappedFile& file, Visitor&& visit) {
+    const std::size_t size = file.size();
+    if (size == 0) return 0;
+    const unsigned char* data = file.data();
+    if (size < kFileHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("File " + file.getPath() + " is not a MiniBank journal.");
+    }
+
+    if (readU32(data + sizeof(kMagic)) != Journal::kFormatVersion) {
+        throw std::runtime_error("Journal " + file.getPath() + " was written in an unsupported format.");
+    }
+
+    std::size_t offset = kFileHeaderSize;
+    while (offset + kRecordHeaderSize <= size) {
+        const std::uint32_t length = readU32(data + offset);
+        const std::uint32_t crc = readU32(data + offset + 4);
+        if (length > size - offset - kRecordHeaderSize) break;
+        const std::uint32_t bodyCrc = utils::crc32(data + offset + 16, 1 + length);
+        if (utils::crc32(data + offset + 8, 8, bodyCrc) != crc) break;
+        visit(readU64(data + offset + 8), static_cast<JournalRecordType>(data[offset + 16]),
+              data + offset + kRecordHeaderSize, length);
+        offset += kRecordHeaderSize + length;
+    }
+    return offset;
+}
+
+// Validates an existing journal and returns the length of its intact prefix together
+// with the last sequence number in it.
+std::uint64_t scanExisting(const std::string& path, std::uint64_t& lastSequence) {
+    lastSequence = 0;
+    if (!fileExists(path)) return 0;
+    MappedFile file(path);
+    return walkRecords(file, [&](std::uint64_t sequence, JournalRecordType, const unsigned char*, std::size_t) {
+        lastSequence = sequence;
+    });
+}
+
+// Bounds-checked cursor over one record payload.
+class PayloadReader {
+public:
+    PayloadReader(const unsigned char* data, std::size_t length) : data_(data), end_(data + length) {}
+
+    std::uint8_t u8() { return *take(1); }
+    std::uint64_t u64() { return readU64(take(8)); }
+    // Points into the mapped payload.
+    std::string_view string() {
+        const std::uint32_t length = readU32(take(4));
+        const unsigned char* bytes = take(length);
+        return std::string_view(reinterpret_cast<const char*>(bytes), length);
+    }
+
+private:
+    const unsigned char* take(std::size_t count) {
+        if (static_cast<std::size_t>(end_ - data_) < count) {
+            throw std::runtime_error("Journal record payload is truncated.");
+        }
+        const unsigned char* p = data_;
+        data_ += count;
+        return p;
+    }
+
+    const unsigned char* data_;
+    const unsigned char* end_;
+};
+
+JournalRecord decodeRecord(std::uint64_t sequence, JournalRecordType type,
+                           const unsigned char* payload, std::size_t length, NoteArena& notes) {
+    JournalRecord record;
+    record.sequence = sequence;
+    record.type = type;
+    PayloadReader reader(payload, length);
+    switch (type) {
+        case JournalRecordType::CUSTOMER_REGISTERED:
+            record.customerName = reader.string();
+            record.savingsId = AccountId::fromPacked(reader.u64());
+            record.checkingId = AccountId::fromPacked(reader.u64());
+            break;
+        case JournalRecordType::TRANSACTION: {
+            const std::optional<std::uint64_t> number = parseTransactionId(reader.string());
+            const auto transactionType = static_cast<TransactionType>(reader.u8());
+            const Money amount = Money::fromCents(static_cast<std::int64_t>(reader.u64()));
+            const AccountId sourceId = AccountId::fromPacked(reader.u64());
+            const AccountId destinationId = AccountId::fromPacked(reader.u64());
+            const std::chrono::system_clock::time_point timestamp(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(static_cast<std::int64_t>(reader.u64()))));
+            const std::string_view note = reader.string();
+            if (!number) {
+                throw std::runtime_error("Journal record " + std::to_string(sequence) + " has an invalid transaction ID.");
+            }
+            try {
+                record.transaction.emplace(*number, transactionType, amount, sourceId, destinationId,
+                                           notes.intern(note), timestamp);
+            } catch (const std::invalid_argument& e) {
+                throw std::runtime_error("Journal record " + std::to_string(sequence) + " is invalid: " + e.what());
+            }
+            break;
+        }
+        default:
+            throw std::runtime_error("Journal record " + std::to_string(sequence) + " has an unknown type.");
+    }
+    return record;
+}
+
+} // namespace
+
+// Constructor: validates any existing content, drops a torn tail, and starts the flusher.
+Journal::Journal(const std::string& path, const JournalOptions& options)
+    : path_(path), options_(options) {
+    const std::uint64_t validLength = scanExisting(path, lastSequence_);
+    durableSequence_ = lastSequence_;
+    if (validLength > 0 && !truncateFile(path, validLength)) {
+        throw std::runtime_error("Cannot truncate torn tail of journal " + path + ".");
+    }
+
+    fd_ = openForAppend(path);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open journal " + path + ": " + std::strerror(errno));
+    }
+    if (validLength == 0) {
+        std::string header(kMagic, sizeof(kMagic));
+        putU32(header, kFormatVersion);
+        if (!writeAll(fd_, header.data(), header.size()) || !syncFile(fd_)) {
+            closeFile(fd_);
+            throw std::runtime_error("Cannot write journal header to " + path + ".");
+        }
+    }
+
+    if (options_.syncMode != JournalSyncMode::PER_OPERATION) {
+        flusher_ = std::thread(&Journal::flusherLoop, this);
+    }
+}
+
+Journal::~Journal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    flusherCv_.notify_all();
+    if (flusher_.joinable()) flusher_.join();
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // Nothing more can be done about a failed final write while destroying.
+    }
+    closeFile(fd_);
+}
+
+// --- Appending ---
+// Records are built in place after a placeholder header, so the finished record is a
+// single string that append only has to stamp and move into the batch.
+std::uint64_t Journal::appendCustomerRegistered(const std::string& name, AccountId savingsId, AccountId checkingId) {
+    std::string record(kRecordHeaderSize - 1, '\0');
+    record.push_back(static_cast<char>(JournalRecordType::CUSTOMER_REGISTERED));
+    putString(record, name);
+    putU64(record, savingsId.getPacked());
+    putU64(record, checkingId.getPacked());
+    return append(record);
+}
+
+std::uint64_t Journal::appendTransaction(const Transaction& transaction, std::string_view note) {
+    const auto sinceEpoch = transaction.getTimePoint().time_since_epoch();
+    char transactionId[Transaction::kMaxIdLength];
+    const std::size_t idLength = transaction.formatTransactionId(transactionId);
+    std::string record(kRecordHeaderSize - 1, '\0');
+    record.reserve(kRecordHeaderSize + 48 + idLength + note.size());
+    record.push_back(static_cast<char>(JournalRecordType::TRANSACTION));
+    putString(record, std::string_view(transactionId, idLength));
+    record.push_back(static_cast<char>(transaction.getType()));
+    putU64(record, static_cast<std::uint64_t>(transaction.getAmount().getCents()));
+    putU64(record, transaction.getSourceAccountId().getPacked());
+    putU64(record, transaction.getDestinationAccountId().getPacked());
+    putU64(record, static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count()));
+    putString(record, note);
+    return append(record);
+}
+
+std::uint64_t Journal::append(std::string& record) {
+    const std::size_t payloadLength = record.size() - kRecordHeaderSize;
+    for (int i = 0; i < 4; ++i) record[i] = static_cast<char>((payloadLength >> (8 * i)) & 0xFF);
+    // Type and payload are checksummed outside the lock; only the sequence is left.
+    const std::uint32_t bodyCrc = utils::crc32(record.data() + 16, 1 + payloadLength);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    throwIfFailedLocked();
+
+    const std::uint64_t sequence = ++lastSequence_;
+    for (int i = 0; i < 8; ++i) record[8 + i] = static_cast<char>((sequence >> (8 * i)) & 0xFF);
+    const std::uint32_t crc = utils::crc32(record.data() + 8, 8, bodyCrc);
+    for (int i = 0; i < 4; ++i) record[4 + i] = static_cast<char>((crc >> (8 * i)) & 0xFF);
+
+    const bool wasEmpty = pending_.empty();
+    if (wasEmpty) batchOpened_ = std::chrono::steady_clock::now();
+    pending_ += record;
+
+    // Only wake the flusher when a batch opens or fills; it sleeps on the window otherwise.
+    if (wasEmpty || pending_.size() >= options_.groupCommitMaxBytes) {
+        flusherCv_.notify_one();
+    }
+    return sequence;
+}
+
+void Journal::waitDurable(std::uint64_t sequence) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    throwIfFailedLocked();
+    switch (options_.syncMode) {
+        case JournalSyncMode::ASYNC:
+            return;
+        case JournalSyncMode::GROUP:
+            durableCv_.wait(lock, [&] { return durableSequence_ >= sequence || !error_.empty(); });
+            break;
+        case JournalSyncMode::PER_OPERATION:
+            // Concurrent committers arriving during a write are covered by the next one.
+            while (durableSequence_ < sequence && error_.empty()) {
+                if (writing_) {
+                    durableCv_.wait(lock);
+                } else {
+                    writeBatchLocked(lock);
+                }
+            }
+            break;
+    }
+    throwIfFailedLocked();
+}
+
+void Journal::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::uint64_t target = lastSequence_;
+    while (durableSequence_ < target && error_.empty()) {
+        if (writing_) {
+            durableCv_.wait(lock);
+        } else {
+            writeBatchLocked(lock);
+        }
+    }
+    throwIfFailedLocked();
+}
+
+// --- Accessors ---
+const std::string& Journal::getPath() const { return path_; }
+const JournalOptions& Journal::getOptions() const { return options_; }
+
+std::uint64_t Journal::getLastSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastSequence_;
+}
+
+std::uint64_t Journal::getDurableSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return durableSequence_;
+}
+
+std::uint64_t Journal::getSyncCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return syncCount_;
+}
+
+// --- Reading ---
+std::vector<JournalRecord> Journal::readRecords(const std::string& path, NoteArena& notes, std::uint64_t afterSequence) {
+    std::vector<JournalRecord> records;
+    if (!fileExists(path)) return records;
+    MappedFile file(path);
+    file.prefetch();
+    walkRecords(file, [&](std::uint64_t sequence, JournalRecordType type,
+                          const unsigned char* payload, std::size_t length) {
+        if (sequence > afterSequence) {
+            records.push_back(decodeRecord(sequence, type, payload, length, notes));
+        }
+    });
+    return records;
+}
+
+// --- Internal helpers ---
+// Takes the pending batch, writes and syncs it with the lock released so appends can
+// keep filling the next batch, then publishes the new durable sequence.
+void Journal::writeBatchLocked(std::unique_lock<std::mutex>& lock) {
+    std::string batch;
+    batch.swap(pending_);
+    const std::uint64_t batchEnd = lastSequence_;
+    writing_ = true;
+
+    lock.unlock();
+    const bool ok = batch.empty() || (writeAll(fd_, batch.data(), batch.size()) && syncFile(fd_));
+    const int savedErrno = errno;
+    lock.lock();
+
+    writing_ = false;
+    if (ok) {
+        durableSequence_ = batchEnd;
+        ++syncCount_;
+    } else if (error_.empty()) {
+        error_ = "Journal write to " + path_ + " failed: " + std::strerror(savedErrno);
+    }
+    durableCv_.notify_all();
+}
+
+void Journal::flusherLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        flusherCv_.wait(lock, [&] { return stopping_ || !pending_.empty(); });
+        if (stopping_) return;
+
+        // Hold the batch open for the commit window so concurrent operations can join it.
+        const auto deadline = batchOpened_ + (options_.syncMode == JournalSyncMode::ASYNC
+                                                  ? options_.asyncFlushInterval
+                                                  : options_.groupCommitWindow);
+        flusherCv_.wait_until(lock, deadline, [&] {
+            return stopping_ || pending_.size() >= options_.groupCommitMaxBytes;
+        });
+        if (stopping_) return;
+
+        if (writing_) {
+            durableCv_.wait(lock, [&] { return !writing_; });
+            continue;
+        }
+        if (!pending_.empty()) writeBatchLocked(lock);
+    }
+}
+
+void Journal::throwIfFailedLocked() const {
+    if (!error_.empty()) throw std::runtime_error(error_);
+}
+
+} // namespace banking_system
@@ -0,0 +1,76 @@
+#include "LatencyHistogram.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace banking_system {
+
+namespace {
+
+unsigned highestBit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+} // namespace
+
+// Values below kSubBuckets have a bucket each. Above that, the bucket group is the
+// position of the highest bit and the sub-bucket the kSubBucketBits bits below it.
+std::size_t LatencyHistogram::bucketOf(std::uint64_t nanos) {
+    if (nanos < kSubBuckets) return static_cast<std::size_t>(nanos);
+    const unsigned group = highestBit(nanos) - kSubBucketBits + 1;
+    return group * kSubBuckets + static_cast<std::size_t>((nanos >> (group - 1)) - kSubBuckets);
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t bucket) {
+    const std::size_t group = bucket / kSubBuckets;
+    const std::uint64_t offset = bucket % kSubBuckets;
+    if (group == 0) return offset;
+    const std::uint64_t lower = (kSubBuckets + offset) << (group - 1);
+    return lower + ((std::uint64_t(1) << (group - 1)) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t nanos) {
+    ++counts_[bucketOf(nanos)];
+    ++count_;
+    min_ = std::min(min_, nanos);
+    max_ = std::max(max_, nanos);
+    sum_ += static_cast<double>(nanos);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+
+void LatencyHistogram::reset() {
+    *this = LatencyHistogram();
+}
+
+double LatencyHistogram::getMean() const {
+    return count_ ? sum_ / static_cast<double>(count_) : 0.0;
+}
+
+std::uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    if (count_ == 0) return 0;
+    const double clamped = std::min(100.0, std::max(0.0, percentile));
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count_))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) return std::min(bucketUpperBound(i), max_);
+    }
+    return max_;
+}
+
+} // namespace banking_system
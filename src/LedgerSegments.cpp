@@ -0,0 +1,127 @@
+#include "LedgerSegments.hh"
+#include "Utils.hh"
+
+#include <algorithm>
+
+namespace banking_system {
+
+namespace {
+
+// Hash of an ID whose two halves drive the double hashing into a filter.
+std::uint64_t filterHash(AccountId accountId) {
+    std::uint64_t x = accountId.getPacked() + 0x9E3779B97F4A7C15ULL; // splitmix64 finalizer
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+template <typename Visit>
+void forEachFilterBit(AccountId accountId, std::size_t bitCount, Visit visit) {
+    const std::uint64_t hash = filterHash(accountId);
+    const auto first = static_cast<std::uint32_t>(hash);
+    const auto step = static_cast<std::uint32_t>(hash >> 32) | 1u;
+    for (unsigned i = 0; i < LedgerSegments::kFilterHashes; ++i) {
+        visit((first + i * step) & (bitCount - 1));
+    }
+}
+
+} // namespace
+
+void LedgerSegments::extend(const AppendLog<Transaction>& ledger, std::size_t count, std::size_t accountCount) {
+    for (std::size_t position = recordCount_; position < count; ++position) {
+        const auto time = ledger[position].getTimePoint();
+        if (segments_.empty() || time > latest_) {
+            latest_ = time;
+        } else {
+            maxLag_ = std::max(maxLag_, latest_ - time);
+        }
+        if (segments_.empty() || time >= headDayEnd_) {
+            if (!segments_.empty()) seal(ledger, accountCount);
+            LedgerSegment segment;
+            segment.begin = position;
+            segment.dayStart = utils::localDayStart(time);
+            segment.minTimestamp = time;
+            segment.maxTimestamp = time;
+            headDayEnd_ = utils::nextLocalDayStart(time);
+            segments_.push_back(segment);
+        }
+        LedgerSegment& head = segments_.back();
+        head.end = position + 1;
+        head.minTimestamp = std::min(head.minTimestamp, time);
+        head.maxTimestamp = std::max(head.maxTimestamp, time);
+    }
+    recordCount_ = std::max(recordCount_, count);
+}
+
+// Freezes the head segment and builds its filter from its records.
+void LedgerSegments::seal(const AppendLog<Transaction>& ledger, std::size_t accountCount) {
+    LedgerSegment& head = segments_.back();
+    head.sealed = true;
+
+    const std::size_t accounts = std::max<std::size_t>(1, std::min(2 * (head.end - head.begin), accountCount));
+    std::size_t bitCount = 64;
+    while (bitCount < accounts * kBitsPerAccount) bitCount *= 2;
+    std::vector<std::uint64_t> filter(bitCount / 64);
+    auto add = [&](AccountId accountId) {
+        if (!accountId.isValid()) return;
+        forEachFilterBit(accountId, bitCount, [&](std::size_t bit) { filter[bit / 64] |= std::uint64_t(1) << (bit % 64); });
+    };
+    for (std::size_t position = head.begin; position < head.end; ++position) {
+        add(ledger[position].getSourceAccountId());
+        add(ledger[position].getDestinationAccountId());
+    }
+    filters_.push_back(std::move(filter));
+}
+
+// No record is stamped more than maxLag_ earlier than one before it. So if the record
+// before position b is stamped before from - maxLag_, so is every earlier one, and all
+// of them are before from; and if the record at b is stamped at or after to + maxLag_,
+// every later one is at or after to. firstAtOrAfter finds such a b for either bound.
+std::pair<std::size_t, std::size_t> LedgerSegments::positionRange(const AppendLog<Transaction>& ledger,
+                                                                  std::chrono::system_clock::time_point from,
+                                                                  std::chrono::system_clock::time_point to) const {
+    using TimePoint = std::chrono::system_clock::time_point;
+    const std::size_t begin = (from < TimePoint::min() + maxLag_) ? 0 : firstAtOrAfter(ledger, from - maxLag_);
+    const std::size_t end = (to > TimePoint::max() - maxLag_) ? recordCount_ : firstAtOrAfter(ledger, to + maxLag_);
+    return {begin, end};
+}
+
+// Segment maxima ascend, since a record at or after a day's end starts a new segment,
+// so the first segment whose newest record is at or after time holds the boundary;
+// every segment before it is wholly earlier. Within it the search keeps the record
+// before low earlier than time and the record at high at or after it.
+std::size_t LedgerSegments::firstAtOrAfter(const AppendLog<Transaction>& ledger,
+                                           std::chrono::system_clock::time_point time) const {
+    const auto segment = std::partition_point(segments_.begin(), segments_.end(),
+        [time](const LedgerSegment& s) { return s.maxTimestamp < time; });
+    if (segment == segments_.end()) return recordCount_;
+    std::size_t low = segment->begin;
+    std::size_t high = segment->end;
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        if (ledger[middle].getTimePoint() < time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+bool LedgerSegments::mayContain(AccountId accountId, std::size_t begin, std::size_t end) const {
+    if (end > recordCount_) return true; // Records not indexed yet
+    auto segment = std::partition_point(segments_.begin(), segments_.end(),
+        [begin](const LedgerSegment& s) { return s.end <= begin; });
+    for (; segment != segments_.end() && segment->begin < end; ++segment) {
+        if (!segment->sealed) return true;
+        const std::vector<std::uint64_t>& filter = filters_[static_cast<std::size_t>(segment - segments_.begin())];
+        bool present = true;
+        forEachFilterBit(accountId, filter.size() * 64, [&](std::size_t bit) {
+            present = present && (filter[bit / 64] >> (bit % 64) & 1);
+        });
+        if (present) return true;
+    }
+    return false;
+}
+
+} // namespace banking_system
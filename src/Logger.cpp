@@ -0,0 +1,289 @@
+#include "Logger.hh"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+namespace banking_system {
+
+namespace {
+
+// How long the writer sleeps when the ring is empty. Producers never wake it, so this
+// bounds the delay before a line reaches the sink; flush() wakes it immediately.
+constexpr std::chrono::milliseconds kPollInterval{2};
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "DEBUG  ";
+        case LogLevel::INFO: return "INFO   ";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR: return "ERROR  ";
+        default: return "       ";
+    }
+}
+
+// Writes "YYYY-MM-DD HH:MM:SS.mmm" (local time, 23 chars) to out. The date and time
+// part is only reformatted when the second changes; called from the writer thread only.
+std::size_t formatTimestamp(std::int64_t timestampNanos, char* out) {
+    static std::time_t cachedSecond = -1;
+    static char cachedText[24];
+    const std::time_t seconds = static_cast<std::time_t>(timestampNanos / 1000000000);
+    if (seconds != cachedSecond) {
+        std::tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        std::strftime(cachedText, sizeof(cachedText), "%Y-%m-%d %H:%M:%S", &local);
+        cachedSecond = seconds;
+    }
+    const int millis = static_cast<int>((timestampNanos / 1000000) % 1000);
+    std::memcpy(out, cachedText, 19);
+    out[19] = '.';
+    out[20] = static_cast<char>('0' + millis / 100);
+    out[21] = static_cast<char>('0' + millis / 10 % 10);
+    out[22] = static_cast<char>('0' + millis % 10);
+    return 23;
+}
+
+// Log lines only show milliseconds, so on Linux the coarse clock, read from the vDSO
+// without touching the clock source, is precise enough at a fraction of the cost.
+std::int64_t nowNanos() {
+#ifdef __linux__
+    timespec now;
+    if (clock_gettime(CLOCK_REALTIME_COARSE, &now) == 0) {
+        return static_cast<std::int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+// --- Logger ---
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : slots_(new Slot[kCapacity]) {
+    // A slot is free for the producer that reserves position p when its sequence is p.
+    for (std::size_t i = 0; i < kCapacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer_ = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+    if (file_) std::fclose(file_);
+}
+
+void Logger::setLevel(LogLevel level) {
+    level_.store(level, std::memory_order_relaxed);
+}
+
+LogLevel Logger::getLevel() const {
+    return level_.load(std::memory_order_relaxed);
+}
+
+void Logger::openFile(const std::string& path, std::size_t maxBytes, unsigned maxFiles) {
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        throw std::runtime_error("Cannot open log file " + path + ".");
+    }
+    std::fseek(file, 0, SEEK_END);
+    const long existing = std::ftell(file);
+
+    std::lock_guard<std::mutex> sinkLock(sinkMutex_);
+    if (file_) std::fclose(file_);
+    file_ = file;
+    filePath_ = path;
+    fileBytes_ = existing > 0 ? static_cast<std::size_t>(existing) : 0;
+    maxFileBytes_ = maxBytes;
+    maxFiles_ = maxFiles;
+}
+
+void Logger::closeFile() {
+    flush();
+    std::lock_guard<std::mutex> sinkLock(sinkMutex_);
+    if (file_) std::fclose(file_);
+    file_ = nullptr;
+    filePath_.clear();
+}
+
+void Logger::flush() {
+    const std::uint64_t target = enqueuePosition_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    flushRequested_ = true;
+    wake_.notify_one();
+    written_.wait(lock, [&] { return writtenPosition_.load(std::memory_order_acquire) >= target; });
+}
+
+bool Logger::publish(LogLevel level, const char* text, std::size_t length) {
+    std::uint64_t position = enqueuePosition_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[position & (kCapacity - 1)];
+        const std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto lag = static_cast<std::int64_t>(sequence - position);
+        if (lag == 0) {
+            if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (lag < 0) {
+            // The writer has not freed this slot yet: the ring is full.
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueuePosition_.load(std::memory_order_relaxed);
+        }
+    }
+
+    length = std::min(length, kMaxMessageLength);
+    slot->timestampNanos = nowNanos();
+    slot->level = level;
+    slot->length = static_cast<std::uint16_t>(length);
+    std::memcpy(slot->text, text, length);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+std::uint64_t Logger::getDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void Logger::run() {
+    for (;;) {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait_for(lock, kPollInterval, [&] { return flushRequested_ || stopping_; });
+            flushRequested_ = false;
+            stop = stopping_;
+        }
+        drain();
+        if (stop) return;
+    }
+}
+
+// Writes every published message in ring order. Stops at the first slot that has
+// been reserved but not yet filled; the next pass picks it up.
+void Logger::drain() {
+    bool wrote = false;
+    {
+        std::lock_guard<std::mutex> sinkLock(sinkMutex_);
+        for (;;) {
+            Slot& slot = slots_[dequeuePosition_ & (kCapacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition_ + 1) break;
+            writeLine(slot.level, slot.timestampNanos, slot.text, slot.length);
+            slot.sequence.store(dequeuePosition_ + kCapacity, std::memory_order_release);
+            ++dequeuePosition_;
+            wrote = true;
+        }
+
+        const std::uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != droppedReported_) {
+            char text[64];
+            char* end = std::to_chars(text, text + sizeof(text), dropped - droppedReported_).ptr;
+            const char suffix[] = " log messages dropped, the log buffer was full.";
+            std::memcpy(end, suffix, sizeof(suffix) - 1);
+            end += sizeof(suffix) - 1;
+            writeLine(LogLevel::WARNING, nowNanos(), text, static_cast<std::size_t>(end - text));
+            droppedReported_ = dropped;
+            wrote = true;
+        }
+
+        if (wrote) {
+            if (file_) {
+                std::fflush(file_);
+            } else {
+                std::fflush(stdout);
+                std::fflush(stderr);
+            }
+        }
+    }
+
+    writtenPosition_.store(dequeuePosition_, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    written_.notify_all();
+}
+
+// Caller holds sinkMutex_.
+void Logger::writeLine(LogLevel level, std::int64_t timestampNanos, const char* text, std::size_t length) {
+    char line[32 + kMaxMessageLength + 1];
+    std::size_t size = formatTimestamp(timestampNanos, line);
+    line[size++] = ' ';
+    std::memcpy(line + size, levelName(level), 7);
+    size += 7;
+    line[size++] = ' ';
+    std::memcpy(line + size, text, length);
+    size += length;
+    line[size++] = '\n';
+
+    if (!file_) {
+        std::fwrite(line, 1, size, level >= LogLevel::WARNING ? stderr : stdout);
+        return;
+    }
+    std::fwrite(line, 1, size, file_);
+    fileBytes_ += size;
+    if (fileBytes_ >= maxFileBytes_) rotate();
+}
+
+// Caller holds sinkMutex_. Shifts path.1 .. path.<maxFiles - 1> up by one, moves the
+// current file to path.1 and starts an empty one.
+void Logger::rotate() {
+    std::fclose(file_);
+    file_ = nullptr;
+    if (maxFiles_ > 0) {
+        std::remove((filePath_ + "." + std::to_string(maxFiles_)).c_str());
+        for (unsigned i = maxFiles_ - 1; i >= 1; --i) {
+            const std::string from = filePath_ + "." + std::to_string(i);
+            std::rename(from.c_str(), (filePath_ + "." + std::to_string(i + 1)).c_str());
+        }
+        std::rename(filePath_.c_str(), (filePath_ + ".1").c_str());
+    }
+    file_ = std::fopen(filePath_.c_str(), "wb");
+    fileBytes_ = 0;
+}
+
+// --- LogLine ---
+LogLine& LogLine::operator<<(Money amount) {
+    char text[Money::kMaxTextLength];
+    return append(std::string_view(text, amount.format(text)));
+}
+
+LogLine& LogLine::operator<<(AccountId accountId) {
+    char text[AccountId::kTextLength];
+    accountId.format(text);
+    return append(std::string_view(text, sizeof(text)));
+}
+
+LogLine& LogLine::append(std::string_view text) {
+    const std::size_t count = std::min(text.size(), sizeof(buffer_) - length_);
+    std::memcpy(buffer_ + length_, text.data(), count);
+    length_ += count;
+    return *this;
+}
+
+LogLine& LogLine::appendInteger(long long value) {
+    char text[24];
+    return append(std::string_view(text, static_cast<std::size_t>(std::to_chars(text, text + sizeof(text), value).ptr - text)));
+}
+
+LogLine& LogLine::appendInteger(unsigned long long value) {
+    char text[24];
+    return append(std::string_view(text, static_cast<std::size_t>(std::to_chars(text, text + sizeof(text), value).ptr - text)));
+}
+
+} // namespace banking_system
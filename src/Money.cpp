@@ -0,0 +1,87 @@
+#include "Money.hh"
+
+#include <charconv>
+#include <cmath>
+#include <ostream>
+
+namespace banking_system {
+
+Money Money::fromDouble(double amount) {
+    if (!std::isfinite(amount)) {
+        throw std::out_of_range("Amount must be a finite number.");
+    }
+    const double cents = std::round(amount * 100.0);
+    // 2^63 is exactly representable; anything at or beyond it does not fit in int64.
+    if (cents >= 9223372036854775808.0 || cents < -9223372036854775808.0) {
+        throw std::out_of_range("Amount is too large.");
+    }
+    return Money(static_cast<std::int64_t>(cents));
+}
+
+std::optional<Money> Money::parse(std::string_view text) {
+    std::size_t pos = 0;
+    bool negative = false;
+    if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+        negative = (text[pos] == '-');
+        ++pos;
+    }
+
+    std::int64_t units = 0;
+    std::size_t integerDigits = 0;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+        const int digit = text[pos] - '0';
+        // Keep room for the two fractional digits appended below.
+        constexpr std::int64_t kMaxUnits = (std::numeric_limits<std::int64_t>::max() - 99) / 100;
+        if (units > (kMaxUnits - digit) / 10) {
+            return std::nullopt;
+        }
+        units = units * 10 + digit;
+        ++integerDigits;
+        ++pos;
+    }
+
+    std::int64_t fraction = 0;
+    std::size_t fractionDigits = 0;
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            if (fractionDigits == 2) return std::nullopt; // Sub-cent precision is rejected.
+            fraction = fraction * 10 + (text[pos] - '0');
+            ++fractionDigits;
+            ++pos;
+        }
+    }
+    if (pos != text.size() || (integerDigits == 0 && fractionDigits == 0)) {
+        return std::nullopt;
+    }
+    if (fractionDigits == 1) fraction *= 10;
+
+    const std::int64_t cents = units * 100 + fraction;
+    return Money(negative ? -cents : cents);
+}
+
+std::string Money::toString() const {
+    char text[kMaxTextLength];
+    return std::string(text, format(text));
+}
+
+std::size_t Money::format(char* out) const {
+    // Work in unsigned so that the most negative value formats correctly.
+    const bool negative = cents_ < 0;
+    std::uint64_t magnitude = negative ? (0 - static_cast<std::uint64_t>(cents_))
+                                       : static_cast<std::uint64_t>(cents_);
+    char* cursor = out;
+    if (negative) *cursor++ = '-';
+    cursor = std::to_chars(cursor, out + kMaxTextLength, magnitude / 100).ptr;
+    const unsigned fraction = static_cast<unsigned>(magnitude % 100);
+    *cursor++ = '.';
+    *cursor++ = static_cast<char>('0' + fraction / 10);
+    *cursor++ = static_cast<char>('0' + fraction % 10);
+    return static_cast<std::size_t>(cursor - out);
+}
+
+std::ostream& operator<<(std::ostream& os, Money amount) {
+    return os << amount.toString();
+}
+
+} // namespace banking_system
@@ -0,0 +1,101 @@
+#include "NoteArena.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace banking_system {
+
+namespace {
+
+std::atomic<std::uint64_t> nextArenaId{1};
+
+// The last note this thread stored, and the arena it went to.
+struct LastNote {
+    std::uint64_t arenaId = 0;
+    NoteArena::Note note;
+    std::string_view text;
+};
+
+thread_local LastNote lastNote;
+
+} // namespace
+
+NoteArena::NoteArena()
+    : id_(nextArenaId.fetch_add(1, std::memory_order_relaxed)),
+      chunks_(new std::atomic<char*>[kMaxChunks]()) {}
+
+NoteArena::Note NoteArena::intern(std::string_view note) {
+    if (note.empty()) return {};
+    if (lastNote.arenaId == id_ && note == lastNote.text) return lastNote.note;
+
+    Note stored;
+    stored.length = static_cast<std::uint32_t>(note.size());
+    char* copy = nullptr;
+    // The copy is made under the lock, so every byte inside a cut() is final.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (note.size() > kMaxInlineNote) {
+        const std::size_t first = chunkCount_;
+        copy = allocateChunks((note.size() + kChunkSize - 1) / kChunkSize);
+        stored.offset = static_cast<std::uint32_t>(first << kChunkBits);
+    } else {
+        if (note.size() > kChunkSize - openChunkUsed_) {
+            openChunk_ = chunkCount_;
+            openChunkUsed_ = 0;
+            allocateChunks(1);
+        }
+        copy = chunks_[openChunk_].load(std::memory_order_relaxed) + openChunkUsed_;
+        stored.offset = static_cast<std::uint32_t>((openChunk_ << kChunkBits) + openChunkUsed_);
+        openChunkUsed_ += note.size();
+    }
+    std::memcpy(copy, note.data(), note.size());
+    lastNote = {id_, stored, std::string_view(copy, note.size())};
+    return stored;
+}
+
+// Allocates count chunks as one contiguous block, so a long note spanning them can be
+// viewed in one piece. Blocks are zeroed: bytes no note uses read as zeros in images.
+char* NoteArena::allocateChunks(std::size_t count) {
+    if (count > kMaxChunks - chunkCount_) {
+        throw std::length_error("NoteArena capacity exhausted.");
+    }
+    blocks_.push_back(std::make_unique<char[]>(count * kChunkSize));
+    char* block = blocks_.back().get();
+    for (std::size_t i = 0; i < count; ++i) {
+        chunks_[chunkCount_ + i].store(block + i * kChunkSize, std::memory_order_relaxed);
+    }
+    chunkCount_ += count;
+    return block;
+}
+
+// --- Images ---
+NoteArena::Cut NoteArena::cut() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Cut cut;
+    cut.chunks = chunkCount_;
+    cut.openChunk = openChunk_;
+    cut.openChunkUsed = openChunkUsed_;
+    return cut;
+}
+
+std::string_view NoteArena::chunkImage(const Cut& cut, std::size_t c) const {
+    const char* chunk = chunks_[c].load(std::memory_order_relaxed);
+    return std::string_view(chunk, (c == cut.openChunk) ? cut.openChunkUsed : kChunkSize);
+}
+
+void NoteArena::loadImage(const char* image, std::size_t imageSize) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (chunkCount_ != 0 || imageSize % kChunkSize != 0) {
+        throw std::logic_error("A note image can only be loaded whole into an empty arena.");
+    }
+    if (imageSize == 0) return;
+    std::memcpy(allocateChunks(imageSize / kChunkSize), image, imageSize);
+    // New small notes start a chunk of their own after the image.
+    openChunkUsed_ = kChunkSize;
+}
+
+std::size_t NoteArena::getBytesAllocated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunkCount_ * kChunkSize;
+}
+
+} // namespace banking_system
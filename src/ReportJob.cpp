@@ -0,0 +1,86 @@
+#include "ReportJob.hh"
+#include "Bank.hh"
+#include "Utils.hh"
+
+#include <filesystem>
+#include <optional>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace banking_system {
+
+ReportJob::ReportJob(TransactionQuery scope) : scope_(std::move(scope)) {}
+
+std::size_t ReportJob::update(const Bank& bank, const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto today = utils::localDayStart(std::chrono::system_clock::now());
+    const std::size_t count = bank.getTransactionCount();
+    const bool append = canAppend(path, today);
+    if (!append) {
+        highWaterMark_ = 0;
+        totals_ = ReportTotals();
+    }
+
+    // The writer needs random access, so only pointers to the new records are
+    // gathered; the records themselves are not copied.
+    TransactionCursor cursor = bank.queryTransactions(TransactionQuery(scope_).positions(highWaterMark_, count));
+    std::vector<const Transaction*> records(cursor.remainingUpperBound());
+    records.resize(cursor.next(records.data(), records.size()));
+    if (append && records.empty()) {
+        highWaterMark_ = count; // The file is already current
+        return 0;
+    }
+
+    ReportTotals totals = totals_;
+    for (const Transaction* record : records) totals.add(*record);
+
+    fileSize_ = 0; // Until the file is complete again
+    std::optional<ReportWriter> writer;
+    if (append) {
+        writer.emplace(path, bodyEnd_);
+    } else {
+        writer.emplace(path);
+        writer->writeHeader();
+    }
+    if (totals.records == 0) {
+        writer->writeText("No transaction records.\n");
+    } else {
+        writer->writeTransactions(records.size(),
+                                  [&records](std::size_t i) -> const Transaction& { return *records[i]; },
+                                  bank.getNotes());
+    }
+    const std::uint64_t bodyEnd = writer->getSize();
+    writer->writeFooter(totals);
+    const std::uint64_t fileSize = writer->getSize();
+    writer->close();
+
+    path_ = path;
+    if (!append) day_ = today;
+    highWaterMark_ = count;
+    bodyEnd_ = bodyEnd;
+    fileSize_ = fileSize;
+    totals_ = totals;
+    return records.size();
+}
+
+std::size_t ReportJob::getHighWaterMark() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return highWaterMark_;
+}
+
+ReportTotals ReportJob::getTotals() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totals_;
+}
+
+// The placeholder line of an empty report is not a record line, so a report that had
+// none is rewritten; that costs no more than appending to it would.
+bool ReportJob::canAppend(const std::string& path, std::chrono::system_clock::time_point today) const {
+    if (fileSize_ == 0 || totals_.records == 0 || path != path_ || today != day_) return false;
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    return !error && size == fileSize_;
+}
+
+} // namespace banking_system
@@ -0,0 +1,187 @@
+#include "ReportWriter.hh"
+#include "Utils.hh"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+namespace banking_system {
+
+namespace {
+
+constexpr std::string_view kSeparator = "--------------------------------------------------\n";
+
+char* appendText(char* out, std::string_view text) {
+    std::memcpy(out, text.data(), text.size());
+    return out + text.size();
+}
+
+std::string_view typeLabel(TransactionType type) {
+    switch (type) {
+        case TransactionType::DEPOSIT: return "Deposit";
+        case TransactionType::WITHDRAWAL: return "Withdrawal";
+        case TransactionType::TRANSFER_OUT: return "Transfer Out";
+        case TransactionType::TRANSFER_IN: return "Transfer In";
+        case TransactionType::INTEREST: return "Interest";
+        default: return "Unknown";
+    }
+}
+
+} // namespace
+
+// --- TransactionFormatter ---
+std::size_t TransactionFormatter::format(const Transaction& transaction, char* out) {
+    const AccountId ids[] = {transaction.getSourceAccountId(), transaction.getDestinationAccountId()};
+    char accountTexts[2 * AccountId::kTextLength];
+    char* text = accountTexts;
+    for (AccountId id : ids) {
+        if (!id.isValid()) continue;
+        id.format(text);
+        text += AccountId::kTextLength;
+    }
+    return format(transaction, accountTexts, out);
+}
+
+std::size_t TransactionFormatter::format(const Transaction& transaction, const char* accountTexts, char* out) {
+    const std::time_t second = transaction.getTimestamp();
+    if (second != cachedSecond_) {
+        std::tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &second);
+#else
+        localtime_r(&second, &local);
+#endif
+        char* cursor = appendText(cachedPrefix_, "Time: ");
+        // strftime also writes a terminator, which the fixed-length copy below drops.
+        char stamp[20];
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+        cursor = appendText(cursor, std::string_view(stamp, 19));
+        appendText(cursor, " | ID: ");
+        cachedSecond_ = second;
+    }
+
+    char* cursor = appendText(out, std::string_view(cachedPrefix_, kPrefixLength));
+    cursor += transaction.formatTransactionId(cursor);
+    cursor = appendText(cursor, " | Type: ");
+    cursor = appendText(cursor, typeLabel(transaction.getType()));
+    cursor = appendText(cursor, " | Amount: $");
+    cursor += transaction.getAmount().format(cursor);
+
+    if (transaction.getSourceAccountId().isValid()) {
+        cursor = appendText(cursor, " | Source: ");
+        cursor = appendText(cursor, std::string_view(accountTexts, AccountId::kTextLength));
+        accountTexts += AccountId::kTextLength;
+    }
+    if (transaction.getDestinationAccountId().isValid()) {
+        cursor = appendText(cursor, " | Destination: ");
+        cursor = appendText(cursor, std::string_view(accountTexts, AccountId::kTextLength));
+    }
+    const std::string_view note = transaction.getNote(*notes_);
+    if (!note.empty()) {
+        cursor = appendText(cursor, " | Note: ");
+        cursor = appendText(cursor, note);
+    }
+    return static_cast<std::size_t>(cursor - out);
+}
+
+// --- ReportTotals ---
+void ReportTotals::add(const Transaction& transaction) {
+    ++records;
+    switch (transaction.getType()) {
+        case TransactionType::DEPOSIT: deposits += transaction.getAmount(); break;
+        case TransactionType::WITHDRAWAL: withdrawals += transaction.getAmount(); break;
+        case TransactionType::TRANSFER_OUT: transfersOut += transaction.getAmount(); break;
+        case TransactionType::TRANSFER_IN: transfersIn += transaction.getAmount(); break;
+        case TransactionType::INTEREST: interest += transaction.getAmount(); break;
+    }
+}
+
+// --- ReportWriter ---
+ReportWriter::ReportWriter(const std::string& path) : path_(path) {
+    open("wb");
+}
+
+// The kept bytes are overwritten in place rather than cut off first: truncating a file
+// whose pages are still dirty makes the filesystem flush them, which costs as much as
+// writing the report again. The old tail is cut off in close() only if the new one
+// turned out shorter.
+ReportWriter::ReportWriter(const std::string& path, std::uint64_t keepBytes) : path_(path), size_(keepBytes) {
+    std::error_code error;
+    reopenedSize_ = std::filesystem::file_size(path, error);
+    if (error || reopenedSize_ < keepBytes) {
+        throw std::runtime_error("Cannot reopen report file " + path + ": it is shorter than expected.");
+    }
+    open("r+b");
+#ifdef _WIN32
+    const int seeked = _fseeki64(file_, static_cast<__int64>(keepBytes), SEEK_SET);
+#else
+    const int seeked = fseeko(file_, static_cast<off_t>(keepBytes), SEEK_SET);
+#endif
+    if (seeked != 0) {
+        throw std::runtime_error("Cannot reopen report file " + path + ": " + std::strerror(errno));
+    }
+}
+
+void ReportWriter::open(const char* mode) {
+    file_ = std::fopen(path_.c_str(), mode);
+    if (!file_) {
+        throw std::runtime_error("Cannot open report file " + path_ + ": " + std::strerror(errno));
+    }
+    // Chunks are written in one call each and bypass this buffer; it only gathers
+    // the short header and footer lines.
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 16);
+}
+
+ReportWriter::~ReportWriter() {
+    if (file_) std::fclose(file_);
+}
+
+void ReportWriter::writeText(std::string_view text) {
+    write(text.data(), text.size());
+}
+
+void ReportWriter::writeHeader() {
+    writeText("Transaction Report - Generated: " + utils::getCurrentDateString() + "\n");
+    writeText(kSeparator);
+}
+
+void ReportWriter::writeFooter(const ReportTotals& totals) {
+    writeText(kSeparator);
+    writeText("Totals - Records: " + std::to_string(totals.records) +
+              " | Deposits: $" + totals.deposits.toString() +
+              " | Withdrawals: $" + totals.withdrawals.toString() +
+              " | Transfers Out: $" + totals.transfersOut.toString() +
+              " | Transfers In: $" + totals.transfersIn.toString() +
+              " | Interest: $" + totals.interest.toString() + "\n");
+}
+
+void ReportWriter::close() {
+    std::FILE* file = file_;
+    file_ = nullptr;
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("Cannot finish report file " + path_ + ".");
+    }
+    if (reopenedSize_ > size_) {
+        std::error_code error;
+        std::filesystem::resize_file(path_, size_, error);
+        if (error) throw std::runtime_error("Cannot finish report file " + path_ + ": " + error.message());
+    }
+}
+
+unsigned ReportWriter::resolveThreads(unsigned threads, std::size_t chunks) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, kMaxThreads);
+    return static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+}
+
+void ReportWriter::write(const char* data, std::size_t bytes) {
+    if (bytes != 0 && std::fwrite(data, 1, bytes, file_) != bytes) {
+        throw std::runtime_error("Cannot write report file " + path_ + ": " + std::strerror(errno));
+    }
+    size_ += bytes;
+}
+
+} // namespace banking_system
@@ -0,0 +1,297 @@
+#include "SearchIndex.hh"
+
+#include <algorithm>
+#include <iterator>
+
+namespace banking_system {
+
+namespace {
+
+// Keys compare by byte, with 0 marking the end of a key, so a NUL byte in a key would
+// end it early.
+unsigned char normalizeByte(char c) {
+    if (c >= 'A' && c <= 'Z') return static_cast<unsigned char>(c - 'A' + 'a');
+    return c == '\0' ? static_cast<unsigned char>(' ') : static_cast<unsigned char>(c);
+}
+
+std::size_t normalize(std::string_view text, unsigned char* out) {
+    const std::size_t length = std::min(text.size(), SearchIndex::kMaxKeyLength);
+    for (std::size_t i = 0; i < length; ++i) out[i] = normalizeByte(text[i]);
+    return length;
+}
+
+// Big-endian, so packed keys order like their bytes; missing bytes are zero.
+std::uint64_t packBytes(const unsigned char* bytes, std::size_t count) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < 8; ++i) value = (value << 8) | (i < count ? bytes[i] : 0u);
+    return value;
+}
+
+// First position in [begin, last) whose record fails holds, which holds for a prefix of
+// the range. Gallops from begin: trie children are found in order, and the next one
+// usually starts close by, in records that are already cached.
+template <typename Records, typename Predicate>
+std::size_t gallop(const Records& records, std::size_t begin, std::size_t last, Predicate holds) {
+    std::size_t step = 1;
+    while (begin + step < last && holds(records[begin + step])) step <<= 1;
+    const auto from = records.begin() + static_cast<std::ptrdiff_t>(begin + step / 2);
+    const auto to = records.begin() + static_cast<std::ptrdiff_t>(std::min(begin + step, last));
+    return static_cast<std::size_t>(std::partition_point(from, to, holds) - records.begin());
+}
+
+} // namespace
+
+// State of one pass of find over one run.
+struct SearchIndex::Walk {
+    std::basic_string<unsigned char> query;      // Normalized
+    unsigned budget = 0;                         // Edits allowed in this pass
+    std::size_t maxDepth = 0;                    // No prefix longer than query + budget can match
+    std::vector<std::uint8_t> rows;              // Row d: edits between the path to depth d and each query prefix
+    std::vector<unsigned char> path;
+    const std::vector<SearchMatch>* found = nullptr; // Matches of earlier passes
+    std::size_t need = 0;
+    std::size_t visits = 0;                      // Rows computed in this pass
+    std::vector<const Record*> candidates;       // This run's, in key order
+
+    std::size_t columns() const { return query.size() + 1; }
+    std::uint8_t* row(std::size_t depth) { return rows.data() + depth * columns(); }
+    bool done() const { return candidates.size() >= need || (budget > 0 && visits >= kMaxVisits); }
+};
+
+// --- Adding keys ---
+void SearchIndex::add(std::string_view key) {
+    unsigned char bytes[kMaxKeyLength];
+    const std::size_t length = normalize(key, bytes);
+
+    Record record;
+    for (std::size_t w = 0; w < kInlineWords; ++w) {
+        record.words[w] = packBytes(bytes + 8 * w, length > 8 * w ? length - 8 * w : 0);
+    }
+    record.entry = entryCount_;
+    record.length = static_cast<std::uint32_t>(length);
+    longKeyOffsets_.push_back(static_cast<std::uint32_t>(longKeys_.size()));
+    if (length > kInlineBytes) {
+        longKeys_.append(reinterpret_cast<const char*>(bytes) + kInlineBytes, length - kInlineBytes);
+    }
+
+    if (runs_.empty() || runs_.back().size() >= kBufferSize) {
+        runs_.emplace_back();
+        runs_.back().reserve(kBufferSize);
+    }
+    Run& buffer = runs_.back();
+    buffer.push_back(record);
+    ++entryCount_;
+    if (buffer.size() == kBufferSize) {
+        std::sort(buffer.begin(), buffer.end(), [this](const Record& a, const Record& b) { return less(a, b); });
+        compact();
+    }
+}
+
+void SearchIndex::reserve(std::size_t entries) {
+    longKeyOffsets_.reserve(longKeyOffsets_.size() + entries);
+}
+
+// Merges the full, sorted buffer into the runs before it while they are no larger, so
+// run sizes keep halving from the first and each key is merged O(log n) times.
+void SearchIndex::compact() {
+    while (runs_.size() >= 2 && runs_[runs_.size() - 2].size() <= runs_.back().size()) {
+        const Run& newer = runs_.back();
+        const Run& older = runs_[runs_.size() - 2];
+        Run merged;
+        merged.reserve(older.size() + newer.size());
+        std::merge(older.begin(), older.end(), newer.begin(), newer.end(), std::back_inserter(merged),
+                   [this](const Record& a, const Record& b) { return less(a, b); });
+        runs_.pop_back();
+        runs_.back() = std::move(merged);
+    }
+}
+
+unsigned SearchIndex::byteAt(const Record& record, std::size_t depth) const {
+    if (depth >= record.length) return 0;
+    if (depth < kInlineBytes) return static_cast<unsigned>(record.words[depth / 8] >> (56 - 8 * (depth % 8))) & 0xFFu;
+    return static_cast<unsigned char>(longKeys_[longKeyOffsets_[record.entry] + depth - kInlineBytes]);
+}
+
+bool SearchIndex::less(const Record& a, const Record& b) const {
+    for (std::size_t w = 0; w < kInlineWords; ++w) {
+        if (a.words[w] != b.words[w]) return a.words[w] < b.words[w];
+    }
+    if (a.length > kInlineBytes && b.length > kInlineBytes) {
+        const std::string_view aRest(longKeys_.data() + longKeyOffsets_[a.entry], a.length - kInlineBytes);
+        const std::string_view bRest(longKeys_.data() + longKeyOffsets_[b.entry], b.length - kInlineBytes);
+        return aRest < bRest;
+    }
+    return a.length < b.length; // One is a prefix of the other
+}
+
+// --- Searching ---
+unsigned SearchIndex::editsFor(std::size_t length) {
+    if (length < 3) return 0;
+    return length < 6 ? 1 : 2;
+}
+
+std::vector<SearchMatch> SearchIndex::find(std::string_view query, std::size_t limit, unsigned maxEdits) const {
+    std::vector<SearchMatch> matches;
+    if (limit == 0 || entryCount_ == 0) return matches;
+
+    Walk state;
+    state.query.resize(std::min(query.size(), kMaxKeyLength));
+    normalize(query, state.query.data());
+    state.found = &matches;
+    const std::size_t length = state.query.size();
+    // A budget as large as the query would match every key.
+    maxEdits = std::min({maxEdits, kMaxEdits, length ? static_cast<unsigned>(length - 1) : 0u});
+
+    // The buffer is sorted only once it is full; until then a sorted copy is searched.
+    Run buffer;
+    const std::size_t sortedRuns = (runs_.back().size() < kBufferSize) ? runs_.size() - 1 : runs_.size();
+    if (sortedRuns < runs_.size()) {
+        buffer = runs_.back();
+        std::sort(buffer.begin(), buffer.end(), [this](const Record& a, const Record& b) { return less(a, b); });
+    }
+
+    std::vector<const Record*> candidates;
+    for (unsigned budget = 0; budget <= maxEdits && matches.size() < limit; ++budget) {
+        state.budget = budget;
+        state.maxDepth = length + budget;
+        state.need = limit - matches.size();
+        state.visits = 0;
+        state.rows.assign((state.maxDepth + 1) * state.columns(), static_cast<std::uint8_t>(budget + 1));
+        state.path.assign(state.maxDepth + 1, 0);
+        for (std::size_t j = 0; j <= length; ++j) {
+            state.row(0)[j] = static_cast<std::uint8_t>(std::min<std::size_t>(j, budget + 1));
+        }
+
+        candidates.clear();
+        for (std::size_t r = 0; r < runs_.size(); ++r) {
+            const Run& run = (r < sortedRuns) ? runs_[r] : buffer;
+            state.candidates.clear();
+            walk(run, 0, run.size(), 0, state);
+            candidates.insert(candidates.end(), state.candidates.begin(), state.candidates.end());
+        }
+        // Each run's candidates are its first in key order; the pass keeps the first overall.
+        std::sort(candidates.begin(), candidates.end(),
+                  [this](const Record* a, const Record* b) { return less(*a, *b); });
+        const std::size_t taken = std::min(candidates.size(), state.need);
+        for (std::size_t i = 0; i < taken; ++i) {
+            matches.push_back({candidates[i]->entry, static_cast<std::uint8_t>(budget)});
+        }
+    }
+    return matches;
+}
+
+// Computes the row below depth for the next path byte and returns the lowest cell.
+// Cells never drop below the lowest of the row above, so once it exceeds the budget
+// nothing deeper can match.
+unsigned SearchIndex::advance(std::size_t depth, unsigned byte, Walk& state) const {
+    // A cell more than the budget off the diagonal exceeds it, so only the band around
+    // the diagonal is computed; budget + 1 stands for every larger value.
+    const std::size_t length = state.query.size();
+    const std::size_t i = depth + 1;
+    const unsigned over = state.budget + 1;
+    const std::size_t low = i > state.budget ? i - state.budget : 1;
+    const std::size_t high = std::min(length, i + state.budget);
+    const std::uint8_t* row = state.row(depth);
+    const std::uint8_t* previous = depth > 0 ? state.row(depth - 1) : nullptr;
+    std::uint8_t* next = state.row(depth + 1);
+    ++state.visits;
+    state.path[depth] = static_cast<unsigned char>(byte);
+    next[0] = static_cast<std::uint8_t>(std::min<std::size_t>(i, over));
+    if (low > 1) next[low - 1] = static_cast<std::uint8_t>(over);
+    unsigned lowest = next[0];
+    for (std::size_t j = low; j <= high; ++j) {
+        const unsigned cost = state.query[j - 1] == byte ? 0u : 1u;
+        unsigned cell = std::min({row[j] + 1u, next[j - 1] + 1u, row[j - 1] + cost, over});
+        if (previous && j >= 2 && state.query[j - 2] == byte && state.query[j - 1] == state.path[depth - 1]) {
+            cell = std::min(cell, previous[j - 2] + 1u); // Adjacent transposition
+        }
+        next[j] = static_cast<std::uint8_t>(cell);
+        lowest = std::min(lowest, cell);
+    }
+    if (high < length) next[high + 1] = static_cast<std::uint8_t>(over);
+    return lowest;
+}
+
+// Takes up to need keys of run[first, last) that earlier passes have not.
+void SearchIndex::collect(const Run& run, std::size_t first, std::size_t last, Walk& state) const {
+    for (std::size_t i = first; i < last && state.candidates.size() < state.need; ++i) {
+        const std::uint32_t entry = run[i].entry;
+        const bool seen = std::any_of(state.found->begin(), state.found->end(),
+                                      [entry](const SearchMatch& match) { return match.entry == entry; });
+        if (!seen) state.candidates.push_back(&run[i]);
+    }
+}
+
+// Visits the trie node at depth whose keys are run[first, last). The node's row holds
+// the edits between its path and every prefix of the query; its last cell is the
+// distance of the whole query to the path, which is a prefix of every key below.
+void SearchIndex::walk(const Run& run, std::size_t first, std::size_t last, std::size_t depth, Walk& state) const {
+    const std::size_t length = state.query.size();
+    const std::uint8_t* row = state.row(depth);
+    if (row[length] <= state.budget) {
+        // Every key below matches within the budget. Keys closer than the budget were
+        // all taken by earlier passes, or find would have stopped.
+        if (row[length] == state.budget) collect(run, first, last, state);
+        return;
+    }
+    if (depth == state.maxDepth) return;
+
+    if (last - first <= kScanRange) {
+        // Too few keys to be worth splitting: follow each key's own bytes.
+        for (std::size_t i = first; i < last && !state.done(); ++i) {
+            for (std::size_t d = depth; d < state.maxDepth; ++d) {
+                const unsigned byte = byteAt(run[i], d);
+                if (byte == 0 || advance(d, byte, state) > state.budget) break;
+                const unsigned distance = state.row(d + 1)[length];
+                if (distance <= state.budget) {
+                    if (distance == state.budget) collect(run, i, i + 1, state);
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    auto childEnd = [&](std::size_t begin, unsigned byte) {
+        return gallop(run, begin, last, [&](const Record& record) { return byteAt(record, depth) <= byte; });
+    };
+    const unsigned lowest = *std::min_element(row, row + length + 1);
+    if (lowest == state.budget) {
+        // No edit to spare: the next byte must match the query right after a cell at the
+        // budget, or complete a transposition, so only those children are looked up.
+        unsigned char viable[2 * kMaxKeyLength];
+        std::size_t viableCount = 0;
+        const std::uint8_t* previous = depth > 0 ? state.row(depth - 1) : nullptr;
+        for (std::size_t j = 1; j <= length; ++j) {
+            if (row[j - 1] == state.budget) viable[viableCount++] = state.query[j - 1];
+            if (previous && j >= 2 && previous[j - 2] < state.budget && state.query[j - 1] == state.path[depth - 1]) {
+                viable[viableCount++] = state.query[j - 2];
+            }
+        }
+        std::sort(viable, viable + viableCount);
+        viableCount = static_cast<std::size_t>(std::unique(viable, viable + viableCount) - viable);
+
+        std::size_t begin = first;
+        for (std::size_t v = 0; v < viableCount; ++v) {
+            const unsigned byte = viable[v];
+            begin = gallop(run, begin, last, [&](const Record& record) { return byteAt(record, depth) < byte; });
+            if (begin == last || state.done()) break;
+            if (byteAt(run[begin], depth) != byte) continue;
+            const std::size_t end = childEnd(begin, byte);
+            if (advance(depth, byte, state) <= state.budget) walk(run, begin, end, depth + 1, state);
+            begin = end;
+        }
+        return;
+    }
+
+    std::size_t begin = first;
+    while (begin < last && !state.done()) {
+        const unsigned byte = byteAt(run[begin], depth);
+        const std::size_t end = childEnd(begin, byte);
+        // Keys that end at this depth have no children.
+        if (byte != 0 && advance(depth, byte, state) <= state.budget) walk(run, begin, end, depth + 1, state);
+        begin = end;
+    }
+}
+
+} // namespace banking_system
@@ -0,0 +1,84 @@
+#include "ShardedBalance.hh"
+
+#include <functional>
+#include <thread>
+
+namespace banking_system {
+
+namespace {
+
+constexpr std::size_t kMinShards = 2;
+constexpr std::size_t kMaxShards = 64;
+
+std::size_t shardCountForHardware() {
+    std::size_t count = kMinShards;
+    while (count < std::thread::hardware_concurrency() && count < kMaxShards) {
+        count *= 2;
+    }
+    return count;
+}
+
+} // namespace
+
+ShardedBalance::ShardedBalance(std::int64_t settledCents)
+    : shardCount_(shardCountForHardware()), shards_(new Shard[shardCount_]) {
+    escrowLocked(settledCents);
+}
+
+ShardedBalance::Shard& ShardedBalance::localShard() {
+    static thread_local const std::size_t threadHash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return shards_[threadHash & (shardCount_ - 1)];
+}
+
+bool ShardedBalance::tryCredit(Shard& shard, Money amount) {
+    if (amount.getCents() > shard.headroom) return false;
+    shard.headroom -= amount.getCents();
+    shard.credited.store(shard.credited.load(std::memory_order_relaxed) + amount.getCents(),
+                         std::memory_order_relaxed);
+    return true;
+}
+
+bool ShardedBalance::settle(std::int64_t& settledCents, std::int64_t deltaCents) {
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(shardCount_);
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        locks.emplace_back(shards_[i].mutex);
+    }
+
+    // Escrow guarantees the folded balance is at most Money::max().
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        settledCents += shards_[i].credited.exchange(0, std::memory_order_relaxed);
+    }
+
+    const std::int64_t maximum = Money::max().getCents();
+    const bool accepted = (deltaCents < 0) ? (settledCents >= -deltaCents)
+                                           : (deltaCents <= maximum - settledCents);
+    if (accepted) settledCents += deltaCents;
+    escrowLocked(settledCents);
+    return accepted;
+}
+
+Money ShardedBalance::getPendingCredits() const {
+    std::int64_t pending = 0;
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        pending += shards_[i].credited.load(std::memory_order_relaxed);
+    }
+    return Money::fromCents(pending);
+}
+
+std::size_t ShardedBalance::getShardCount() const {
+    return shardCount_;
+}
+
+ShardedBalance::Shard& ShardedBalance::getShard(std::size_t index) const {
+    return shards_[index];
+}
+
+void ShardedBalance::escrowLocked(std::int64_t settledCents) {
+    const std::int64_t share = (Money::max().getCents() - settledCents) / static_cast<std::int64_t>(shardCount_);
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        shards_[i].headroom = share;
+    }
+}
+
+} // namespace banking_system
@@ -0,0 +1,255 @@
+#include "Snapshot.hh"
+#include "Utils.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace banking_system {
+
+namespace {
+
+constexpr char kMagic[8] = {'M', 'B', 'S', 'N', 'A', 'P', '\0', '\0'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::size_t kAlignment = 64;
+constexpr std::size_t kPreambleSize = sizeof(SnapshotHeader) + SnapshotWriter::kSectionCount * sizeof(SnapshotSection);
+
+std::uint32_t headerCrc(SnapshotHeader header, const SnapshotSection* sections) {
+    header.headerCrc = 0;
+    const std::uint32_t crc = utils::crc32(&header, sizeof(header));
+    return utils::crc32(sections, SnapshotWriter::kSectionCount * sizeof(SnapshotSection), crc);
+}
+
+std::size_t recordSize(SnapshotSectionKind kind) {
+    switch (kind) {
+        case SnapshotSectionKind::CUSTOMERS: return sizeof(SnapshotCustomer);
+        case SnapshotSectionKind::ACCOUNTS: return sizeof(SnapshotAccount);
+        case SnapshotSectionKind::TRANSACTIONS: return sizeof(SnapshotTransaction);
+        case SnapshotSectionKind::NOTES: return 1;
+        case SnapshotSectionKind::STRINGS: return 1;
+    }
+    return 1;
+}
+
+bool syncAndClose(std::FILE* file) {
+    bool ok = std::fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && ::fsync(::fileno(file)) == 0;
+#endif
+    return std::fclose(file) == 0 && ok;
+}
+
+// Replaces target with source atomically, then makes the rename itself durable.
+bool replaceFile(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+    return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (std::rename(source.c_str(), target.c_str()) != 0) return false;
+    const std::size_t slash = target.find_last_of('/');
+    const std::string directory = (slash == std::string::npos) ? "." : target.substr(0, slash + 1);
+    const int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+    return true;
+#endif
+}
+
+} // namespace
+
+// --- SnapshotWriter ---
+SnapshotWriter::SnapshotWriter(const std::string& path) : path_(path), tempPath_(path + ".tmp") {
+    file_ = std::fopen(tempPath_.c_str(), "wb");
+    if (!file_) {
+        throw std::runtime_error("Cannot create snapshot file " + tempPath_ + ": " + std::strerror(errno));
+    }
+    // Large buffered writes; the header and section table are filled in by commit.
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+    const char zeros[kPreambleSize] = {};
+    write(zeros, sizeof(zeros));
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    if (file_) std::fclose(file_);
+    if (!committed_) std::remove(tempPath_.c_str());
+}
+
+void SnapshotWriter::beginSection(SnapshotSectionKind kind) {
+    if (current_ || static_cast<std::uint32_t>(kind) != nextKind_) {
+        throw std::logic_error("Snapshot sections must be written once each, in order.");
+    }
+    padToAlignment();
+    current_ = &sections_[nextKind_++];
+    current_->offset = offset_;
+    current_->kind = static_cast<std::uint32_t>(kind);
+}
+
+void SnapshotWriter::appendRecords(const void* records, std::size_t bytes, std::size_t count) {
+    if (!current_) {
+        throw std::logic_error("Snapshot records appended outside a section.");
+    }
+    write(records, bytes);
+    current_->crc = utils::crc32(records, bytes, current_->crc);
+    current_->bytes += bytes;
+    current_->count += count;
+}
+
+void SnapshotWriter::endSection() {
+    current_ = nullptr;
+}
+
+std::uint64_t SnapshotWriter::addString(std::string_view text) {
+    const std::uint64_t offset = strings_.size();
+    strings_.append(text.data(), text.size());
+    return offset;
+}
+
+void SnapshotWriter::commit(std::uint64_t journalSequence, std::uint64_t nextTransactionId,
+                            std::uint64_t createdAtNanos) {
+    beginSection(SnapshotSectionKind::STRINGS);
+    appendRecords(strings_.data(), strings_.size(), strings_.size());
+    endSection();
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.byteOrderMark = kByteOrderMark;
+    header.journalSequence = journalSequence;
+    header.nextTransactionId = nextTransactionId;
+    header.createdAtNanos = createdAtNanos;
+    header.sectionCount = kSectionCount;
+    header.headerCrc = headerCrc(header, sections_);
+
+    if (std::fseek(file_, 0, SEEK_SET) != 0 ||
+        std::fwrite(&header, sizeof(header), 1, file_) != 1 ||
+        std::fwrite(sections_, sizeof(sections_), 1, file_) != 1) {
+        throw std::runtime_error("Cannot write snapshot header to " + tempPath_ + ".");
+    }
+    std::FILE* file = file_;
+    file_ = nullptr;
+    if (!syncAndClose(file)) {
+        throw std::runtime_error("Cannot flush snapshot file " + tempPath_ + ".");
+    }
+    if (!replaceFile(tempPath_, path_)) {
+        throw std::runtime_error("Cannot move snapshot into place at " + path_ + ".");
+    }
+    committed_ = true;
+}
+
+void SnapshotWriter::write(const void* data, std::size_t bytes) {
+    if (bytes != 0 && std::fwrite(data, 1, bytes, file_) != bytes) {
+        throw std::runtime_error("Cannot write snapshot file " + tempPath_ + ": " + std::strerror(errno));
+    }
+    offset_ += bytes;
+}
+
+void SnapshotWriter::padToAlignment() {
+    static const char zeros[kAlignment] = {};
+    const std::size_t remainder = static_cast<std::size_t>(offset_ % kAlignment);
+    if (remainder != 0) write(zeros, kAlignment - remainder);
+}
+
+// --- SnapshotReader ---
+SnapshotReader::SnapshotReader(const std::string& path) : file_(path) {
+    if (file_.size() < kPreambleSize) {
+        throw std::runtime_error("Snapshot " + path + " is truncated.");
+    }
+    file_.prefetch();
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+    std::memcpy(sections_, file_.data() + sizeof(header_), sizeof(sections_));
+
+    if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("File " + path + " is not a MiniBank snapshot.");
+    }
+    if (header_.version != SnapshotWriter::kFormatVersion || header_.byteOrderMark != kByteOrderMark ||
+        header_.sectionCount != SnapshotWriter::kSectionCount) {
+        throw std::runtime_error("Snapshot " + path + " was written in an unsupported format.");
+    }
+    if (headerCrc(header_, sections_) != header_.headerCrc) {
+        throw std::runtime_error("Snapshot " + path + " has a corrupt header.");
+    }
+    for (std::uint32_t i = 0; i < SnapshotWriter::kSectionCount; ++i) {
+        const SnapshotSection& section = sections_[i];
+        const auto kind = static_cast<SnapshotSectionKind>(i);
+        if (section.kind != i || section.offset % kAlignment != 0 || section.offset > file_.size() ||
+            section.bytes > file_.size() - section.offset || section.bytes != section.count * recordSize(kind)) {
+            throw std::runtime_error("Snapshot " + path + " has an invalid section table.");
+        }
+    }
+
+    // Checksums are the only per-byte work on load, so run them side by side.
+    std::vector<std::future<bool>> checks;
+    for (std::uint32_t i = 0; i < SnapshotWriter::kSectionCount; ++i) {
+        checks.push_back(std::async(std::launch::async, [this, i] {
+            const SnapshotSection& section = sections_[i];
+            return utils::crc32(file_.data() + section.offset, static_cast<std::size_t>(section.bytes)) == section.crc;
+        }));
+    }
+    bool intact = true;
+    for (auto& check : checks) intact = check.get() && intact;
+    if (!intact) {
+        throw std::runtime_error("Snapshot " + path + " failed checksum validation.");
+    }
+}
+
+const SnapshotHeader& SnapshotReader::getHeader() const { return header_; }
+
+const SnapshotCustomer* SnapshotReader::getCustomers() const {
+    return reinterpret_cast<const SnapshotCustomer*>(sectionData(SnapshotSectionKind::CUSTOMERS));
+}
+
+std::size_t SnapshotReader::getCustomerCount() const { return sectionCount(SnapshotSectionKind::CUSTOMERS); }
+
+const SnapshotAccount* SnapshotReader::getAccounts() const {
+    return reinterpret_cast<const SnapshotAccount*>(sectionData(SnapshotSectionKind::ACCOUNTS));
+}
+
+std::size_t SnapshotReader::getAccountCount() const { return sectionCount(SnapshotSectionKind::ACCOUNTS); }
+
+const SnapshotTransaction* SnapshotReader::getTransactions() const {
+    return reinterpret_cast<const SnapshotTransaction*>(sectionData(SnapshotSectionKind::TRANSACTIONS));
+}
+
+std::size_t SnapshotReader::getTransactionCount() const { return sectionCount(SnapshotSectionKind::TRANSACTIONS); }
+
+std::string_view SnapshotReader::getString(std::uint64_t offset, std::uint32_t length) const {
+    const SnapshotSection& strings = sections_[static_cast<std::uint32_t>(SnapshotSectionKind::STRINGS)];
+    if (offset > strings.bytes || length > strings.bytes - offset) {
+        throw std::runtime_error("Snapshot " + file_.getPath() + " references text out of bounds.");
+    }
+    return std::string_view(reinterpret_cast<const char*>(file_.data() + strings.offset + offset), length);
+}
+
+std::string_view SnapshotReader::getNoteImage() const {
+    return std::string_view(reinterpret_cast<const char*>(sectionData(SnapshotSectionKind::NOTES)),
+                            sectionCount(SnapshotSectionKind::NOTES));
+}
+
+const unsigned char* SnapshotReader::sectionData(SnapshotSectionKind kind) const {
+    return file_.data() + sections_[static_cast<std::uint32_t>(kind)].offset;
+}
+
+std::size_t SnapshotReader::sectionCount(SnapshotSectionKind kind) const {
+    return static_cast<std::size_t>(sections_[static_cast<std::uint32_t>(kind)].count);
+}
+
+} // namespace banking_system
@@ -1,53 +1,81 @@
 #include "Transaction.hh"
-#include <sstream>   
-#include <iomanip>   
-#include <stdexcept> 
+#include "ReportWriter.hh"
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
 
 namespace banking_system {
 
 // Constructor implementation
-Transaction::Transaction(const std::string& transactionId,
+Transaction::Transaction(std::uint64_t number,
                          TransactionType type,
-                         double amount,
-                         const std::string& sourceAccountId,
-                         const std::string& destinationAccountId,
-                         const std::string& note)
-    : transactionId_(transactionId),
-      type_(type),
+                         Money amount,
+                         AccountId sourceAccountId,
+                         AccountId destinationAccountId,
+                         NoteArena::Note note)
+    : Transaction(number, type, amount, sourceAccountId, destinationAccountId, note,
+                  std::chrono::system_clock::now()) { // Record current time as timestamp
+}
+
+Transaction::Transaction(std::uint64_t number,
+                         TransactionType type,
+                         Money amount,
+                         AccountId sourceAccountId,
+                         AccountId destinationAccountId,
+                         NoteArena::Note note,
+                         std::chrono::system_clock::time_point timestamp)
+    : number_(number),
       amount_(amount),
       sourceAccountId_(sourceAccountId),
       destinationAccountId_(destinationAccountId),
+      timestamp_(timestamp),
       note_(note),
-      timestamp_(std::chrono::system_clock::now()) { // Record current time as timestamp
-    if (transactionId.empty()) {
+      type_(type) {
+    if (number == 0) {
         throw std::invalid_argument("Transaction ID cannot be empty.");
     }
-    if (amount <= 0.0) {
+    if (!amount.isPositive()) {
         throw std::invalid_argument("Transaction amount must be positive.");
     }
     if (type == TransactionType::TRANSFER_OUT || type == TransactionType::TRANSFER_IN) {
-        if (sourceAccountId.empty() || destinationAccountId.empty()) {
+        if (!sourceAccountId.isValid() || !destinationAccountId.isValid()) {
             throw std::invalid_argument("Transfer transactions must have source and destination account IDs.");
         }
-    } else if (type == TransactionType::DEPOSIT && destinationAccountId.empty()) {
+    } else if (type == TransactionType::DEPOSIT && !destinationAccountId.isValid()) {
          throw std::invalid_argument("Deposit transactions must have a destination account ID.");
-    } else if (type == TransactionType::WITHDRAWAL && sourceAccountId.empty()) {
+    } else if (type == TransactionType::INTEREST && !destinationAccountId.isValid()) {
+         throw std::invalid_argument("Interest transactions must have a destination account ID.");
+    } else if (type == TransactionType::WITHDRAWAL && !sourceAccountId.isValid()) {
          throw std::invalid_argument("Withdrawal transactions must have a source account ID.");
+    } else if (type > TransactionType::INTEREST) {
+         throw std::invalid_argument("Unknown transaction type.");
     }
 }
 
 // --- Getters ---
-const std::string& Transaction::getTransactionId() const { return transactionId_; }
-TransactionType Transaction::getType() const { return type_; }
-double Transaction::getAmount() const { return amount_; }
-const std::string& Transaction::getSourceAccountId() const { return sourceAccountId_; }
-const std::string& Transaction::getDestinationAccountId() const { return destinationAccountId_; }
-const std::string& Transaction::getNote() const { return note_; }
+std::string Transaction::getTransactionId() const {
+    char text[kMaxIdLength];
+    return std::string(text, formatTransactionId(text));
+}
+
+std::size_t Transaction::formatTransactionId(char* out) const {
+    out[0] = 'T';
+    return static_cast<std::size_t>(std::to_chars(out + 1, out + kMaxIdLength, number_).ptr - out);
+}
 
 std::time_t Transaction::getTimestamp() const {
     return std::chrono::system_clock::to_time_t(timestamp_);
 }
 
+std::optional<std::uint64_t> parseTransactionId(std::string_view transactionId) {
+    if (transactionId.size() < 2 || transactionId[0] != 'T') return std::nullopt;
+    std::uint64_t number = 0;
+    const char* last = transactionId.data() + transactionId.size();
+    const auto result = std::from_chars(transactionId.data() + 1, last, number);
+    if (result.ec != std::errc() || result.ptr != last || number == 0) return std::nullopt;
+    return number;
+}
+
 // Helper function to convert TransactionType to string
 std::string transactionTypeToString(TransactionType type) {
     switch (type) {
@@ -55,43 +83,17 @@ std::string transactionTypeToString(TransactionType type) {
         case TransactionType::WITHDRAWAL: return "Withdrawal";
         case TransactionType::TRANSFER_OUT: return "Transfer Out";
         case TransactionType::TRANSFER_IN: return "Transfer In";
+        case TransactionType::INTEREST: return "Interest";
         default: return "Unknown";
     }
 }
 
-// Helper function to format timestamp
-std::string formatTimestamp(const std::chrono::system_clock::time_point& tp) {
-    std::time_t time = std::chrono::system_clock::to_time_t(tp);
-    std::tm local_tm;
-    #ifdef _WIN32
-        localtime_s(&local_tm, &time); // Thread-safe on Windows
-    #else
-        localtime_r(&time, &local_tm); // Thread-safe on POSIX
-    #endif
-    std::stringstream ss;
-    ss << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S");
-    return ss.str();
-}
-
-// toString method to format transaction details
-std::string Transaction::toString() const {
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(2);
-    ss << "Time: " << formatTimestamp(timestamp_) << " | "
-       << "ID: " << transactionId_ << " | "
-       << "Type: " << transactionTypeToString(type_) << " | "
-       << "Amount: $" << amount_;
-
-    if (!sourceAccountId_.empty()) {
-        ss << " | Source: " << sourceAccountId_;
-    }
-    if (!destinationAccountId_.empty()) {
-        ss << " | Destination: " << destinationAccountId_;
-    }
-    if (!note_.empty()) {
-        ss << " | Note: " << note_;
-    }
-    return ss.str();
+// toString method to format transaction details, in the same form as report lines
+std::string Transaction::toString(const NoteArena& notes) const {
+    std::string text(TransactionFormatter::maxLength(*this), '\0');
+    TransactionFormatter formatter(notes);
+    text.resize(formatter.format(*this, &text[0]));
+    return text;
 }
 
 } // namespace banking_system
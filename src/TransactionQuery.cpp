@@ -0,0 +1,204 @@
+#include "TransactionQuery.hh"
+
+#include <algorithm>
+
+namespace banking_system {
+
+// --- TransactionQuery ---
+TransactionQuery TransactionQuery::all() {
+    return TransactionQuery();
+}
+
+TransactionQuery TransactionQuery::forCustomer(const std::string& customerName) {
+    TransactionQuery query;
+    query.scope = Scope::CUSTOMER;
+    query.customerName = customerName;
+    return query;
+}
+
+TransactionQuery TransactionQuery::forAccount(AccountId accountId) {
+    TransactionQuery query;
+    query.scope = Scope::ACCOUNT;
+    query.accountId = accountId;
+    return query;
+}
+
+TransactionQuery& TransactionQuery::between(std::chrono::system_clock::time_point rangeFrom,
+                                            std::chrono::system_clock::time_point rangeTo) {
+    from = rangeFrom;
+    to = rangeTo;
+    return *this;
+}
+
+TransactionQuery& TransactionQuery::positions(std::size_t first, std::size_t last) {
+    firstPosition = first;
+    lastPosition = last;
+    return *this;
+}
+
+TransactionQuery& TransactionQuery::newestFirst() {
+    order = QueryOrder::NEWEST_FIRST;
+    return *this;
+}
+
+TransactionQuery& TransactionQuery::page(std::size_t pageOffset, std::size_t pageLimit) {
+    offset = pageOffset;
+    limit = pageLimit;
+    return *this;
+}
+
+// --- TransactionCursor ---
+std::size_t TransactionCursor::next(const Transaction** out, std::size_t capacity) {
+    if (remaining_ == 0 || streamCount_ == 0) return 0;
+    if (streamCount_ == 1) {
+        const std::size_t count = readSingle(streams()[0], out, std::min(capacity, remaining_));
+        remaining_ -= count;
+        return count;
+    }
+    std::size_t count = 0;
+    std::size_t position = 0;
+    while (count < capacity && remaining_ > 0 && nextPosition(position)) {
+        out[count++] = &(*ledger_)[position];
+        --remaining_;
+    }
+    return count;
+}
+
+bool TransactionCursor::atEnd() const {
+    if (remaining_ == 0) return true;
+    const Stream* all = streams();
+    return std::all_of(all, all + streamCount_, exhausted);
+}
+
+std::size_t TransactionCursor::remainingUpperBound() const {
+    std::size_t total = 0;
+    const Stream* all = streams();
+    for (std::size_t i = 0; i < streamCount_; ++i) {
+        total += (all[i].end - all[i].begin) + (all[i].bufferEnd - all[i].bufferNext);
+    }
+    return std::min(total, remaining_);
+}
+
+void TransactionCursor::addStream(const Stream& stream) {
+    if (stream.begin >= stream.end) return;
+    if (streamCount_ < kInlineStreams) {
+        inlineStreams_[streamCount_++] = stream;
+        return;
+    }
+    if (streamCount_ == kInlineStreams) {
+        moreStreams_.assign(inlineStreams_.begin(), inlineStreams_.end());
+    }
+    moreStreams_.push_back(stream);
+    ++streamCount_;
+}
+
+TransactionCursor::Stream* TransactionCursor::streams() {
+    return streamCount_ <= kInlineStreams ? inlineStreams_.data() : moreStreams_.data();
+}
+
+const TransactionCursor::Stream* TransactionCursor::streams() const {
+    return streamCount_ <= kInlineStreams ? inlineStreams_.data() : moreStreams_.data();
+}
+
+// One stream: a whole page is read under a single acquisition of the list's lock.
+std::size_t TransactionCursor::readSingle(Stream& stream, const Transaction** out, std::size_t capacity) {
+    const std::size_t count = std::min(capacity, stream.end - stream.begin);
+    const bool forward = order_ == QueryOrder::OLDEST_FIRST;
+    std::unique_lock<std::mutex> lock;
+    if (stream.mutex) lock = std::unique_lock<std::mutex>(*stream.mutex);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t index = forward ? stream.begin + i : stream.end - 1 - i;
+        const std::size_t position = stream.positions ? (*stream.positions)[index] : index;
+        out[i] = &(*ledger_)[position];
+    }
+    if (forward) {
+        stream.begin += count;
+    } else {
+        stream.end -= count;
+    }
+    return count;
+}
+
+bool TransactionCursor::exhausted(const Stream& stream) {
+    return stream.bufferNext == stream.bufferEnd && stream.begin >= stream.end;
+}
+
+// Refills an empty merge buffer from the read end of a posting list, under one
+// acquisition of its lock. Returns false if the stream is exhausted.
+bool TransactionCursor::fillBuffer(Stream& stream) {
+    if (stream.bufferNext < stream.bufferEnd) return true;
+    if (stream.begin >= stream.end) return false;
+    const std::size_t count = std::min(kPositionsPerLock, stream.end - stream.begin);
+    {
+        std::lock_guard<std::mutex> lock(*stream.mutex);
+        const std::size_t* positions = stream.positions->data();
+        if (order_ == QueryOrder::OLDEST_FIRST) {
+            std::copy(positions + stream.begin, positions + stream.begin + count, stream.buffer.begin());
+        } else {
+            std::reverse_copy(positions + stream.end - count, positions + stream.end, stream.buffer.begin());
+        }
+    }
+    if (order_ == QueryOrder::OLDEST_FIRST) {
+        stream.begin += count;
+    } else {
+        stream.end -= count;
+    }
+    stream.bufferNext = 0;
+    stream.bufferEnd = count;
+    return true;
+}
+
+// Merge step: the next position in order across all streams. Streams whose head is
+// that position all advance, which drops records posted to two of them.
+bool TransactionCursor::nextPosition(std::size_t& position) {
+    const bool forward = order_ == QueryOrder::OLDEST_FIRST;
+    Stream* all = streams();
+    bool found = false;
+    std::size_t best = 0;
+    for (std::size_t i = 0; i < streamCount_; ++i) {
+        Stream& stream = all[i];
+        if (stream.positions) {
+            if (!fillBuffer(stream)) continue;
+            stream.head = stream.buffer[stream.bufferNext];
+        } else {
+            if (stream.begin >= stream.end) continue;
+            stream.head = forward ? stream.begin : stream.end - 1;
+        }
+        if (!found || (forward ? stream.head < best : stream.head > best)) {
+            best = stream.head;
+            found = true;
+        }
+    }
+    if (!found) return false;
+
+    for (std::size_t i = 0; i < streamCount_; ++i) {
+        Stream& stream = all[i];
+        if (exhausted(stream) || stream.head != best) continue;
+        if (stream.positions) {
+            ++stream.bufferNext;
+        } else if (forward) {
+            ++stream.begin;
+        } else {
+            --stream.end;
+        }
+    }
+    position = best;
+    return true;
+}
+
+void TransactionCursor::skip(std::size_t count) {
+    if (streamCount_ == 1) {
+        Stream& stream = streams()[0];
+        const std::size_t skipped = std::min(count, stream.end - stream.begin);
+        if (order_ == QueryOrder::OLDEST_FIRST) {
+            stream.begin += skipped;
+        } else {
+            stream.end -= skipped;
+        }
+        return;
+    }
+    std::size_t position = 0;
+    while (count > 0 && nextPosition(position)) --count;
+}
+
+} // namespace banking_system
@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <stdexcept>
 #include <algorithm> // For std::max
+#include <optional>
 
 // Note: RAYGUI_IMPLEMENTATION is defined in main.cpp
 
@@ -32,7 +33,7 @@ UIManager::UIManager(Bank& bank)
       amountEditMode_(false),
       destinationAccountEditMode_(false),
       noteEditMode_(false),
-      transactionAmount_(0.0f),
+      transactionAmount_(Money::zero()),
       listViewScrollIndex_(0),
       listViewActive_(-1),
       messageReturnState_(ScreenState::MAIN_MENU) {
@@ -94,17 +95,33 @@ void UIManager::changeState(ScreenState newState) {
      if (newState == ScreenState::MAIN_MENU) {
         currentCustomerName_ = "";
         currentCustomer_ = nullptr;
-        currentAccountId_ = "";
+        currentAccountId_ = AccountId();
         currentAccount_ = nullptr;
     } else if (newState == ScreenState::ACCESS_CUSTOMER_SEARCH) {
          currentCustomerName_ = "";
          currentCustomer_ = nullptr;
-         currentAccountId_ = "";
+         currentAccountId_ = AccountId();
          currentAccount_ = nullptr;
      } else if (newState == ScreenState::CUSTOMER_VIEW) {
-         currentAccountId_ = "";
+         currentAccountId_ = AccountId();
          currentAccount_ = nullptr;
      }
+
+    // The history screens read from a view model that is filled while they are shown.
+    if (newState == ScreenState::VIEW_CUSTOMER_TRANSACTIONS && currentCustomer_) {
+        historyTitle_ = "Transaction History for Customer [" + currentCustomerName_ + "]";
+        historyView_.open(bank_, TransactionQuery::forCustomer(currentCustomerName_));
+    } else if (newState == ScreenState::VIEW_ACCOUNT_TRANSACTIONS && currentAccount_) {
+        historyTitle_ = "Transaction History for Account [" + currentAccountId_.toString() + "]";
+        historyView_.open(bank_, TransactionQuery::forAccount(currentAccountId_));
+    } else {
+        historyView_.close();
+    }
+    if (newState == ScreenState::VIEW_ALL_ACCOUNTS) {
+        accountTable_.open(bank_);
+    } else {
+        accountTable_.close();
+    }
 }
 
 //message window
@@ -115,6 +132,52 @@ void UIManager::showMessage(const std::string& title, const std::string& text, S
     changeState(ScreenState::SHOW_MESSAGE);
 }
 
+// Looks suggestions up again if text changed since the last lookup.
+void UIManager::refreshSuggestions(const char* text, bool accounts) {
+    if (suggestionsText_ == text) return;
+    suggestionsText_ = text;
+    suggestions_ = accounts ? bank_.suggestAccounts(suggestionsText_, kSuggestionLimit)
+                            : bank_.suggestCustomers(suggestionsText_, kSuggestionLimit);
+}
+
+Rectangle UIManager::suggestionBounds(Rectangle inputBounds) const {
+    float itemHeight = (float)GuiGetStyle(DEFAULT, TEXT_SIZE) + 14;
+    return {inputBounds.x, inputBounds.y + inputBounds.height + 2, inputBounds.width, itemHeight * suggestions_.size()};
+}
+
+// Lists suggestions_ in bounds, over whatever is drawn there, and returns the index of
+// the one clicked, or -1. Matches that needed a typo are greyed.
+int UIManager::drawSuggestions(Rectangle bounds) {
+    Font currentFont = GuiGetFont();
+    int baseFontSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
+    float textSpacing = 1.0f;
+    float itemHeight = bounds.height / suggestions_.size();
+    Vector2 mouse = GetMousePosition();
+    char text[AccountId::kTextLength + 1];
+    int picked = -1;
+
+    DrawRectangleRec(bounds, RAYWHITE);
+    for (std::size_t i = 0; i < suggestions_.size(); ++i) {
+        const SearchSuggestion& suggestion = suggestions_[i];
+        Rectangle item = {bounds.x, bounds.y + i * itemHeight, bounds.width, itemHeight};
+        bool hovered = CheckCollisionPointRec(mouse, item);
+        if (hovered) DrawRectangleRec(item, LIGHTGRAY);
+        Color color = suggestion.edits == 0 ? BLACK : DARKGRAY;
+        Vector2 position = {item.x + 10, item.y + 7};
+        if (suggestion.accountId.isValid()) {
+            suggestion.accountId.format(text);
+            text[AccountId::kTextLength] = '\0';
+            DrawTextEx(currentFont, text, position, (float)baseFontSize, textSpacing, color);
+            position.x += MeasureTextEx(currentFont, text, (float)baseFontSize, textSpacing).x + 20;
+            color = GRAY;
+        }
+        DrawTextEx(currentFont, suggestion.customerName.c_str(), position, (float)baseFontSize, textSpacing, color);
+        if (hovered && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) picked = (int)i;
+    }
+    DrawRectangleLinesEx(bounds, 1, GRAY);
+    return picked;
+}
+
 //
 void UIManager::clearInputBuffers() {
     customerNameInput_[0] = '\0';
@@ -127,7 +190,9 @@ void UIManager::clearInputBuffers() {
     amountEditMode_ = false;
     destinationAccountEditMode_ = false;
     noteEditMode_ = false;
-    transactionAmount_ = 0.0f;
+    transactionAmount_ = Money::zero();
+    suggestions_.clear();
+    suggestionsText_.clear();
 }
 
     ///define the return button
@@ -287,11 +352,16 @@ void UIManager::drawAccessCustomerSearch() {
     float startX = (float)screenWidth_/2 - totalWidth/2;
     float startY = 250;
 
+    // Suggestions are listed while the name is typed, over the buttons, which ignore the
+    // mouse while it is on the list.
+    bool showSuggestions = searchCustomerNameEditMode_ && !suggestions_.empty();
+    Rectangle inputBounds = {startX + labelWidth + 15, startY, inputWidth, inputHeight};
     GuiLabel((Rectangle){startX, startY + 9, labelWidth, inputHeight}, labelText);
-    if (GuiTextBox((Rectangle){startX + labelWidth + 15, startY, inputWidth, inputHeight},
-                   searchCustomerNameInput_, sizeof(searchCustomerNameInput_), searchCustomerNameEditMode_)) {
+    if (GuiTextBox(inputBounds, searchCustomerNameInput_, sizeof(searchCustomerNameInput_), searchCustomerNameEditMode_)) {
         searchCustomerNameEditMode_ = !searchCustomerNameEditMode_;
     }
+    Rectangle listBounds = suggestionBounds(inputBounds);
+    bool overList = showSuggestions && CheckCollisionPointRec(GetMousePosition(), listBounds);
 
     float buttonY = startY + inputHeight + 50;
     float buttonWidth = 160;
@@ -301,6 +371,7 @@ void UIManager::drawAccessCustomerSearch() {
     float totalButtonWidth = buttonWidth + buttonSpacing + returnButtonWidth;
     float buttonStartX = (float)screenWidth_/2 - totalButtonWidth/2;
 
+    if (overList) GuiLock();
     if (GuiButton((Rectangle){buttonStartX, buttonY, buttonWidth, buttonHeight}, "Search")) {
         std::string name = searchCustomerNameInput_;
         if (!name.empty()) {
@@ -321,6 +392,17 @@ void UIManager::drawAccessCustomerSearch() {
     if (GuiButton((Rectangle){buttonStartX + buttonWidth + buttonSpacing, buttonY, returnButtonWidth, buttonHeight}, "Return to Main Menu")) {
         changeState(ScreenState::MAIN_MENU);
     }
+    if (overList) GuiUnlock();
+
+    if (currentState_ != ScreenState::ACCESS_CUSTOMER_SEARCH) return;
+    if (showSuggestions) {
+        int picked = drawSuggestions(listBounds);
+        if (picked >= 0) {
+            std::snprintf(searchCustomerNameInput_, sizeof(searchCustomerNameInput_), "%s", suggestions_[picked].customerName.c_str());
+            searchCustomerNameEditMode_ = false;
+        }
+    }
+    refreshSuggestions(searchCustomerNameInput_, false);
 }
 
 //customer view(after succed find the cutomer number)
@@ -336,6 +418,11 @@ void UIManager::drawCustomerView() {
     DrawTextEx(currentFont, title.c_str(), {(float)screenWidth_/2 - MeasureTextEx(currentFont, title.c_str(), (float)baseFontSize + 8, textSpacing).x/2, 60}, (float)baseFontSize + 8, textSpacing, DARKGRAY);
     DrawTextEx(currentFont, "This customer has the following accounts:", {80, 120}, (float)baseFontSize + 2, textSpacing, GRAY);
 
+    std::stringstream ssSummary;
+    ssSummary << "Total: $" << currentCustomer_->getTotalBalance()
+              << " | Transactions: " << currentCustomer_->getTransactionCount();
+    DrawTextEx(currentFont, ssSummary.str().c_str(), {850, 120}, (float)baseFontSize + 2, textSpacing, DARKBLUE);
+
     std::vector<Account*> accounts = bank_.getCustomerAccounts(currentCustomerName_);
     float startY = 170;
     float lineHeight = (float)baseFontSize + 11;
@@ -352,9 +439,9 @@ void UIManager::drawCustomerView() {
         float currentY = startY + i * itemHeight;
         std::string accTypeStr = (acc->getType() == AccountType::SAVINGS) ? "Savings Account" : "Checking Account";
         std::stringstream ss;
-        ss << std::fixed << std::setprecision(2) << acc->getBalance();
+        ss << acc->getBalance();
         std::string balanceStr = "Balance: $" + ss.str();
-        std::string accInfo = std::to_string(i + 1) + ". " + accTypeStr + ": " + acc->getAccountId();
+        std::string accInfo = std::to_string(i + 1) + ". " + accTypeStr + ": " + acc->getAccountId().toString();
 
         DrawTextEx(currentFont, accInfo.c_str(), {accountInfoX, currentY + (itemHeight - lineHeight)/2 + 5}, (float)baseFontSize + 2, textSpacing, BLACK);
         DrawTextEx(currentFont, balanceStr.c_str(), {balanceX, currentY + (itemHeight - lineHeight)/2 + 5}, (float)baseFontSize + 2, textSpacing, DARKGREEN);
@@ -399,13 +486,13 @@ void UIManager::drawAccountViewShared(const std::string& titlePrefix) {
     Font currentFont = GuiGetFont();
     int baseFontSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
     float textSpacing = 1.0f;
-    std::string title = titlePrefix + currentAccount_->getAccountId();
+    std::string title = titlePrefix + currentAccount_->getAccountId().toString();
     DrawTextEx(currentFont, title.c_str(), {(float)screenWidth_/2 - MeasureTextEx(currentFont, title.c_str(), (float)baseFontSize + 8, textSpacing).x/2, 60}, (float)baseFontSize + 8, textSpacing, DARKGRAY);
 
     float infoY = 120;
     DrawTextEx(currentFont, ("Account Holder: " + currentAccount_->getOwnerName()).c_str(), {80, infoY}, (float)baseFontSize + 2, textSpacing, GRAY);
     std::stringstream ss;
-    ss << std::fixed << std::setprecision(2) << currentAccount_->getBalance();
+    ss << currentAccount_->getBalance();
     std::string balanceStr = "Current Balance: $" + ss.str();
     DrawTextEx(currentFont, balanceStr.c_str(), {80, infoY + 35}, (float)baseFontSize + 6, textSpacing, DARKGREEN);
 }
@@ -433,7 +520,7 @@ void UIManager::drawAccountViewSavings() {
     }
      buttonIndex++;
     if (GuiButton((Rectangle){startX, startY + buttonIndex*(buttonHeight + spacing), buttonWidth, buttonHeight}, "Generate Account Report")) {
-         std::string filename = "transactions_" + currentAccountId_ + "_" + utils::getCurrentDateString() + ".txt";
+         std::string filename = "transactions_" + currentAccountId_.toString() + "_" + utils::getCurrentDateString() + ".txt";
          if (bank_.generateAccountReport(currentAccountId_, filename)) {
              showMessage("Report Generated", "Account transaction report saved as:\n" + filename, ScreenState::ACCOUNT_VIEW_SAVINGS);
          } else {
@@ -477,7 +564,7 @@ void UIManager::drawAccountViewChecking() {
     }
      buttonIndex++;
     if (GuiButton((Rectangle){startX, startY + buttonIndex*(buttonHeight + spacing), buttonWidth, buttonHeight}, "5. Generate Account Report")) {
-        std::string filename = "transactions_" + currentAccountId_ + "_" + utils::getCurrentDateString() + ".txt";
+        std::string filename = "transactions_" + currentAccountId_.toString() + "_" + utils::getCurrentDateString() + ".txt";
          if (bank_.generateAccountReport(currentAccountId_, filename)) {
              showMessage("Report Generated", "Account transaction report saved as:\n" + filename, ScreenState::ACCOUNT_VIEW_CHECKING);
          } else {
@@ -499,11 +586,11 @@ void UIManager::drawDepositView() {
     Font currentFont = GuiGetFont();
     int baseFontSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
     float textSpacing = 1.0f;
-    std::string title = "Deposit to Account: " + currentAccountId_;
+    std::string title = "Deposit to Account: " + currentAccountId_.toString();
     DrawTextEx(currentFont, title.c_str(), {(float)screenWidth_/2 - MeasureTextEx(currentFont, title.c_str(), (float)baseFontSize + 8, textSpacing).x/2, 60}, (float)baseFontSize + 8, textSpacing, DARKGRAY);
 
     std::stringstream ss;
-    ss << std::fixed << std::setprecision(2) << currentAccount_->getBalance();
+    ss << currentAccount_->getBalance();
     std::string balanceStr = "Current Balance: $" + ss.str();
     DrawTextEx(currentFont, balanceStr.c_str(), {80, 130}, (float)baseFontSize + 4, textSpacing, DARKGREEN);
 
@@ -544,8 +631,10 @@ void UIManager::drawDepositView() {
 
      if (GuiButton((Rectangle){buttonStartX, buttonY, buttonWidth, buttonHeight}, "Confirm Deposit")) {
         try {
-            transactionAmount_ = std::stof(amountInput_);
-             if (transactionAmount_ <= 0) throw std::invalid_argument("Amount must be positive");
+            std::optional<Money> parsedAmount = Money::parse(amountInput_);
+            if (!parsedAmount) throw std::invalid_argument("Amount must be a decimal number");
+            transactionAmount_ = *parsedAmount;
+            if (!transactionAmount_.isPositive()) throw std::invalid_argument("Amount must be positive");
              std::string note = noteInput_;
              auto result = bank_.performDeposit(currentAccountId_, transactionAmount_, note);
              if (result) {
@@ -553,7 +642,7 @@ void UIManager::drawDepositView() {
                  successMsg << "Deposit successful!\n";
                  Account* updatedAccount = bank_.findAccount(currentAccountId_);
                  if(updatedAccount) {
-                    successMsg << "New balance: $" << std::fixed << std::setprecision(2) << updatedAccount->getBalance() << "\n";
+                    successMsg << "New balance: $" << updatedAccount->getBalance() << "\n";
                  } else {
                      successMsg << "(Could not fetch new balance)\n";
                  }
@@ -584,11 +673,11 @@ void UIManager::drawWithdrawView() {
     Font currentFont = GuiGetFont();
     int baseFontSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
     float textSpacing = 1.0f;
-    std::string title = "Withdraw from Account: " + currentAccountId_;
+    std::string title = "Withdraw from Account: " + currentAccountId_.toString();
     DrawTextEx(currentFont, title.c_str(), {(float)screenWidth_/2 - MeasureTextEx(currentFont, title.c_str(), (float)baseFontSize + 8, textSpacing).x/2, 60}, (float)baseFontSize + 8, textSpacing, DARKGRAY);
 
     std::stringstream ss;
-    ss << std::fixed << std::setprecision(2) << currentAccount_->getBalance();
+    ss << currentAccount_->getBalance();
     std::string balanceStr = "Current Balance: $" + ss.str();
     DrawTextEx(currentFont, balanceStr.c_str(), {80, 130}, (float)baseFontSize + 4, textSpacing, DARKGREEN);
 
@@ -629,8 +718,10 @@ void UIManager::drawWithdrawView() {
 
      if (GuiButton((Rectangle){buttonStartX, buttonY, buttonWidth, buttonHeight}, "Confirm Withdrawal")) {
         try {
-            transactionAmount_ = std::stof(amountInput_);
-            if (transactionAmount_ <= 0) throw std::invalid_argument("Amount must be positive");
+            std::optional<Money> parsedAmount = Money::parse(amountInput_);
+            if (!parsedAmount) throw std::invalid_argument("Amount must be a decimal number");
+            transactionAmount_ = *parsedAmount;
+            if (!transactionAmount_.isPositive()) throw std::invalid_argument("Amount must be positive");
             std::string note = noteInput_;
             auto result = bank_.performWithdraw(currentAccountId_, transactionAmount_, note);
             if (result) {
@@ -638,7 +729,7 @@ void UIManager::drawWithdrawView() {
                 successMsg << "Withdrawal successful!\n";
                  Account* updatedAccount = bank_.findAccount(currentAccountId_);
                  if(updatedAccount) {
-                    successMsg << "New balance: $" << std::fixed << std::setprecision(2) << updatedAccount->getBalance() << "\n";
+                    successMsg << "New balance: $" << updatedAccount->getBalance() << "\n";
                  } else {
                      successMsg << "(Could not fetch new balance)\n";
                  }
@@ -668,11 +759,11 @@ void UIManager::drawTransferView() {
     Font currentFont = GuiGetFont();
     int baseFontSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
     float textSpacing = 1.0f;
-    std::string title = "Transfer from Account: " + currentAccountId_;
+    std::string title = "Transfer from Account: " + currentAccountId_.toString();
     DrawTextEx(currentFont, title.c_str(), {(float)screenWidth_/2 - MeasureTextEx(currentFont, title.c_str(), (float)baseFontSize + 8, textSpacing).x/2, 60}, (float)baseFontSize + 8, textSpacing, DARKGRAY);
 
     std::stringstream ss;
-    ss << std::fixed << std::setprecision(2) << currentAccount_->getBalance();
+    ss << currentAccount_->getBalance();
     std::string balanceStr = "Current Balance: $" + ss.str();
     DrawTextEx(currentFont, balanceStr.c_str(), {80, 130}, (float)baseFontSize + 4, textSpacing, DARKGREEN);
 
@@ -692,11 +783,17 @@ void UIManager::drawTransferView() {
     float startY = 220;
     float spacing = 20;
 
+    // Suggestions are listed while the destination is typed, over the fields below,
+    // which ignore the mouse while it is on the list.
+    bool showSuggestions = destinationAccountEditMode_ && !suggestions_.empty();
+    Rectangle destinationBounds = {startX + labelWidth + spacing, startY, inputWidth, inputHeight};
     GuiLabel((Rectangle){startX, startY + 9, labelWidth, inputHeight}, label1Text);
-    if (GuiTextBox((Rectangle){startX + labelWidth + spacing, startY, inputWidth, inputHeight},
-                   destinationAccountInput_, sizeof(destinationAccountInput_), destinationAccountEditMode_)) {
+    if (GuiTextBox(destinationBounds, destinationAccountInput_, sizeof(destinationAccountInput_), destinationAccountEditMode_)) {
         destinationAccountEditMode_ = !destinationAccountEditMode_;
     }
+    Rectangle listBounds = suggestionBounds(destinationBounds);
+    bool overList = showSuggestions && CheckCollisionPointRec(GetMousePosition(), listBounds);
+    if (overList) GuiLock();
 
     startY += inputHeight + spacing;
     GuiLabel((Rectangle){startX, startY + 9, labelWidth, inputHeight}, label2Text);
@@ -723,20 +820,25 @@ void UIManager::drawTransferView() {
 
      if (GuiButton((Rectangle){buttonStartX, buttonY, buttonWidth, buttonHeight}, "Confirm Transfer")) {
         try {
-            transactionAmount_ = std::stof(amountInput_);
-            if (transactionAmount_ <= 0) throw std::invalid_argument("Amount must be positive");
+            std::optional<Money> parsedAmount = Money::parse(amountInput_);
+            if (!parsedAmount) throw std::invalid_argument("Amount must be a decimal number");
+            transactionAmount_ = *parsedAmount;
+            if (!transactionAmount_.isPositive()) throw std::invalid_argument("Amount must be positive");
             std::string destAccId = destinationAccountInput_;
             std::string note = noteInput_;
+            std::optional<AccountId> parsedDestId = AccountId::parse(destAccId);
             if (destAccId.empty()) {
                  showMessage("Input Error", "Destination account ID cannot be empty.", ScreenState::TRANSFER_VIEW);
+            } else if (!parsedDestId) {
+                 showMessage("Input Error", "Destination account ID must look like 62XX-YYYY-ZZZZ-AAAA.", ScreenState::TRANSFER_VIEW);
             } else {
-                auto result = bank_.performTransfer(currentAccountId_, destAccId, transactionAmount_, note);
+                auto result = bank_.performTransfer(currentAccountId_, *parsedDestId, transactionAmount_, note);
                 if (result) {
                     std::stringstream successMsg;
                     successMsg << "Transfer successful!\n";
                      Account* updatedAccount = bank_.findAccount(currentAccountId_);
                      if(updatedAccount) {
-                        successMsg << "Your new balance: $" << std::fixed << std::setprecision(2) << updatedAccount->getBalance() << "\n";
+                        successMsg << "Your new balance: $" << updatedAccount->getBalance() << "\n";
                      } else {
                          successMsg << "(Could not fetch new balance)\n";
                      }
@@ -760,165 +862,181 @@ void UIManager::drawTransferView() {
     if (GuiButton((Rectangle){buttonStartX + buttonWidth + buttonSpacing, buttonY, returnButtonWidth, buttonHeight}, "Return to Account")) {
         changeState(returnStateBtn);
     }
+    if (overList) GuiUnlock();
+
+    if (currentState_ != ScreenState::TRANSFER_VIEW) return;
+    if (showSuggestions) {
+        int picked = drawSuggestions(listBounds);
+        if (picked >= 0) {
+            suggestions_[picked].accountId.format(destinationAccountInput_);
+            destinationAccountInput_[AccountId::kTextLength] = '\0';
+            destinationAccountEditMode_ = false;
+        }
+    }
+    refreshSuggestions(destinationAccountInput_, true);
 }
 
 //the whole status of the APP and showing the history
+// A virtualized table: only the visible rows are read and drawn, in the order kept by
+// accountTable_, and the summary comes from the live totals the Bank maintains, read
+// without blocking operations. A frame costs the same for any number of accounts.
 void UIManager::drawViewAllAccounts() {
+    accountTable_.refresh();
+
     Font currentFont = GuiGetFont();
     int baseFontSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
     float textSpacing = 1.0f;
-    DrawTextEx(currentFont, "All Bank Accounts", {(float)screenWidth_/2 - MeasureTextEx(currentFont, "All Bank Accounts", (float)baseFontSize + 8, textSpacing).x/2, 60}, (float)baseFontSize + 8, textSpacing, DARKGRAY);
-
-    const auto& allAccountsMap = bank_.getAllAccounts();
-    std::vector<const Account*> savingsAccounts;
-    std::vector<const Account*> checkingAccounts;
-    double totalBalance = 0.0;
-
-    for (const auto& pair : allAccountsMap) {
-        if (!pair.second) continue;
-        if (pair.second->getType() == AccountType::SAVINGS) {
-            savingsAccounts.push_back(pair.second.get());
-        } else {
-            checkingAccounts.push_back(pair.second.get());
+    DrawTextEx(currentFont, "All Bank Accounts", {(float)screenWidth_/2 - MeasureTextEx(currentFont, "All Bank Accounts", (float)baseFontSize + 8, textSpacing).x/2, 40}, (float)baseFontSize + 8, textSpacing, DARKGRAY);
+
+    // Summary
+    char text[128];
+    char amount[Money::kMaxTextLength + 1];
+    float col1X = 40;
+    float summaryY = 90;
+    Money savingsTotal = bank_.getLiveTotalBalance(AccountType::SAVINGS);
+    Money checkingTotal = bank_.getLiveTotalBalance(AccountType::CHECKING);
+    amount[savingsTotal.format(amount)] = '\0';
+    std::snprintf(text, sizeof(text), "Savings: %zu accounts, $%s", bank_.getAccountCount(AccountType::SAVINGS), amount);
+    DrawTextEx(currentFont, text, {col1X, summaryY}, (float)baseFontSize, textSpacing, BLUE);
+    amount[checkingTotal.format(amount)] = '\0';
+    std::snprintf(text, sizeof(text), "Checking: %zu accounts, $%s", bank_.getAccountCount(AccountType::CHECKING), amount);
+    DrawTextEx(currentFont, text, {col1X + 440, summaryY}, (float)baseFontSize, textSpacing, DARKPURPLE);
+    amount[(savingsTotal + checkingTotal).format(amount)] = '\0';
+    std::snprintf(text, sizeof(text), "Total Balance: $%s", amount);
+    DrawTextEx(currentFont, text, {col1X + 880, summaryY}, (float)baseFontSize, textSpacing, DARKBLUE);
+
+    // Column headers; the sortable ones toggle the order when clicked.
+    float headerY = 130;
+    float headerHeight = 32;
+    float colIdX = col1X + 90;
+    float colTypeX = col1X + 380;
+    float colOwnerX = col1X + 520;
+    float colBalanceX = col1X + 950;
+    auto sortHeader = [&](float x, float width, const char* label, AccountSortKey key) {
+        bool active = accountTable_.getSortKey() == key;
+        std::snprintf(text, sizeof(text), "%s%s", label, !active ? "" : (accountTable_.isDescending() ? " (desc)" : " (asc)"));
+        if (GuiButton((Rectangle){x - 10, headerY, width, headerHeight}, text)) {
+            accountTable_.setSortOrder(key, active && !accountTable_.isDescending());
+            listViewScrollIndex_ = 0;
         }
-        totalBalance += pair.second->getBalance();
-    }
-
-    float startY = 120;
-    float col1X = 80;
-    float col2X = 550;
-    float col3X = 900;
-    float lineHeight = (float)baseFontSize + 8;
-    float sectionSpacing = 40;
+    };
+    DrawTextEx(currentFont, "#", {col1X + 10, headerY + 6}, (float)baseFontSize, textSpacing, DARKGRAY);
+    sortHeader(colIdX, 270, "Account ID", AccountSortKey::ID);
+    DrawTextEx(currentFont, "Type", {colTypeX, headerY + 6}, (float)baseFontSize, textSpacing, DARKGRAY);
+    sortHeader(colOwnerX, 410, "Owner", AccountSortKey::OWNER);
+    sortHeader(colBalanceX, 330, "Balance", AccountSortKey::BALANCE);
+
+    Rectangle viewRec = { col1X, headerY + headerHeight + 8, (float)screenWidth_ - 2 * col1X, (float)screenHeight_ - headerY - headerHeight - 120 };
+    int itemHeight = baseFontSize + 8;
+    int visibleItems = (int)viewRec.height / itemHeight;
+    int totalItems = (int)accountTable_.getRowCount();
     float listFontSize = (float)baseFontSize;
 
-    DrawTextEx(currentFont, "SAVINGS ACCOUNTS:", {col1X, startY}, (float)baseFontSize + 4, textSpacing, BLUE);
-    startY += lineHeight * 1.5;
-    if (savingsAccounts.empty()) {
-        DrawTextEx(currentFont, "  (None)", {col1X, startY}, (float)baseFontSize, textSpacing, GRAY);
-        startY += lineHeight;
-    } else {
-        for (size_t i = 0; i < savingsAccounts.size(); ++i) {
-            const Account* acc = savingsAccounts[i];
-            if (!acc) continue;
-            std::string idStr = std::to_string(i + 1) + ". ID: " + acc->getAccountId();
-            std::string ownerStr = "Owner: " + acc->getOwnerName();
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(2) << acc->getBalance();
-            std::string balanceStr = "Balance: $" + ss.str();
-
-            DrawTextEx(currentFont, idStr.c_str(), {col1X, startY}, listFontSize, textSpacing, BLACK);
-            DrawTextEx(currentFont, ownerStr.c_str(), {col2X, startY}, listFontSize, textSpacing, BLACK);
-            DrawTextEx(currentFont, balanceStr.c_str(), {col3X, startY}, listFontSize, textSpacing, DARKGREEN);
-            startY += lineHeight;
-        }
-    }
-
-    startY += sectionSpacing;
-    DrawTextEx(currentFont, "CHECKING ACCOUNTS:", {col1X, startY}, (float)baseFontSize + 4, textSpacing, DARKPURPLE);
-    startY += lineHeight * 1.5;
-     if (checkingAccounts.empty()) {
-        DrawTextEx(currentFont, "  (None)", {col1X, startY}, (float)baseFontSize, textSpacing, GRAY);
-        startY += lineHeight;
-    } else {
-        for (size_t i = 0; i < checkingAccounts.size(); ++i) {
-            const Account* acc = checkingAccounts[i];
-             if (!acc) continue;
-            std::string idStr = std::to_string(i + 1) + ". ID: " + acc->getAccountId();
-            std::string ownerStr = "Owner: " + acc->getOwnerName();
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(2) << acc->getBalance();
-            std::string balanceStr = "Balance: $" + ss.str();
-
-            DrawTextEx(currentFont, idStr.c_str(), {col1X, startY}, listFontSize, textSpacing, BLACK);
-            DrawTextEx(currentFont, ownerStr.c_str(), {col2X, startY}, listFontSize, textSpacing, BLACK);
-            DrawTextEx(currentFont, balanceStr.c_str(), {col3X, startY}, listFontSize, textSpacing, DARKGREEN);
-            startY += lineHeight;
+    DrawRectangleLinesEx(viewRec, 1, LIGHTGRAY);
+    if (totalItems > 0) {
+        BeginScissorMode((int)viewRec.x, (int)viewRec.y, (int)viewRec.width, (int)viewRec.height);
+        int lastItem = std::min(totalItems, listViewScrollIndex_ + visibleItems);
+        for (int i = listViewScrollIndex_; i < lastItem; ++i) {
+            const Account& acc = accountTable_.getAccount(i);
+            float itemPosY = viewRec.y + (i - listViewScrollIndex_) * itemHeight + 4;
+            bool savings = acc.getType() == AccountType::SAVINGS;
+
+            std::snprintf(text, sizeof(text), "%d", i + 1);
+            DrawTextEx(currentFont, text, {col1X + 10, itemPosY}, listFontSize, textSpacing, GRAY);
+            acc.getAccountId().format(text);
+            text[AccountId::kTextLength] = '\0';
+            DrawTextEx(currentFont, text, {colIdX, itemPosY}, listFontSize, textSpacing, BLACK);
+            DrawTextEx(currentFont, savings ? "Savings" : "Checking", {colTypeX, itemPosY}, listFontSize, textSpacing, savings ? BLUE : DARKPURPLE);
+            DrawTextEx(currentFont, acc.getOwnerName().c_str(), {colOwnerX, itemPosY}, listFontSize, textSpacing, BLACK);
+            amount[acc.getBalance().format(amount)] = '\0';
+            std::snprintf(text, sizeof(text), "$%s", amount);
+            DrawTextEx(currentFont, text, {colBalanceX, itemPosY}, listFontSize, textSpacing, DARKGREEN);
         }
+        EndScissorMode();
+    } else if (!accountTable_.isLoading()) {
+        DrawTextEx(currentFont, "(None)", {viewRec.x + 15, viewRec.y + 4}, listFontSize, textSpacing, GRAY);
     }
 
-    startY += sectionSpacing * 1.5;
-    DrawLine(col1X, startY, screenWidth_ - col1X, startY, LIGHTGRAY);
-    startY += 15;
-
-    std::string totalAccountsStr = "Total Accounts: " + std::to_string(allAccountsMap.size());
-    std::string totalCustomersStr = "Total Customers: " + std::to_string(bank_.getAllCustomers().size());
-     std::stringstream ssTotal;
-    ssTotal << std::fixed << std::setprecision(2) << totalBalance;
-    std::string totalBalanceStr = "Total Balance: $" + ssTotal.str();
+    std::snprintf(text, sizeof(text), "Total Accounts: %d%s   Total Customers: %zu", totalItems,
+                  accountTable_.isLoading() ? " (loading...)" : "", bank_.getAllCustomers().size());
+    DrawTextEx(currentFont, text, {viewRec.x, viewRec.y + viewRec.height + 10}, listFontSize, textSpacing, DARKBLUE);
 
-    DrawTextEx(currentFont, totalAccountsStr.c_str(), {col1X, startY}, (float)baseFontSize, textSpacing, DARKBLUE);
-    DrawTextEx(currentFont, totalCustomersStr.c_str(), {col1X, startY + lineHeight}, (float)baseFontSize, textSpacing, DARKBLUE);
-    DrawTextEx(currentFont, totalBalanceStr.c_str(), {col1X, startY + 2 * lineHeight}, (float)baseFontSize, textSpacing, DARKBLUE);
+    // Scrolling: mouse wheel over the table, or the page keys.
+    int maxScroll = std::max(0, totalItems - visibleItems);
+    if (CheckCollisionPointRec(GetMousePosition(), viewRec)) {
+        listViewScrollIndex_ -= (int)GetMouseWheelMove() * 3;
+    }
+    if (IsKeyPressed(KEY_PAGE_DOWN)) listViewScrollIndex_ += visibleItems;
+    if (IsKeyPressed(KEY_PAGE_UP)) listViewScrollIndex_ -= visibleItems;
+    if (IsKeyPressed(KEY_HOME)) listViewScrollIndex_ = 0;
+    if (IsKeyPressed(KEY_END)) listViewScrollIndex_ = maxScroll;
+    listViewScrollIndex_ = std::max(0, std::min(listViewScrollIndex_, maxScroll));
 
-    if (GuiButton((Rectangle){(float)screenWidth_/2 - 80, (float)screenHeight_ - 80, 160, 45}, "Return to Main Menu")) {
+    if (GuiButton((Rectangle){(float)screenWidth_/2 - 80, (float)screenHeight_ - 70, 160, 45}, "Return to Main Menu")) {
         changeState(ScreenState::MAIN_MENU);
     }
 }
 
 //only showing the history of transaction
 void UIManager::drawTransactionHistoryWrapper() {
-    std::string title;
-    std::vector<Transaction> transactions;
     ScreenState returnState = ScreenState::MAIN_MENU;
 
-    if (currentState_ == ScreenState::VIEW_CUSTOMER_TRANSACTIONS && currentCustomer_) {
-        title = "Transaction History for Customer [" + currentCustomerName_ + "]";
-        transactions = bank_.getCustomerTransactionsChronological(currentCustomerName_);
+    if (currentState_ == ScreenState::VIEW_CUSTOMER_TRANSACTIONS && currentCustomer_ && historyView_.isOpen()) {
         returnState = ScreenState::CUSTOMER_VIEW;
-    } else if (currentState_ == ScreenState::VIEW_ACCOUNT_TRANSACTIONS && currentAccount_) {
-        title = "Transaction History for Account [" + currentAccountId_ + "]";
-        transactions = bank_.getAccountTransactionsChronological(currentAccountId_);
+    } else if (currentState_ == ScreenState::VIEW_ACCOUNT_TRANSACTIONS && currentAccount_ && historyView_.isOpen()) {
         returnState = (currentAccount_->getType() == AccountType::SAVINGS) ?
                       ScreenState::ACCOUNT_VIEW_SAVINGS : ScreenState::ACCOUNT_VIEW_CHECKING;
     } else {
          showMessage("Error", "Cannot display transaction history. Invalid state.", ScreenState::MAIN_MENU);
          return;
     }
-    drawTransactionHistory(title, transactions, returnState);
+    drawTransactionHistory(returnState);
 }
 
 //design of transaction history option
-void UIManager::drawTransactionHistory(const std::string& title, const std::vector<Transaction>& transactions, ScreenState returnState) {
+// Only the rows inside the list are formatted and drawn, and refresh() loads a bounded
+// number of new records, so a frame costs the same for any length of history.
+void UIManager::drawTransactionHistory(ScreenState returnState) {
+    historyView_.refresh();
+
     Font currentFont = GuiGetFont();
     int baseFontSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
     float textSpacing = 1.0f;
-    DrawTextEx(currentFont, title.c_str(), {(float)screenWidth_/2 - MeasureTextEx(currentFont, title.c_str(), (float)baseFontSize + 6, textSpacing).x/2, 60}, (float)baseFontSize + 6, textSpacing, DARKGRAY);
+    const char* title = historyTitle_.c_str();
+    DrawTextEx(currentFont, title, {(float)screenWidth_/2 - MeasureTextEx(currentFont, title, (float)baseFontSize + 6, textSpacing).x/2, 60}, (float)baseFontSize + 6, textSpacing, DARKGRAY);
 
     Rectangle viewRec = { 40, 120, (float)screenWidth_ - 80, (float)screenHeight_ - 220 };
     int itemHeight = baseFontSize + 8;
     int visibleItems = (int)viewRec.height / itemHeight;
-    int totalItems = transactions.size();
+    int totalItems = (int)historyView_.getRowCount();
     float listFontSize = (float)baseFontSize;
 
-    std::vector<std::string> transactionStrings;
-    transactionStrings.reserve(transactions.size());
-    for (const auto& tx : transactions) {
-        transactionStrings.push_back(tx.toString());
-    }
-
     DrawRectangleLinesEx(viewRec, 1, LIGHTGRAY);
 
     if (totalItems > 0) {
         BeginScissorMode((int)viewRec.x, (int)viewRec.y, (int)viewRec.width, (int)viewRec.height);
-        for (int i = 0; i < totalItems; ++i) {
-            if ((i >= listViewScrollIndex_) && (i < listViewScrollIndex_ + visibleItems)) {
-                float itemPosY = viewRec.y + (i - listViewScrollIndex_) * itemHeight;
-                Color textColor = BLACK;
-                if (transactions[i].getType() == TransactionType::DEPOSIT || transactions[i].getType() == TransactionType::TRANSFER_IN) {
-                    textColor = DARKGREEN;
-                } else if (transactions[i].getType() == TransactionType::WITHDRAWAL || transactions[i].getType() == TransactionType::TRANSFER_OUT) {
-                    textColor = MAROON;
-                }
-                 int maxChars = (int)(viewRec.width / (listFontSize * 0.5f));
-                 DrawTextEx(currentFont, TextSubtext(transactionStrings[i].c_str(), 0, maxChars), {(float)viewRec.x + 15, itemPosY + 4}, listFontSize, textSpacing, textColor);
+        int lastItem = std::min(totalItems, listViewScrollIndex_ + visibleItems);
+        int maxChars = (int)(viewRec.width / (listFontSize * 0.5f));
+        for (int i = listViewScrollIndex_; i < lastItem; ++i) {
+            float itemPosY = viewRec.y + (i - listViewScrollIndex_) * itemHeight;
+            TransactionType type = historyView_.getRecord(i).getType();
+            Color textColor = BLACK;
+            if (type == TransactionType::DEPOSIT || type == TransactionType::TRANSFER_IN ||
+                type == TransactionType::INTEREST) {
+                textColor = DARKGREEN;
+            } else if (type == TransactionType::WITHDRAWAL || type == TransactionType::TRANSFER_OUT) {
+                textColor = MAROON;
             }
+            DrawTextEx(currentFont, TextSubtext(historyView_.getRowText(i).c_str(), 0, maxChars), {(float)viewRec.x + 15, itemPosY + 4}, listFontSize, textSpacing, textColor);
         }
         EndScissorMode();
-    } else {
+    } else if (!historyView_.isLoading()) {
         DrawTextEx(currentFont, "No transaction records found.", {(float)(viewRec.x + viewRec.width / 2 - MeasureTextEx(currentFont, "No transaction records found.", (float)baseFontSize, textSpacing).x/2), (float)(viewRec.y + viewRec.height / 2 - 8)}, (float)baseFontSize, textSpacing, GRAY);
     }
 
+    char countText[48];
+    std::snprintf(countText, sizeof(countText), "%d records%s", totalItems, historyView_.isLoading() ? " (loading...)" : "");
+    DrawTextEx(currentFont, countText, {viewRec.x, viewRec.y + viewRec.height + 10}, listFontSize, textSpacing, GRAY);
 
     float mouseWheelMove = GetMouseWheelMove();
     if (CheckCollisionPointRec(GetMousePosition(), viewRec)) {
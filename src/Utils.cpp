@@ -25,5 +25,110 @@ std::string getCurrentDateString() {
     return ss.str();
 }
 
+namespace {
+
+std::tm toLocalTime(std::chrono::system_clock::time_point time) {
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    std::tm local_tm = {};
+    #ifdef _WIN32
+        localtime_s(&local_tm, &seconds);
+    #else
+        localtime_r(&seconds, &local_tm);
+    #endif
+    return local_tm;
+}
+
+// Local midnight of the day in local_tm, plus days. mktime normalizes an out-of-range
+// day of the month and resolves daylight saving time (tm_isdst = -1).
+std::chrono::system_clock::time_point localMidnight(std::tm local_tm, int days) {
+    local_tm.tm_mday += days;
+    local_tm.tm_hour = 0;
+    local_tm.tm_min = 0;
+    local_tm.tm_sec = 0;
+    local_tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&local_tm));
+}
+
+} // namespace
+
+std::chrono::system_clock::time_point localDayStart(std::chrono::system_clock::time_point time) {
+    return localMidnight(toLocalTime(time), 0);
+}
+
+std::chrono::system_clock::time_point nextLocalDayStart(std::chrono::system_clock::time_point time) {
+    return localMidnight(toLocalTime(time), 1);
+}
+
+std::optional<std::chrono::system_clock::time_point> parseLocalDate(std::string_view text) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return std::nullopt;
+    int fields[3] = {};
+    const std::size_t starts[3] = {0, 5, 8};
+    const std::size_t lengths[3] = {4, 2, 2};
+    for (int f = 0; f < 3; ++f) {
+        for (std::size_t i = starts[f]; i < starts[f] + lengths[f]; ++i) {
+            if (text[i] < '0' || text[i] > '9') return std::nullopt;
+            fields[f] = fields[f] * 10 + (text[i] - '0');
+        }
+    }
+    if (fields[1] < 1 || fields[1] > 12 || fields[2] < 1 || fields[2] > 31) return std::nullopt;
+    std::tm local_tm = {};
+    local_tm.tm_year = fields[0] - 1900;
+    local_tm.tm_mon = fields[1] - 1;
+    local_tm.tm_mday = fields[2];
+    const auto dayStart = localMidnight(local_tm, 0);
+    // Reject dates mktime had to roll over, such as 2024-02-30.
+    const std::tm check = toLocalTime(dayStart);
+    if (check.tm_mday != fields[2] || check.tm_mon != fields[1] - 1) return std::nullopt;
+    return dayStart;
+}
+
+namespace {
+
+// Slicing-by-8 lookup tables: table[k][b] is the CRC of byte b followed by k zero bytes,
+// which lets the main loop fold eight input bytes per iteration.
+struct Crc32Tables {
+    std::uint32_t table[8][256];
+    Crc32Tables() {
+        for (std::uint32_t b = 0; b < 256; ++b) {
+            std::uint32_t crc = b;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+            }
+            table[0][b] = crc;
+        }
+        for (std::uint32_t b = 0; b < 256; ++b) {
+            for (int k = 1; k < 8; ++k) {
+                table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+            }
+        }
+    }
+};
+
+const Crc32Tables& crc32Tables() {
+    static const Crc32Tables tables;
+    return tables;
+}
+
+} // namespace
+
+// Implementation of crc32
+std::uint32_t crc32(const void* data, std::size_t length, std::uint32_t seed) {
+    const auto& t = crc32Tables().table;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint32_t crc = ~seed;
+    while (length >= 8) {
+        const std::uint32_t lo = crc ^ (static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+                                        (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24));
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+        p += 8;
+        length -= 8;
+    }
+    while (length--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return ~crc;
+}
+
 } // namespace utils
 } // namespace banking_system
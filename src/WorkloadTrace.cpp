@@ -0,0 +1,195 @@
+#include "WorkloadTrace.hh"
+#include "MappedFile.hh"
+#include "Utils.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace banking_system {
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'B', 'T', 'R'};
+// magic + u32 version + u64 customers + i64 deposit + u64 seed + u64 operations + u16 prefix length
+constexpr std::size_t kFixedHeaderSize = 4 + 4 + 8 + 8 + 8 + 8 + 2;
+constexpr std::size_t kOperationCountOffset = 4 + 4 + 8 + 8 + 8;
+constexpr std::size_t kFlushThreshold = 1 << 20;
+
+// --- Encoding helpers ---
+void putU16(std::string& out, std::uint16_t v) {
+    out.push_back(static_cast<char>(v & 0xFF));
+    out.push_back(static_cast<char>(v >> 8));
+}
+
+void putU32(std::string& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void putU64(std::string& out, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+void putVarint(std::string& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+std::uint32_t readU32(const unsigned char* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+std::uint64_t readU64(const unsigned char* p) {
+    return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+// Decodes a varint at p, not reading past end. Returns false if it is truncated or
+// longer than 64 bits.
+bool readVarint(const unsigned char*& p, const unsigned char* end, std::uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        const unsigned char byte = *p++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// --- WorkloadTraceWriter ---
+WorkloadTraceWriter::WorkloadTraceWriter(const std::string& path, const TraceHeader& header) : path_(path) {
+    if (header.namePrefix.size() > 0xFFFF) {
+        throw std::runtime_error("Trace name prefix is too long.");
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        throw std::runtime_error("Cannot create trace file " + path + ".");
+    }
+    buffer_.append(kMagic, sizeof(kMagic));
+    putU32(buffer_, kFormatVersion);
+    putU64(buffer_, header.customerCount);
+    putU64(buffer_, static_cast<std::uint64_t>(header.initialDepositCents));
+    putU64(buffer_, header.seed);
+    putU64(buffer_, 0); // Operation count, written by finish()
+    putU16(buffer_, static_cast<std::uint16_t>(header.namePrefix.size()));
+    buffer_ += header.namePrefix;
+    if (!flushBuffer()) {
+        std::fclose(file_);
+        throw std::runtime_error("Cannot write trace file " + path + ".");
+    }
+}
+
+WorkloadTraceWriter::~WorkloadTraceWriter() {
+    if (file_) std::fclose(file_);
+}
+
+void WorkloadTraceWriter::append(const TraceOperation& operation) {
+    const std::size_t start = buffer_.size();
+    buffer_.push_back(static_cast<char>(operation.type));
+    putVarint(buffer_, operation.offsetNanos - lastOffsetNanos_);
+    putVarint(buffer_, operation.source);
+    if (operation.type == TraceOperationType::TRANSFER) putVarint(buffer_, operation.destination);
+    putVarint(buffer_, static_cast<std::uint64_t>(operation.cents));
+    crc_ = utils::crc32(buffer_.data() + start, buffer_.size() - start, crc_);
+    lastOffsetNanos_ = operation.offsetNanos;
+    ++operationCount_;
+    if (buffer_.size() >= kFlushThreshold) flushBuffer();
+}
+
+bool WorkloadTraceWriter::finish() {
+    if (!file_) return false;
+    putU32(buffer_, crc_);
+    bool ok = flushBuffer();
+
+    std::string count;
+    putU64(count, operationCount_);
+    ok = ok && std::fseek(file_, static_cast<long>(kOperationCountOffset), SEEK_SET) == 0 &&
+         std::fwrite(count.data(), 1, count.size(), file_) == count.size();
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    return ok;
+}
+
+bool WorkloadTraceWriter::flushBuffer() {
+    if (!buffer_.empty() && !failed_) {
+        failed_ = std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size();
+        bytesWritten_ += buffer_.size();
+    }
+    buffer_.clear();
+    return !failed_;
+}
+
+// --- Reading ---
+WorkloadTrace readWorkloadTrace(const std::string& path) {
+    MappedFile file(path);
+    file.prefetch();
+    const unsigned char* p = file.data();
+    const unsigned char* end = p + file.size();
+    auto malformed = [&](const std::string& reason) {
+        return std::runtime_error("Trace " + path + " is invalid: " + reason + ".");
+    };
+
+    if (file.size() < kFixedHeaderSize || std::memcmp(p, kMagic, sizeof(kMagic)) != 0) {
+        throw malformed("missing header");
+    }
+    if (readU32(p + 4) != WorkloadTraceWriter::kFormatVersion) {
+        throw malformed("unsupported version");
+    }
+    WorkloadTrace trace;
+    TraceHeader& header = trace.header;
+    header.customerCount = readU64(p + 8);
+    header.initialDepositCents = static_cast<std::int64_t>(readU64(p + 16));
+    header.seed = readU64(p + 24);
+    header.operationCount = readU64(p + 32);
+    const std::size_t prefixLength = static_cast<std::size_t>(p[40] | (p[41] << 8));
+    p += kFixedHeaderSize;
+    if (static_cast<std::size_t>(end - p) < prefixLength + 4) throw malformed("truncated header");
+    header.namePrefix.assign(reinterpret_cast<const char*>(p), prefixLength);
+    p += prefixLength;
+
+    // Each record takes at least four bytes, which bounds a corrupt count.
+    end -= 4; // Checksum
+    if (header.operationCount > static_cast<std::uint64_t>(end - p) / 4) throw malformed("bad operation count");
+    if (utils::crc32(p, static_cast<std::size_t>(end - p)) != readU32(end)) throw malformed("checksum mismatch");
+
+    trace.operations.resize(static_cast<std::size_t>(header.operationCount));
+    std::uint64_t offsetNanos = 0;
+    for (TraceOperation& operation : trace.operations) {
+        std::uint64_t delta = 0;
+        std::uint64_t source = 0;
+        std::uint64_t destination = 0;
+        std::uint64_t cents = 0;
+        if (p >= end) throw malformed("truncated records");
+        const unsigned char type = *p++;
+        if (type < static_cast<unsigned char>(TraceOperationType::DEPOSIT) ||
+            type > static_cast<unsigned char>(TraceOperationType::TRANSFER)) {
+            throw malformed("unknown operation type");
+        }
+        operation.type = static_cast<TraceOperationType>(type);
+        if (!readVarint(p, end, delta) || !readVarint(p, end, source) ||
+            (operation.type == TraceOperationType::TRANSFER && !readVarint(p, end, destination)) ||
+            !readVarint(p, end, cents)) {
+            throw malformed("truncated records");
+        }
+        if (source >= header.customerCount || destination >= header.customerCount) {
+            throw malformed("customer index out of range");
+        }
+        offsetNanos += delta;
+        operation.offsetNanos = offsetNanos;
+        operation.source = static_cast<std::uint32_t>(source);
+        operation.destination = static_cast<std::uint32_t>(destination);
+        operation.cents = static_cast<std::int64_t>(cents);
+    }
+    if (p != end) throw malformed("trailing bytes");
+    return trace;
+}
+
+std::string traceCustomerName(const TraceHeader& header, std::uint64_t index) {
+    return header.namePrefix + std::to_string(index);
+}
+
+} // namespace banking_system
@@ -1,5 +1,6 @@
 #include <iostream>   
 #include <stdexcept> 
+#include <string>
 
 // Raylib and Raygui includes
 #include "raylib.h"
@@ -8,13 +9,25 @@
 #include "raygui.h"
 #include "Bank.hh"
 #include "UIManager.hh"
+#include "Logger.hh"
 
 int main() {
     try {
+        // Operation messages go to a rotating log file instead of the console.
+        banking_system::Logger::instance().openFile("minibank.log");
+
         // 1. Create the core Bank object. This object will manage all customers, accounts, and transactions.
         banking_system::Bank bank;
 
-
+        // Restore the previous session: map the last snapshot, then replay the journal
+        // records written after it. New changes are journaled from here on.
+        const std::string snapshotPath = "minibank.snapshot";
+        const std::string journalPath = "minibank.journal";
+        if (!bank.recover(snapshotPath, journalPath)) {
+            std::cerr << "Critical Error: Saved data could not be recovered." << std::endl;
+            return 1;
+        }
+        bank.enableJournal(journalPath);
 
         // 2. Create the UI Manager, passing the Bank object to it. The UIManager will handle all GUI rendering and user interactions.
         banking_system::UIManager uiManager(bank);
@@ -22,6 +35,9 @@ int main() {
         // 3. Run the UI main loop. This will initialize the window and start the event processing and drawing loop.
         uiManager.run();
 
+        // 4. Snapshot on exit so the next start maps it instead of replaying the journal.
+        bank.writeSnapshotAsync(snapshotPath).wait();
+
     } catch (const std::exception& e) {
         std::cerr << "Critical Error: " << e.what() << std::endl;
         